@@ -0,0 +1,26 @@
+#include "../../lv_examples.h"
+#if LV_USE_DIGITLABEL && LV_BUILD_EXAMPLES
+
+static void clock_timer_cb(lv_timer_t * timer)
+{
+    static uint32_t sec = 12 * 3600 + 34 * 60 + 56;
+    lv_obj_t * dlabel = timer->user_data;
+
+    sec++;
+    lv_digitlabel_set_text_fmt(dlabel, "%02d:%02d:%02d", (int)(sec / 3600) % 24, (int)(sec / 60) % 60, (int)sec % 60);
+}
+
+/**
+ * A clock which redraws only the changed digits
+ */
+void lv_example_digitlabel_1(void)
+{
+    lv_obj_t * dlabel = lv_digitlabel_create(lv_scr_act());
+    lv_obj_set_style_text_letter_space(dlabel, 3, 0);
+    lv_obj_center(dlabel);
+    lv_digitlabel_set_text(dlabel, "12:34:56");
+
+    lv_timer_create(clock_timer_cb, 1000, dlabel);
+}
+
+#endif
@@ -65,6 +65,8 @@ void lv_example_checkbox_2(void);
 
 void lv_example_colorwheel_1(void);
 
+void lv_example_digitlabel_1(void);
+
 void lv_example_dropdown_1(void);
 void lv_example_dropdown_2(void);
 void lv_example_dropdown_3(void);
@@ -70,6 +70,10 @@
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
 
+/*Serve the `lv_mem_buf_get()` calls of a display refresh from an arena which is reset at the end of the refresh.
+ *The arena grows to the peak usage of the refreshes but not above this size (in bytes). 0: disable*/
+#define LV_MEM_BUF_ARENA_MAX (32U * 1024U)
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
@@ -83,6 +87,10 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
+/*Cost of refreshing one more area compared to drawing a pixel (e.g. walking the widgets and flushing).
+ *Invalid areas are joined if refreshing their bounding box is cheaper than refreshing them one by one.*/
+#define LV_INV_AREA_OVERHEAD 1024       /*[px]*/
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #define LV_TICK_CUSTOM 0
@@ -113,16 +121,20 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching a shadow has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
     #define LV_SHADOW_CACHE_SIZE 0
-
-    /* Set number of maximally cached circle data.
-    * The circumference of 1/4 circle are saved for anti-aliasing
-    * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-    * 0: to disable caching */
-    #define LV_CIRCLE_CACHE_SIZE 4
+    #if LV_SHADOW_CACHE_SIZE
+        /*Memory for the cached shadows in bytes. The least recently used shadows are dropped if a new one doesn't fit.
+         *Allocated with `lv_mem_alloc` in `lv_init()`, `lv_draw_sw_shadow_cache_set_buf()` can replace it*/
+        #define LV_SHADOW_CACHE_MEM_SIZE (4 * LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+    #endif
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Max. number of fully opaque widgets tracked while redrawing an area.
+ *The widgets (or parts of their background) fully covered by them are not drawn at all.
+ *0: to disable occlusion culling*/
+#define LV_REFR_OCCLUDER_MAX 8
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -150,12 +162,12 @@
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
 
-/*Default gradient buffer size.
- *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
- *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
- *If the cache is too small the map will be allocated only while it's required for the drawing.
+/*Default draw cache size in bytes, allocated with `lv_mem_alloc` in `lv_init()`.
+ *The gradient "maps" and the 1/4 circles of the rounded corners (radius * 6 bytes) are saved here
+ *to avoid calculating them again in the next frames. The least recently used ones are dropped if a new one doesn't fit.
+ *If the cache is too small the data will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
-#define LV_GRAD_CACHE_DEF_SIZE 0
+#define LV_DRAW_CACHE_SIZE (2 * 1024)
 
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
@@ -294,6 +306,11 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*Number of resolved style properties to remember per object, part and state.
+ *Saves walking the style list of the object on every style property query.
+ *Each entry costs about 16 bytes of RAM. 0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 0
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -449,6 +466,15 @@
 /*The control character to use for signalling text recoloring.*/
 #define LV_TXT_COLOR_CMD "#"
 
+/*Number of measured texts (size and line breaks) to remember.
+ *Saves the re-layout of labels whose text, font and width haven't changed.
+ *Each entry costs about `LV_TXT_LAYOUT_CACHE_TEXT_MAX + 64` bytes of RAM. 0: to disable caching*/
+#define LV_TXT_LAYOUT_CACHE_SIZE 0
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    /*Longer texts are not cached*/
+    #define LV_TXT_LAYOUT_CACHE_TEXT_MAX 48
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -538,6 +564,8 @@
 
 #define LV_USE_COLORWHEEL 1
 
+#define LV_USE_DIGITLABEL 1
+
 #define LV_USE_IMGBTN     1
 
 #define LV_USE_KEYBOARD   1
@@ -684,6 +712,8 @@
 #if LV_USE_TINY_TTF
     /*Load TTF data from files*/
     #define LV_TINY_TTF_FILE_SUPPORT 0
+    /*Width and height of a glyph atlas page [px]. The cache size of a font is spent on such pages.*/
+    #define LV_TINY_TTF_ATLAS_PAGE_SIZE 64
 #endif
 
 /*Rlottie library*/
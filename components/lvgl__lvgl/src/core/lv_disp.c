@@ -131,6 +131,9 @@ void lv_disp_set_theme(lv_disp_t * disp, lv_theme_t * th)
 
     disp->theme = th;
 
+    /*The gradients and radiuses of the old theme probably won't be drawn again*/
+    lv_draw_cache_flush();
+
     if(disp->screen_cnt == 3 &&
        lv_obj_get_child_cnt(disp->screens[0]) == 0 &&
        lv_obj_get_child_cnt(disp->screens[1]) == 0 &&
@@ -154,6 +154,19 @@ void _lv_event_mark_deleted(lv_obj_t * obj)
     }
 }
 
+bool _lv_obj_has_event_cb(const lv_obj_t * obj, lv_event_code_t code)
+{
+    if(obj->spec_attr == NULL) return false;
+
+    int32_t i;
+    for(i = 0; i < obj->spec_attr->event_dsc_cnt; i++) {
+        lv_event_code_t filter = obj->spec_attr->event_dsc[i].filter & ~LV_EVENT_PREPROCESS;
+        if(obj->spec_attr->event_dsc[i].cb && (filter == LV_EVENT_ALL || filter == code)) return true;
+    }
+
+    return false;
+}
+
 struct _lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb, lv_event_code_t filter,
                                              void * user_data)
 {
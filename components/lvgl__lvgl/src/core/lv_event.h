@@ -222,6 +222,15 @@ uint32_t lv_event_register_id(void);
  */
 void _lv_event_mark_deleted(struct _lv_obj_t * obj);
 
+/**
+ * Tell whether an object has an event handler for an event.
+ * @param obj       pointer to an object
+ * @param code      an event code
+ * @return          true: an event handler is called for `code`, also the ones added with `LV_EVENT_ALL`
+ *                  or `LV_EVENT_PREPROCESS`
+ */
+bool _lv_obj_has_event_cb(const struct _lv_obj_t * obj, lv_event_code_t code);
+
 /**
  * Add an event handler function for an object.
  * Used by the user to react on event which happens with the object.
@@ -457,6 +457,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+    _lv_obj_style_cache_invalidate(obj);
 
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
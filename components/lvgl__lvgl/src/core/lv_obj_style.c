@@ -35,6 +35,18 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+/*A property of a part of an object resolved in a given state, i.e. the result of `get_prop_core`*/
+typedef struct {
+    const lv_obj_t * obj;       /*NULL if the entry is free*/
+    lv_style_value_t value;
+    uint16_t prop;
+    lv_state_t state;
+    uint8_t part;               /*The part shifted down to a byte, i.e. `part >> 16`*/
+    uint8_t res;                /*The `lv_style_res_t` of `get_prop_core`*/
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +57,7 @@ typedef enum {
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -59,6 +72,9 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static style_cache_entry_t style_cache[LV_OBJ_STYLE_CACHE_SIZE];
+#endif
 
 /**********************
  *      MACROS
@@ -152,6 +168,9 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*A shared style has changed so any object might resolve its properties differently*/
+    _lv_obj_style_cache_invalidate(NULL);
+
     if(!style_refr) return;
     lv_disp_t * d = lv_disp_get_next(NULL);
 
@@ -168,6 +187,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The styles of the object have changed even if the refresh is disabled*/
+    _lv_obj_style_cache_invalidate(obj);
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -226,7 +248,7 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
+        found = get_prop_cached(obj, part, prop, &value_act);
         if(found == LV_STYLE_RES_FOUND) break;
         if(!inheritable) break;
 
@@ -341,6 +363,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate(obj);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -377,6 +400,18 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
     lv_anim_start(&a);
 }
 
+void _lv_obj_style_cache_invalidate(const lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_CACHE_SIZE; i++) {
+        if(obj == NULL || style_cache[i].obj == obj) style_cache[i].obj = NULL;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 lv_style_value_t _lv_obj_style_apply_color_filter(const lv_obj_t * obj, uint32_t part, lv_style_value_t v)
 {
     if(obj == NULL) return v;
@@ -665,6 +700,38 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+/**
+ * Same as `get_prop_core` but look up the result in the style cache first.
+ * The entries of an object are invalidated by `_lv_obj_style_cache_invalidate` whenever its styles change.
+ * The state is part of the key so changing the state needs no invalidation.
+ */
+static lv_style_res_t get_prop_cached(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*While getting the values for a transition the transition styles are ignored. Don't mix these results.*/
+    if(obj->skip_trans) return get_prop_core(obj, part, prop, v);
+
+    uint8_t part_id = (uint8_t)(part >> 16);
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 3) * 31 + (uint32_t)prop * 7 + part_id;
+    style_cache_entry_t * e = &style_cache[h % LV_OBJ_STYLE_CACHE_SIZE];
+    if(e->obj == obj && e->prop == prop && e->part == part_id && e->state == obj->state) {
+        *v = e->value;
+        return e->res;
+    }
+
+    lv_style_res_t res = get_prop_core(obj, part, prop, v);
+    e->obj = obj;
+    e->prop = prop;
+    e->part = part_id;
+    e->state = obj->state;
+    e->res = res;
+    if(res == LV_STYLE_RES_FOUND) e->value = *v;
+    return res;
+#else
+    return get_prop_core(obj, part, prop, v);
+#endif
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -745,6 +812,7 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
         }
         tr = tr_prev;
     }
+    if(removed) _lv_obj_style_cache_invalidate(obj);
     return removed;
 }
 
@@ -830,6 +898,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate(tr->obj);
 
 }
 
@@ -860,6 +929,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+                _lv_obj_style_cache_invalidate(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
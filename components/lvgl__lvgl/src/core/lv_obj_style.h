@@ -171,6 +171,12 @@ lv_style_value_t _lv_obj_style_apply_color_filter(const struct _lv_obj_t * obj,
 void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_state_t prev_state,
                                      lv_state_t new_state, const _lv_obj_style_transition_dsc_t * tr);
 
+/**
+ * Used internally to forget the cached style properties of an object. (See `LV_OBJ_STYLE_CACHE_SIZE`)
+ * @param obj   pointer to an object or `NULL` to clear the whole cache
+ */
+void _lv_obj_style_cache_invalidate(const struct _lv_obj_t * obj);
+
 /**
  * Used internally to compare the appearance of an object in 2 states
  * @param obj
@@ -26,6 +26,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_REFR_OCCLUDER_MAX
+    #define OCCLUSION_MAIN_AREA_MAX 8   /*Max. number of parts to draw the not covered areas of a widget*/
+#else
+    #define OCCLUSION_MAIN_AREA_MAX 1
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -48,6 +53,14 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_REFR_OCCLUDER_MAX
+/*A fully opaque widget and the part of it which is on the redrawn area*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;
+} occluder_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -63,6 +76,19 @@ static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
+#if LV_REFR_OCCLUDER_MAX
+    static void occluders_collect_all(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+    static void occluders_collect_from(lv_obj_t * top_obj, const lv_area_t * clip_area);
+    static void occluders_collect_younger(lv_obj_t * obj, const lv_area_t * clip_area);
+    static void occluders_collect(lv_obj_t * obj, const lv_area_t * clip_area);
+    static void occluder_add(lv_obj_t * obj, const lv_area_t * area);
+    static void occluders_remove(lv_obj_t * obj, bool with_children);
+    static bool occluders_hide_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+    static uint32_t occluders_get_main_areas(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, const lv_area_t * area,
+                                             lv_area_t * areas);
+    static bool obj_is_descendant(const lv_obj_t * obj, const lv_obj_t * ancestor);
+#endif
+
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
 #endif
@@ -76,6 +102,16 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
+static lv_refr_inv_stat_t inv_stat;
+
+#if LV_REFR_OCCLUDER_MAX
+    static occluder_t occluders[LV_REFR_OCCLUDER_MAX];   /*Opaque widgets not drawn yet on the current area*/
+    static uint32_t occluder_cnt;
+    static lv_draw_ctx_t * occluder_draw_ctx;           /*The occluders are valid only while drawing with it*/
+    static bool occlusion_en = true;
+    static lv_refr_occlusion_stat_t occlusion_stat;
+#endif
+
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
 #endif
@@ -127,6 +163,41 @@ void lv_refr_now(lv_disp_t * disp)
     }
 }
 
+void lv_refr_set_occlusion_culling(bool en)
+{
+#if LV_REFR_OCCLUDER_MAX
+    occlusion_en = en;
+#else
+    LV_UNUSED(en);
+#endif
+}
+
+void lv_refr_get_occlusion_stat(lv_refr_occlusion_stat_t * stat)
+{
+#if LV_REFR_OCCLUDER_MAX
+    *stat = occlusion_stat;
+#else
+    lv_memset_00(stat, sizeof(lv_refr_occlusion_stat_t));
+#endif
+}
+
+void lv_refr_reset_occlusion_stat(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    lv_memset_00(&occlusion_stat, sizeof(occlusion_stat));
+#endif
+}
+
+void lv_refr_get_inv_stat(lv_refr_inv_stat_t * stat)
+{
+    *stat = inv_stat;
+}
+
+void lv_refr_reset_inv_stat(void)
+{
+    lv_memset_00(&inv_stat, sizeof(inv_stat));
+}
+
 void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
@@ -142,11 +213,23 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
      *With overflow visible drawing should happen to apply the masks which might affect children */
     bool should_draw = com_clip_res || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
     if(should_draw) {
-        draw_ctx->clip_area = &clip_coords_for_obj;
+        /*Don't draw the parts which will be covered by opaque widgets anyway*/
+        lv_area_t clip_coords_for_main[OCCLUSION_MAIN_AREA_MAX];
+        uint32_t main_area_cnt = 1;
+        clip_coords_for_main[0] = clip_coords_for_obj;
+#if LV_REFR_OCCLUDER_MAX
+        if(com_clip_res) main_area_cnt = occluders_get_main_areas(draw_ctx, obj, &clip_coords_for_obj, clip_coords_for_main);
+#endif
+
+        uint32_t i;
+        for(i = 0; i < main_area_cnt; i++) {
+            draw_ctx->clip_area = &clip_coords_for_main[i];
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
+            lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+        }
 
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
-        lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+        draw_ctx->clip_area = &clip_coords_for_obj;
 #if LV_USE_REFR_DEBUG
         lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
         lv_draw_rect_dsc_t draw_dsc;
@@ -231,6 +314,8 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     suc = _lv_area_intersect(&com_area, area_p, &scr_area);
     if(suc == false)  return; /*Out of the screen*/
 
+    inv_stat.inv_cnt++;
+
     /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
     if(disp->driver->full_refresh) {
         disp->inv_areas[0] = scr_area;
@@ -248,14 +333,42 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     }
 
     /*Save the area*/
+    uint16_t save_i;
     if(disp->inv_p < LV_INV_BUF_SIZE) {
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        save_i = disp->inv_p;
+        disp->inv_p++;
     }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+    else {
+        /*If no place for the area join it into the saved area which grows the least*/
+        uint32_t min_grow = UINT32_MAX;
+        lv_area_t joined_area;
+        save_i = 0;
+        for(i = 0; i < disp->inv_p; i++) {
+            _lv_area_join(&joined_area, &com_area, &disp->inv_areas[i]);
+            uint32_t grow = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+            if(grow < min_grow) {
+                min_grow = grow;
+                save_i = i;
+            }
+        }
+        _lv_area_join(&com_area, &com_area, &disp->inv_areas[save_i]);
+        inv_stat.overflow_cnt++;
+    }
+    lv_area_copy(&disp->inv_areas[save_i], &com_area);
+
+    /*Drop the saved areas covered by the new one*/
+    i = 0;
+    while(i < disp->inv_p) {
+        if(i != save_i && _lv_area_is_in(&disp->inv_areas[i], &com_area, 0)) {
+            disp->inv_p--;
+            disp->inv_areas[i] = disp->inv_areas[disp->inv_p];
+            if(save_i == disp->inv_p) save_i = i;
+        }
+        else {
+            i++;
+        }
     }
-    disp->inv_p++;
+
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
@@ -304,6 +417,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+    /*Serve the temporal buffers of this refresh from the arena*/
+    _lv_mem_buf_frame_begin();
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -315,6 +431,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
         LV_LOG_WARN("there is no active screen");
+        _lv_mem_buf_frame_end();
         REFR_TRACE("finished");
         return;
     }
@@ -352,13 +469,10 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         }
     }
 
+    _lv_mem_buf_frame_end();
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
-#if LV_DRAW_COMPLEX
-    _lv_draw_mask_cleanup();
-#endif
-
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
     if(perf_label == NULL) {
@@ -471,39 +585,52 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the invalid areas which are cheaper to refresh together.
+ * Refreshing an area costs its size plus `LV_INV_AREA_OVERHEAD`, so
+ * near areas are joined even if they don't overlap.
+ * Always the pair with the largest saving is joined first.
  */
 static void lv_refr_join_area(void)
 {
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    lv_area_t * areas = disp_refr->inv_areas;
+    uint8_t * joined = disp_refr->inv_area_joined;
+    uint32_t sizes[LV_INV_BUF_SIZE];
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        sizes[i] = lv_area_get_size(&areas[i]);
+    }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+    while(1) {
+        int32_t best_saving = 0;
+        uint32_t best_in = 0;
+        uint32_t best_from = 0;
+        lv_area_t best_area;
+        lv_area_t joined_area;
+        for(i = 0; i < disp_refr->inv_p; i++) {
+            if(joined[i]) continue;
+            for(j = i + 1; j < disp_refr->inv_p; j++) {
+                if(joined[j]) continue;
+
+                _lv_area_join(&joined_area, &areas[i], &areas[j]);
+                int32_t saving = (int32_t)(sizes[i] + sizes[j] + LV_INV_AREA_OVERHEAD) -
+                                 (int32_t)lv_area_get_size(&joined_area);
+                if(saving > best_saving) {
+                    best_saving = saving;
+                    best_in = i;
+                    best_from = j;
+                    best_area = joined_area;
+                }
             }
+        }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+        if(best_saving <= 0) break;
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
-        }
+        /*Mark 'best_from' as joined into 'best_in'*/
+        lv_area_copy(&areas[best_in], &best_area);
+        sizes[best_in] = lv_area_get_size(&best_area);
+        joined[best_from] = 1;
+        inv_stat.join_cnt++;
     }
 }
 
@@ -616,8 +743,10 @@ static void refr_invalid_areas(void)
             refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            inv_stat.area_cnt++;
         }
     }
+    inv_stat.px_cnt += px_num;
 
     disp_refr->rendering_in_progress = false;
 }
@@ -768,6 +897,10 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
         }
     }
 
+#if LV_REFR_OCCLUDER_MAX
+    occluders_collect_all(draw_ctx, top_act_scr, top_prev_scr);
+#endif
+
     if(disp_refr->draw_prev_over_act) {
         if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
         refr_obj_and_children(draw_ctx, top_act_scr);
@@ -793,6 +926,10 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
 
+#if LV_REFR_OCCLUDER_MAX
+    occluder_cnt = 0;
+#endif
+
     draw_buf_flush(disp_refr);
 }
 
@@ -966,6 +1103,13 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
+
+#if LV_REFR_OCCLUDER_MAX
+    /*The widget is drawn now so it can't hide the widgets drawn after it*/
+    occluders_remove(obj, false);
+    if(layer_type == LV_LAYER_TYPE_NONE && occluders_hide_obj(draw_ctx, obj)) return;
+#endif
+
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
     }
@@ -994,6 +1138,12 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
             LV_LOG_WARN("Couldn't create a new layer context");
             return;
         }
+#if LV_REFR_OCCLUDER_MAX
+        /*The layer is blended only later and might be transformed so don't skip anything on it*/
+        uint32_t occluder_cnt_ori = occluder_cnt;
+        occluder_cnt = 0;
+#endif
+
         lv_point_t pivot = {
             .x = lv_obj_get_style_transform_pivot_x(obj, 0),
             .y = lv_obj_get_style_transform_pivot_y(obj, 0)
@@ -1043,9 +1193,291 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         }
 
         lv_draw_layer_destroy(draw_ctx, layer_ctx);
+
+#if LV_REFR_OCCLUDER_MAX
+        occluder_cnt = occluder_cnt_ori;
+#endif
+    }
+}
+
+#if LV_REFR_OCCLUDER_MAX
+/**
+ * Collect the fully opaque widgets of the area being refreshed.
+ * The widgets drawn before them and hidden by them will be skipped.
+ * @param draw_ctx      pointer to the draw context of the area
+ * @param top_act_scr   the first widget to draw on the active screen or NULL
+ * @param top_prev_scr  the first widget to draw on the previous screen or NULL
+ */
+static void occluders_collect_all(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
+    occluder_cnt = 0;
+    occluder_draw_ctx = draw_ctx;
+    if(!occlusion_en) return;
+
+    if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
+    if(top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
+
+    /*Go from the front to the back, i.e. in the reverse order of drawing*/
+    const lv_area_t * clip_area = draw_ctx->clip_area;
+    occluders_collect_from(lv_disp_get_layer_sys(disp_refr), clip_area);
+    occluders_collect_from(lv_disp_get_layer_top(disp_refr), clip_area);
+    if(disp_refr->draw_prev_over_act) {
+        occluders_collect_from(top_prev_scr, clip_area);
+        occluders_collect_from(top_act_scr, clip_area);
+    }
+    else {
+        occluders_collect_from(top_act_scr, clip_area);
+        occluders_collect_from(top_prev_scr, clip_area);
+    }
+}
+
+/**
+ * Collect the occluders from the widgets drawn by `refr_obj_and_children(top_obj)`
+ */
+static void occluders_collect_from(lv_obj_t * top_obj, const lv_area_t * clip_area)
+{
+    if(top_obj == NULL) return;
+
+    occluders_collect_younger(top_obj, clip_area);
+    occluders_collect(top_obj, clip_area);
+}
+
+/**
+ * Collect the occluders from the younger siblings of `obj` and of its parents.
+ * They are drawn after `obj` so they are in front of it.
+ */
+static void occluders_collect_younger(lv_obj_t * obj, const lv_area_t * clip_area)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    if(parent == NULL) return;
+
+    /*The younger siblings of the parent are even more in front*/
+    occluders_collect_younger(parent, clip_area);
+
+    int32_t i;
+    int32_t idx = lv_obj_get_index(obj);
+    for(i = lv_obj_get_child_cnt(parent) - 1; i > idx; i--) {
+        occluders_collect(parent->spec_attr->children[i], clip_area);
     }
 }
 
+/**
+ * Collect the occluders from a widget and its children
+ * @param obj           pointer to a widget
+ * @param clip_area     the area where the widget will be drawn, the same as in `lv_obj_redraw()`
+ */
+static void occluders_collect(lv_obj_t * obj, const lv_area_t * clip_area)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+
+    lv_area_t area;
+    bool on_clip = _lv_area_intersect(&area, clip_area, &obj->coords);
+    bool overflow_visible = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    if(!on_clip && !overflow_visible) return;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = on_clip ? &area : &obj->coords;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+
+    /*The masks of the widget (e.g. clip corner) are applied on the children too*/
+    if(info.res == LV_COVER_RES_MASKED) return;
+
+    /*The children are drawn after the widget so they are in front of it*/
+    const lv_area_t * clip_area_children = overflow_visible ? clip_area : &area;
+    int32_t i;
+    for(i = lv_obj_get_child_cnt(obj) - 1; i >= 0; i--) {
+        occluders_collect(obj->spec_attr->children[i], clip_area_children);
+    }
+
+    if(!on_clip) return;
+    if(lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL) return;
+
+    if(info.res == LV_COVER_RES_COVER) {
+        occluder_add(obj, &area);
+        return;
+    }
+
+    /*A rounded widget still can cover the area between its left and right corners*/
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    if(r <= 0) return;
+
+    lv_coord_t short_side = LV_MIN(lv_obj_get_width(obj), lv_obj_get_height(obj));
+    if(r > short_side / 2) r = short_side / 2;
+
+    lv_area_t inner = obj->coords;
+    inner.x1 += r + 1;
+    inner.x2 -= r + 1;
+    if(!_lv_area_intersect(&inner, &inner, clip_area)) return;
+
+    info.res = LV_COVER_RES_COVER;
+    info.area = &inner;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res == LV_COVER_RES_COVER) occluder_add(obj, &inner);
+}
+
+static void occluder_add(lv_obj_t * obj, const lv_area_t * area)
+{
+    /*Not needed if an other occluder in front of it hides the same area*/
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        if(_lv_area_is_in(area, &occluders[i].area, 0)) return;
+    }
+
+    uint32_t size = lv_area_get_size(area);
+    if(occluder_cnt < LV_REFR_OCCLUDER_MAX) {
+        i = occluder_cnt;
+        occluder_cnt++;
+    }
+    else {
+        /*If there is no more space replace the smallest one if it's smaller than the new*/
+        uint32_t min_i = 0;
+        for(i = 1; i < occluder_cnt; i++) {
+            if(lv_area_get_size(&occluders[i].area) < lv_area_get_size(&occluders[min_i].area)) min_i = i;
+        }
+        if(lv_area_get_size(&occluders[min_i].area) >= size) return;
+        i = min_i;
+    }
+
+    occluders[i].obj = obj;
+    occluders[i].area = *area;
+    occlusion_stat.occluder_cnt++;
+}
+
+/**
+ * Remove the occluder of a widget
+ * @param obj           pointer to a widget
+ * @param with_children true: remove the occluders of the widget's children too
+ */
+static void occluders_remove(lv_obj_t * obj, bool with_children)
+{
+    uint32_t i = 0;
+    while(i < occluder_cnt) {
+        lv_obj_t * o = occluders[i].obj;
+        if(o == obj || (with_children && obj_is_descendant(o, obj))) {
+            occluder_cnt--;
+            occluders[i] = occluders[occluder_cnt];
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+/**
+ * Check if a widget with its children is fully covered by a widget drawn later.
+ * @param draw_ctx      pointer to the current draw context
+ * @param obj           pointer to a widget
+ * @return              true: the widget doesn't need to be drawn
+ */
+static bool occluders_hide_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    if(occluder_cnt == 0 || draw_ctx != occluder_draw_ctx) return false;
+
+    /*With overflow visible the children can be anywhere*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&area, ext_draw_size, ext_draw_size);
+    if(!_lv_area_intersect(&area, &area, draw_ctx->clip_area)) return false;
+
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        if(_lv_area_is_in(&area, &occluders[i].area, 0) && !obj_is_descendant(occluders[i].obj, obj)) {
+            /*The children won't be drawn either so they won't hide anything*/
+            occluders_remove(obj, true);
+            occlusion_stat.skip_obj_cnt++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Get the parts of an area which are not covered by the widgets drawn later.
+ * @param draw_ctx      pointer to the current draw context
+ * @param obj           pointer to a widget whose main part is drawn on `area`
+ * @param area          the area to check
+ * @param areas         store the not covered parts here. Can be `OCCLUSION_MAIN_AREA_MAX` areas.
+ * @return              number of areas. 0: the whole area is covered
+ */
+static uint32_t occluders_get_main_areas(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, const lv_area_t * area,
+                                         lv_area_t * areas)
+{
+    areas[0] = *area;
+    if(occluder_cnt == 0 || draw_ctx != occluder_draw_ctx) return 1;
+
+    /*The clip corner mask added in the main draw is applied on the children too*/
+    if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN)) return 1;
+
+    /*Only the base widgets without own draw handlers are drawn in more parts as
+     *the other draw events might count on being sent only once*/
+    bool can_split = obj->class_p == &lv_obj_class &&
+                     !_lv_obj_has_event_cb(obj, LV_EVENT_DRAW_MAIN_BEGIN) &&
+                     !_lv_obj_has_event_cb(obj, LV_EVENT_DRAW_MAIN) &&
+                     !_lv_obj_has_event_cb(obj, LV_EVENT_DRAW_MAIN_END);
+    bool changed = false;
+    uint32_t cnt = 1;
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        uint32_t j = 0;
+        while(j < cnt) {
+            lv_area_t * a = &areas[j];
+            lv_area_t common;
+            if(!_lv_area_intersect(&common, a, &occluders[i].area)) {
+                j++;
+                continue;
+            }
+
+            /*Cut the area into the not covered strips around the common part*/
+            lv_area_t parts[4];
+            uint32_t part_cnt = 0;
+            if(a->y1 < common.y1) lv_area_set(&parts[part_cnt++], a->x1, a->y1, a->x2, common.y1 - 1);
+            if(a->y2 > common.y2) lv_area_set(&parts[part_cnt++], a->x1, common.y2 + 1, a->x2, a->y2);
+            if(a->x1 < common.x1) lv_area_set(&parts[part_cnt++], a->x1, common.y1, common.x1 - 1, common.y2);
+            if(a->x2 > common.x2) lv_area_set(&parts[part_cnt++], common.x2 + 1, common.y1, a->x2, common.y2);
+
+            if(part_cnt == 0) {
+                cnt--;
+                areas[j] = areas[cnt];
+                changed = true;
+                continue;
+            }
+
+            if(part_cnt == 1 || (can_split && cnt + part_cnt - 1 <= OCCLUSION_MAIN_AREA_MAX)) {
+                uint32_t k;
+                for(k = 1; k < part_cnt; k++) {
+                    areas[cnt] = parts[k];
+                    cnt++;
+                }
+                *a = parts[0];
+                changed = true;
+            }
+            j++;
+        }
+    }
+
+    if(cnt == 0) occlusion_stat.skip_main_cnt++;
+    else if(changed) occlusion_stat.trim_main_cnt++;
+
+    return cnt;
+}
+
+static bool obj_is_descendant(const lv_obj_t * obj, const lv_obj_t * ancestor)
+{
+    obj = lv_obj_get_parent(obj);
+    while(obj) {
+        if(obj == ancestor) return true;
+        obj = lv_obj_get_parent(obj);
+    }
+    return false;
+}
+#endif
+
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
     int32_t max_row = (uint32_t)disp->driver->draw_buf->size / area_w;
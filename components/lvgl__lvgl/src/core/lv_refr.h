@@ -26,6 +26,21 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t occluder_cnt;      /**< Number of fully opaque widgets found which can hide the widgets below them*/
+    uint32_t skip_obj_cnt;      /**< Number of widgets not drawn at all (with their children)*/
+    uint32_t skip_main_cnt;     /**< Number of widgets whose main draw was skipped but their children were drawn*/
+    uint32_t trim_main_cnt;     /**< Number of widgets whose main draw was limited to their not covered part*/
+} lv_refr_occlusion_stat_t;
+
+typedef struct {
+    uint32_t inv_cnt;           /**< Number of areas invalidated*/
+    uint32_t join_cnt;          /**< Number of areas joined into an other before refreshing*/
+    uint32_t overflow_cnt;      /**< Number of areas joined into an other because the invalid area buffer was full*/
+    uint32_t area_cnt;          /**< Number of areas refreshed*/
+    uint32_t px_cnt;            /**< Number of pixels refreshed*/
+} lv_refr_inv_stat_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -98,6 +113,35 @@ void lv_refr_reset_fps_counter(void);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+/**
+ * Enable or disable skipping the widgets hidden by fully opaque widgets above them.
+ * Has effect only if `LV_REFR_OCCLUDER_MAX > 0`. Enabled by default.
+ * @param en    true: enable occlusion culling; false: draw every widget on the redrawn areas
+ */
+void lv_refr_set_occlusion_culling(bool en);
+
+/**
+ * Get the number of skipped draw operations since the last `lv_refr_reset_occlusion_stat()`
+ * @param stat  pointer to a `lv_refr_occlusion_stat_t` to store the result
+ */
+void lv_refr_get_occlusion_stat(lv_refr_occlusion_stat_t * stat);
+
+/**
+ * Reset the occlusion culling statistics
+ */
+void lv_refr_reset_occlusion_stat(void);
+
+/**
+ * Get the statistics of the invalidated and refreshed areas since the last `lv_refr_reset_inv_stat()`
+ * @param stat  pointer to a `lv_refr_inv_stat_t` to store the result
+ */
+void lv_refr_get_inv_stat(lv_refr_inv_stat_t * stat);
+
+/**
+ * Reset the statistics of the invalidated and refreshed areas
+ */
+void lv_refr_reset_inv_stat(void);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -39,7 +39,8 @@
 
 void lv_draw_init(void)
 {
-    /*Nothing to init now*/
+    _lv_draw_cache_init();
+    _lv_draw_sw_init();
 }
 
 void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx)
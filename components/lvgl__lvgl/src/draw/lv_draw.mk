@@ -1,5 +1,6 @@
 CSRCS += lv_draw_arc.c
 CSRCS += lv_draw.c
+CSRCS += lv_draw_cache.c
 CSRCS += lv_draw_img.c
 CSRCS += lv_draw_label.c
 CSRCS += lv_draw_line.c
@@ -0,0 +1,388 @@
+/**
+ * @file lv_draw_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_cache.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_gc.h"
+#include <stdbool.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#undef ALIGN
+#if defined(LV_ARCH_64)
+    #define ALIGN(X)    (((X) + 7) & ~7)
+#else
+    #define ALIGN(X)    (((X) + 3) & ~3)
+#endif
+
+#define ENTRY_HEADER_SIZE   ALIGN(sizeof(lv_draw_cache_entry_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*An entry is one block: header, data and a copy of the key.
+ *The entries are in a list ordered from the most recently used to the least recently used.*/
+typedef struct _lv_draw_cache_entry_t {
+    struct _lv_draw_cache_entry_t * prev;   /*More recently used*/
+    struct _lv_draw_cache_entry_t * next;   /*Less recently used*/
+    uint32_t hash;
+    uint32_t size;                          /*Size of the whole block*/
+    uint32_t data_size;
+    uint16_t key_size;
+    uint16_t ref_cnt;                       /*Number of draw operations using the data now*/
+    lv_draw_cache_type_t type;
+} lv_draw_cache_entry_t;
+
+/*The free blocks of the cache memory in the order of their address*/
+typedef struct _lv_draw_cache_free_t {
+    struct _lv_draw_cache_free_t * next;
+    uint32_t size;
+} lv_draw_cache_free_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t compute_hash(const void * key, uint32_t key_size);
+static void * get_data(lv_draw_cache_entry_t * e);
+static uint8_t * get_key(lv_draw_cache_entry_t * e);
+static void unlink_entry(lv_draw_cache_entry_t * e);
+static void link_entry_head(lv_draw_cache_entry_t * e);
+static void free_entry(lv_draw_cache_entry_t * e);
+static void shrink(uint32_t limit);
+static lv_draw_cache_entry_t * alloc_entry(uint32_t * size);
+static bool is_in_mem(lv_draw_cache_entry_t * e);
+static void * mem_alloc(uint32_t * size);
+static void mem_free(void * p, uint32_t size);
+static void mem_realloc(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t cache_size = LV_DRAW_CACHE_SIZE;
+static uint32_t mem_size;           /*Size of `_lv_draw_cache_mem`*/
+static uint32_t mem_cache_size;     /*`cache_size` when `_lv_draw_cache_mem` was allocated*/
+static uint32_t mem_entry_cnt;      /*Number of entries in `_lv_draw_cache_mem`*/
+static lv_draw_cache_free_t * mem_free_list;
+static uint32_t used_size;
+static uint32_t entry_cnt;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint32_t evict_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_draw_cache_init(void)
+{
+    /*The memory was freed with the heap if LVGL was deinitialized*/
+    LV_GC_ROOT(_lv_draw_cache_head) = NULL;
+    LV_GC_ROOT(_lv_draw_cache_mem) = NULL;
+    mem_entry_cnt = 0;
+    used_size = 0;
+    entry_cnt = 0;
+    mem_realloc();
+}
+
+void lv_draw_cache_set_size(uint32_t max_bytes)
+{
+    cache_size = max_bytes;
+    shrink(cache_size);
+
+    /*The entries being drawn can't be moved, the memory is reallocated when they are released*/
+    if(mem_entry_cnt == 0 && mem_cache_size != cache_size) mem_realloc();
+}
+
+void lv_draw_cache_flush(void)
+{
+    shrink(0);
+}
+
+void lv_draw_cache_flush_type(lv_draw_cache_type_t type)
+{
+    lv_draw_cache_entry_t * e = LV_GC_ROOT(_lv_draw_cache_head);
+    while(e) {
+        lv_draw_cache_entry_t * next = e->next;
+        if(e->type == type && e->ref_cnt == 0) free_entry(e);
+        e = next;
+    }
+}
+
+void lv_draw_cache_monitor(lv_draw_cache_monitor_t * mon_p)
+{
+    mon_p->hit_cnt = hit_cnt;
+    mon_p->miss_cnt = miss_cnt;
+    mon_p->evict_cnt = evict_cnt;
+    mon_p->entry_cnt = entry_cnt;
+    mon_p->used_size = used_size;
+    mon_p->total_size = cache_size;
+}
+
+void lv_draw_cache_reset_stat(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+    evict_cnt = 0;
+}
+
+void * _lv_draw_cache_get(lv_draw_cache_type_t type, const void * key, uint32_t key_size)
+{
+    uint32_t hash = compute_hash(key, key_size);
+    lv_draw_cache_entry_t * e = LV_GC_ROOT(_lv_draw_cache_head);
+    while(e) {
+        if(e->hash == hash && e->type == type && e->key_size == key_size &&
+           memcmp(get_key(e), key, key_size) == 0) {
+            /*Move to the front to keep the list in LRU order*/
+            if(e->prev) {
+                unlink_entry(e);
+                link_entry_head(e);
+            }
+            e->ref_cnt++;
+            hit_cnt++;
+            return get_data(e);
+        }
+        e = e->next;
+    }
+
+    miss_cnt++;
+    return NULL;
+}
+
+void * _lv_draw_cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size)
+{
+    LV_ASSERT(key_size <= UINT16_MAX);
+
+    uint32_t size = ALIGN(ENTRY_HEADER_SIZE + ALIGN(data_size) + key_size);
+
+    /*Make room for the new entry. If it's too large it's dropped when released.*/
+    if(size <= cache_size) shrink(cache_size - size);
+
+    lv_draw_cache_entry_t * e = alloc_entry(&size);
+    if(e == NULL) return NULL;
+
+    e->hash = compute_hash(key, key_size);
+    e->size = size;
+    e->data_size = data_size;
+    e->key_size = key_size;
+    e->ref_cnt = 1;
+    e->type = type;
+    lv_memcpy(get_key(e), key, key_size);
+    link_entry_head(e);
+
+    used_size += size;
+    entry_cnt++;
+
+    return get_data(e);
+}
+
+void _lv_draw_cache_release(void * data)
+{
+    if(data == NULL) return;
+
+    lv_draw_cache_entry_t * e = (lv_draw_cache_entry_t *)((uint8_t *)data - ENTRY_HEADER_SIZE);
+    LV_ASSERT(e->ref_cnt > 0);
+    e->ref_cnt--;
+
+    /*Only the entries in the cache's memory are kept, so the heap usage doesn't depend on what's cached*/
+    if(e->ref_cnt == 0 && !is_in_mem(e)) free_entry(e);
+    else if(used_size > cache_size) shrink(cache_size);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*FNV-1a*/
+static uint32_t compute_hash(const void * key, uint32_t key_size)
+{
+    const uint8_t * k = key;
+    uint32_t h = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < key_size; i++) {
+        h ^= k[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void * get_data(lv_draw_cache_entry_t * e)
+{
+    return (uint8_t *)e + ENTRY_HEADER_SIZE;
+}
+
+static uint8_t * get_key(lv_draw_cache_entry_t * e)
+{
+    return (uint8_t *)e + ENTRY_HEADER_SIZE + ALIGN(e->data_size);
+}
+
+static void unlink_entry(lv_draw_cache_entry_t * e)
+{
+    if(e->prev) e->prev->next = e->next;
+    else LV_GC_ROOT(_lv_draw_cache_head) = e->next;
+
+    if(e->next) e->next->prev = e->prev;
+}
+
+static void link_entry_head(lv_draw_cache_entry_t * e)
+{
+    lv_draw_cache_entry_t * head = LV_GC_ROOT(_lv_draw_cache_head);
+    e->prev = NULL;
+    e->next = head;
+    if(head) head->prev = e;
+    LV_GC_ROOT(_lv_draw_cache_head) = e;
+}
+
+static void free_entry(lv_draw_cache_entry_t * e)
+{
+    unlink_entry(e);
+    used_size -= e->size;
+    entry_cnt--;
+    if(is_in_mem(e)) {
+        mem_free(e, e->size);
+        mem_entry_cnt--;
+        if(mem_entry_cnt == 0 && mem_cache_size != cache_size) mem_realloc();
+    }
+    else {
+        lv_mem_free(e);
+    }
+}
+
+/*Drop the least recently used entries which are not in use until the cache fits into `limit`*/
+static void shrink(uint32_t limit)
+{
+    lv_draw_cache_entry_t * e = LV_GC_ROOT(_lv_draw_cache_head);
+    if(e == NULL || used_size <= limit) return;
+
+    while(e->next) e = e->next;
+    while(e && used_size > limit) {
+        lv_draw_cache_entry_t * prev = e->prev;
+        if(e->ref_cnt == 0) {
+            free_entry(e);
+            evict_cnt++;
+        }
+        e = prev;
+    }
+}
+
+/*Allocate an entry in the cache's memory, dropping the least recently used entries if there is no large enough
+ *free block. Use the heap if the entry can't be placed there.*/
+static lv_draw_cache_entry_t * alloc_entry(uint32_t * size)
+{
+    if(*size <= mem_size) {
+        while(true) {
+            lv_draw_cache_entry_t * e = mem_alloc(size);
+            if(e) {
+                mem_entry_cnt++;
+                return e;
+            }
+
+            lv_draw_cache_entry_t * lru = NULL;
+            for(e = LV_GC_ROOT(_lv_draw_cache_head); e; e = e->next) {
+                if(e->ref_cnt == 0 && is_in_mem(e)) lru = e;
+            }
+            if(lru == NULL) break;
+            free_entry(lru);
+            evict_cnt++;
+        }
+    }
+
+    lv_draw_cache_entry_t * e = lv_mem_alloc(*size);
+    LV_ASSERT_MALLOC(e);
+    return e;
+}
+
+static bool is_in_mem(lv_draw_cache_entry_t * e)
+{
+    uint8_t * mem = LV_GC_ROOT(_lv_draw_cache_mem);
+    return (uint8_t *)e >= mem && (uint8_t *)e < mem + mem_size;
+}
+
+/*First fit. The rest of the free block is split off if it can hold a free block header.*/
+static void * mem_alloc(uint32_t * size)
+{
+    lv_draw_cache_free_t ** prev_next = &mem_free_list;
+    lv_draw_cache_free_t * f;
+    for(f = mem_free_list; f; f = f->next) {
+        if(f->size >= *size) {
+            if(f->size - *size >= ALIGN(sizeof(lv_draw_cache_free_t))) {
+                lv_draw_cache_free_t * rest = (lv_draw_cache_free_t *)((uint8_t *)f + *size);
+                rest->next = f->next;
+                rest->size = f->size - *size;
+                *prev_next = rest;
+            }
+            else {
+                *size = f->size;
+                *prev_next = f->next;
+            }
+            return f;
+        }
+        prev_next = &f->next;
+    }
+    return NULL;
+}
+
+/*Insert the block into the free list and merge it with the neighboring free blocks*/
+static void mem_free(void * p, uint32_t size)
+{
+    lv_draw_cache_free_t * prev = NULL;
+    lv_draw_cache_free_t * next = mem_free_list;
+    while(next && (uint8_t *)next < (uint8_t *)p) {
+        prev = next;
+        next = next->next;
+    }
+
+    lv_draw_cache_free_t * f = p;
+    f->size = size;
+    f->next = next;
+    if(next && (uint8_t *)f + f->size == (uint8_t *)next) {
+        f->size += next->size;
+        f->next = next->next;
+    }
+
+    if(prev && (uint8_t *)prev + prev->size == (uint8_t *)f) {
+        prev->size += f->size;
+        prev->next = f->next;
+    }
+    else if(prev) {
+        prev->next = f;
+    }
+    else {
+        mem_free_list = f;
+    }
+}
+
+/*Allocate the memory of the cache with the current size. It must be empty.*/
+static void mem_realloc(void)
+{
+    lv_mem_free(LV_GC_ROOT(_lv_draw_cache_mem));
+    LV_GC_ROOT(_lv_draw_cache_mem) = NULL;
+    mem_size = 0;
+    mem_cache_size = cache_size;
+    mem_free_list = NULL;
+
+    uint32_t size = cache_size & ~(uint32_t)(ALIGN(1) - 1);
+    if(size < ALIGN(sizeof(lv_draw_cache_free_t))) return;
+
+    uint8_t * mem = lv_mem_alloc(size);
+    LV_ASSERT_MALLOC(mem);
+    if(mem == NULL) return;
+
+    LV_GC_ROOT(_lv_draw_cache_mem) = mem;
+    mem_size = size;
+    mem_free_list = (lv_draw_cache_free_t *)mem;
+    mem_free_list->next = NULL;
+    mem_free_list->size = size;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file lv_draw_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_CACHE_H
+#define LV_DRAW_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Kind of the resources stored in the draw cache.
+ * Entries of different types never match each other even if their keys are the same.
+ */
+enum {
+    LV_DRAW_CACHE_TYPE_GRAD,        /**< Gradient color maps (`lv_grad_t`)*/
+    LV_DRAW_CACHE_TYPE_CIRCLE,      /**< Anti-aliased 1/4 circles of the radius masks*/
+    _LV_DRAW_CACHE_TYPE_NUM
+};
+
+typedef uint8_t lv_draw_cache_type_t;
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of resources found in the cache*/
+    uint32_t miss_cnt;      /**< Number of resources which had to be calculated*/
+    uint32_t evict_cnt;     /**< Number of entries dropped to keep the cache in its size*/
+    uint32_t entry_cnt;     /**< Number of entries in the cache*/
+    uint32_t used_size;     /**< Bytes used by the entries*/
+    uint32_t total_size;    /**< Size limit of the cache in bytes*/
+} lv_draw_cache_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Allocate the memory of the draw cache. Called by `lv_init()`.
+ */
+void _lv_draw_cache_init(void);
+
+/**
+ * Set the size of the draw cache. Its memory is allocated once with this size and
+ * the least recently used entries are dropped if a new one doesn't fit into it.
+ * Resources which don't fit are allocated from the heap while they are being drawn.
+ * @param max_bytes     the new size in bytes. 0: don't keep the resources after drawing
+ */
+void lv_draw_cache_set_size(uint32_t max_bytes);
+
+/**
+ * Drop all the cached resources which are not being drawn.
+ * Useful e.g. after changing the theme when most of the old gradients and radiuses won't be used again.
+ */
+void lv_draw_cache_flush(void);
+
+/**
+ * Drop the cached resources of a type which are not being drawn.
+ * @param type          a `LV_DRAW_CACHE_TYPE_...` value
+ */
+void lv_draw_cache_flush_type(lv_draw_cache_type_t type);
+
+/**
+ * Get statistics about the draw cache.
+ * @param mon_p         pointer to a `lv_draw_cache_monitor_t` to store the result
+ */
+void lv_draw_cache_monitor(lv_draw_cache_monitor_t * mon_p);
+
+/**
+ * Reset the hit, miss and evict counters of the draw cache.
+ */
+void lv_draw_cache_reset_stat(void);
+
+/**
+ * Find a resource in the cache and mark it as used.
+ * @param type          a `LV_DRAW_CACHE_TYPE_...` value
+ * @param key           pointer to the key which describes the resource. The whole key is compared.
+ * @param key_size      size of the key in bytes
+ * @return              pointer to the resource's data or `NULL` if not cached.
+ *                      Should be released with `_lv_draw_cache_release()`
+ */
+void * _lv_draw_cache_get(lv_draw_cache_type_t type, const void * key, uint32_t key_size);
+
+/**
+ * Allocate a new resource in the cache and mark it as used. The caller needs to fill its data.
+ * @param type          a `LV_DRAW_CACHE_TYPE_...` value
+ * @param key           pointer to the key which describes the resource
+ * @param key_size      size of the key in bytes
+ * @param data_size     size of the resource's data in bytes
+ * @return              pointer to `data_size` bytes or `NULL` if the allocation failed.
+ *                      Should be released with `_lv_draw_cache_release()`
+ */
+void * _lv_draw_cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size);
+
+/**
+ * Mark a resource as not used anymore. It stays in the cache if it fits into the size limit.
+ * @param data          pointer returned by `_lv_draw_cache_get()` or `_lv_draw_cache_add()`
+ */
+void _lv_draw_cache_release(void * data);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_CACHE_H*/
@@ -35,6 +35,10 @@ typedef uint8_t cmd_state_t;
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout, uint32_t line_id,
+                             const char * txt, uint32_t line_start, lv_coord_t max_w);
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout, uint32_t line_id,
+                                 const char * txt, uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -151,13 +155,21 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    /*Use the cached line breaks if the text is laid out from its first line*/
+    const lv_txt_layout_t * layout = NULL;
+    uint32_t line_id = 0;
+    if(last_line_start < 0) {
+        layout = _lv_txt_get_layout(txt, font, dsc->letter_space, dsc->line_space, w, dsc->flag);
+    }
+
+    uint32_t line_end = get_line_end(dsc, layout, line_id, txt, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(dsc, layout, line_id, txt, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +184,14 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, layout, line_id, txt, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(dsc, layout, line_id, txt, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +346,20 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_id++;
+        line_end = get_line_end(dsc, layout, line_id, txt, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, layout, line_id, txt, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, layout, line_id, txt, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -371,6 +382,47 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get where a line of the text ends
+ * @param dsc pointer to draw descriptor
+ * @param layout the cached layout of the text or NULL to find the line break now
+ * @param line_id index of the line
+ * @param txt `\0` terminated text
+ * @param line_start byte index of the line's first char
+ * @param max_w max. width of the lines
+ * @return byte index of the next line's first char
+ */
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout, uint32_t line_id,
+                             const char * txt, uint32_t line_start, lv_coord_t max_w)
+{
+    if(layout) {
+        if(line_id >= layout->line_cnt) return layout->line_start[layout->line_cnt];
+        else return layout->line_start[line_id + 1];
+    }
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, max_w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line of the text
+ * @param dsc pointer to draw descriptor
+ * @param layout the cached layout of the text or NULL to measure the line now
+ * @param line_id index of the line
+ * @param txt `\0` terminated text
+ * @param line_start byte index of the line's first char
+ * @param line_end byte index of the next line's first char
+ * @return width of the line
+ */
+static lv_coord_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_txt_layout_t * layout, uint32_t line_id,
+                                 const char * txt, uint32_t line_start, uint32_t line_end)
+{
+    if(layout) {
+        return line_id < layout->line_cnt ? layout->line_w[line_id] : 0;
+    }
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
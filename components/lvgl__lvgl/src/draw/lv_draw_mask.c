@@ -12,12 +12,11 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "lv_draw_cache.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX   1000
-#define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 
 /**********************
  *      TYPEDEFS
@@ -214,13 +213,8 @@ void lv_draw_mask_free_param(void * p)
     if(pdsc->type == LV_DRAW_MASK_TYPE_RADIUS) {
         lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_mem_free(radius_p->circle->cir_opa);
-                lv_mem_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+            _lv_draw_cache_release(radius_p->circle);
+            radius_p->circle = NULL;
         }
     }
     else if(pdsc->type == LV_DRAW_MASK_TYPE_POLYGON) {
@@ -231,13 +225,7 @@ void lv_draw_mask_free_param(void * p)
 
 void _lv_draw_mask_cleanup(void)
 {
-    uint8_t i;
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).buf) {
-            lv_mem_free(LV_GC_ROOT(_lv_circle_cache[i]).buf);
-        }
-        lv_memset_00(&LV_GC_ROOT(_lv_circle_cache[i]), sizeof(LV_GC_ROOT(_lv_circle_cache[i])));
-    }
+    lv_draw_cache_flush_type(LV_DRAW_CACHE_TYPE_CIRCLE);
 }
 
 /**
@@ -491,40 +479,16 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
         return;
     }
 
-    uint32_t i;
+    /*Try to reuse a circle calculated for an earlier mask*/
+    param->circle = _lv_draw_cache_get(LV_DRAW_CACHE_TYPE_CIRCLE, &radius, sizeof(radius));
+    if(param->circle) return;
 
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
-            LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
-            CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
-            param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
-            return;
-        }
-    }
-
-    /*If not found find a free entry with lowest life*/
-    _lv_draw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).used_cnt == 0) {
-            if(!entry) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
-            else if(LV_GC_ROOT(_lv_circle_cache[i]).life < entry->life) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
-        }
-    }
-
-    if(!entry) {
-        entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
+    /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    uint32_t buf_size = radius * 6 + 6;
+    param->circle = _lv_draw_cache_add(LV_DRAW_CACHE_TYPE_CIRCLE, &radius, sizeof(radius),
+                                       sizeof(_lv_draw_mask_radius_circle_dsc_t) + buf_size);
+    if(param->circle == NULL) return;
+    param->circle->buf = (uint8_t *)param->circle + sizeof(_lv_draw_mask_radius_circle_dsc_t);
 
     circ_calc_aa4(param->circle, radius);
 }
@@ -1364,11 +1328,7 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     if(radius == 0) return;
     c->radius = radius;
 
-    /*Allocate buffers*/
-    if(c->buf) lv_mem_free(c->buf);
-
-    c->buf = lv_mem_alloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
-    LV_ASSERT_MALLOC(c->buf);
+    /*`buf` has `radius * 6 + 6` bytes*/
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
     c->x_start_on_y = (uint16_t *)(c->buf + 4 * radius + 4);
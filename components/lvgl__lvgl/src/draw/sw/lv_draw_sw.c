@@ -37,6 +37,14 @@
  *   GLOBAL FUNCTIONS
  **********************/
 
+void _lv_draw_sw_init(void)
+{
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+    /*Allocate it now so it doesn't show up as a leak on the first shadow drawn*/
+    lv_draw_sw_shadow_cache_set_buf(NULL, LV_SHADOW_CACHE_MEM_SIZE);
+#endif
+}
+
 void lv_draw_sw_init_ctx(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
 {
     LV_UNUSED(drv);
@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_rgb565.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
@@ -43,10 +44,32 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of shadows found in the cache*/
+    uint32_t miss_cnt;      /**< Number of shadows which had to be calculated*/
+    uint32_t entry_cnt;     /**< Number of shadows in the cache*/
+    uint32_t used_size;     /**< Bytes used by the cached shadows*/
+    uint32_t total_size;    /**< Size of the cache memory in bytes*/
+} lv_draw_sw_shadow_cache_monitor_t;
+
+typedef struct {
+    uint32_t generic_cnt;   /**< Rows mapped pixel by pixel by the generic transformation*/
+    uint32_t exact_cnt;     /**< Rows copied from whole source pixels (right angle rotation, integer downscale)*/
+    uint32_t lut_cnt;       /**< Rows sampled with a column look-up table (zoom without rotation and anti-aliasing)*/
+    uint32_t repeat_cnt;    /**< Rows copied from the row above (upscale without rotation and anti-aliasing)*/
+    uint32_t zoom_aa_cnt;   /**< Rows mixed with shared neighbor mixes (upscale with anti-aliasing, without rotation)*/
+} lv_draw_sw_transform_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Initialize the global resources of the software renderer, e.g. allocate the shadow cache.
+ * Called by `lv_init()`.
+ */
+void _lv_draw_sw_init(void);
+
 void lv_draw_sw_init_ctx(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
 void lv_draw_sw_deinit_ctx(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
 
@@ -80,6 +103,25 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
                           lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                           const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
 
+/**
+ * Enable or disable the fast paths of the image transformation. They are enabled by default.
+ * The fast paths render exactly the same as the generic transformation; disabling them is useful to compare the two.
+ * Has effect only if `LV_DRAW_COMPLEX` is enabled.
+ * @param en        true: use the specialized kernels where they apply; false: always use the generic transformation
+ */
+void lv_draw_sw_transform_set_fast_paths(bool en);
+
+/**
+ * Get how many rows were rendered by the generic transformation and the fast paths.
+ * @param stat      pointer to a `lv_draw_sw_transform_stat_t` to store the result
+ */
+void lv_draw_sw_transform_get_stat(lv_draw_sw_transform_stat_t * stat);
+
+/**
+ * Reset the row counters of the image transformation.
+ */
+void lv_draw_sw_transform_reset_stat(void);
+
 struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
                                                       lv_draw_layer_flags_t flags);
 
@@ -91,6 +133,25 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx);
 
+/**
+ * Set the memory where the blurred shadow corners are cached. The cached shadows are dropped.
+ * Has effect only if `LV_SHADOW_CACHE_SIZE > 0`.
+ * @param buf       pointer to a buffer, e.g. in external RAM, or `NULL` to allocate `size` bytes with `lv_mem_alloc`
+ * @param size      size of the buffer in bytes. 0: disable caching
+ */
+void lv_draw_sw_shadow_cache_set_buf(void * buf, uint32_t size);
+
+/**
+ * Get statistics about the shadow cache.
+ * @param mon_p     pointer to a `lv_draw_sw_shadow_cache_monitor_t` to store the result
+ */
+void lv_draw_sw_shadow_cache_monitor(lv_draw_sw_shadow_cache_monitor_t * mon_p);
+
+/**
+ * Reset the hit and miss counters of the shadow cache.
+ */
+void lv_draw_sw_shadow_cache_reset_stat(void);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
@@ -14,15 +14,33 @@
 /*********************
  *      DEFINES
  *********************/
+/*The RGB565 kernels are exact only with the optimized `lv_color_mix`*/
+#define USE_RGB565_KERNELS (LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0)
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*A horizontal stripe of a blend operation*/
+typedef struct {
+    lv_color_t * dest_buf;
+    lv_area_t dest_area;
+    lv_coord_t dest_stride;
+    const lv_color_t * src_buf;
+    lv_coord_t src_stride;
+    const lv_opa_t * mask;
+    lv_coord_t mask_stride;
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+} blend_stripe_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+static void blend_stripes(blend_stripe_t * dsc);
+static void blend_stripe_cb(void * param);
+
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide);
 
@@ -71,6 +89,7 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const lv_draw_sw_blend_workers_t * workers;
 
 /**********************
  *      MACROS
@@ -183,30 +202,98 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
         }
     }
 #endif
-    else if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
+    else {
+        blend_stripe_t stripe;
+        stripe.dest_buf = dest_buf;
+        stripe.dest_area = blend_area;
+        stripe.dest_stride = dest_stride;
+        stripe.src_buf = dsc->src_buf ? src_buf : NULL;
+        stripe.src_stride = src_stride;
+        stripe.mask = mask;
+        stripe.mask_stride = mask_stride;
+        stripe.color = dsc->color;
+        stripe.opa = dsc->opa;
+        stripe.blend_mode = dsc->blend_mode;
+
+        if(workers && workers->worker_cnt && (uint32_t)lv_area_get_size(&blend_area) >= workers->min_px) {
+            blend_stripes(&stripe);
+        }
+        else {
+            blend_stripe_cb(&stripe);
+        }
+    }
+}
+
+void lv_draw_sw_blend_set_workers(const lv_draw_sw_blend_workers_t * new_workers)
+{
+    LV_ASSERT(new_workers == NULL || new_workers->worker_cnt <= LV_DRAW_SW_BLEND_WORKER_MAX);
+    workers = new_workers;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Split a blend operation into horizontal stripes, blend the first one here and the others on the workers.
+ * @param dsc       the whole blend operation
+ */
+static void blend_stripes(blend_stripe_t * dsc)
+{
+    blend_stripe_t stripes[LV_DRAW_SW_BLEND_WORKER_MAX + 1];
+    int32_t h = lv_area_get_height(&dsc->dest_area);
+    int32_t stripe_cnt = LV_MIN((int32_t)workers->worker_cnt + 1, h);
+    int32_t stripe_h = (h + stripe_cnt - 1) / stripe_cnt;
+
+    int32_t i;
+    int32_t y_ofs = 0;
+    for(i = 0; i < stripe_cnt && y_ofs < h; i++) {
+        stripes[i] = *dsc;
+        stripes[i].dest_buf += y_ofs * dsc->dest_stride;
+        if(dsc->src_buf) stripes[i].src_buf += y_ofs * dsc->src_stride;
+        if(dsc->mask) stripes[i].mask += y_ofs * dsc->mask_stride;
+        stripes[i].dest_area.y1 = dsc->dest_area.y1 + y_ofs;
+        stripes[i].dest_area.y2 = LV_MIN(stripes[i].dest_area.y1 + stripe_h - 1, dsc->dest_area.y2);
+        y_ofs += stripe_h;
+    }
+    stripe_cnt = i;
+
+    for(i = 1; i < stripe_cnt; i++) {
+        workers->dispatch_cb(i - 1, blend_stripe_cb, &stripes[i]);
+    }
+
+    blend_stripe_cb(&stripes[0]);
+
+    if(stripe_cnt > 1) workers->join_cb();
+}
+
+static void blend_stripe_cb(void * param)
+{
+    blend_stripe_t * dsc = param;
+
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(dsc->src_buf == NULL) {
-            fill_normal(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
+            fill_normal(dsc->dest_buf, &dsc->dest_area, dsc->dest_stride, dsc->color, dsc->opa, dsc->mask, dsc->mask_stride);
         }
         else {
-            map_normal(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride);
+            map_normal(dsc->dest_buf, &dsc->dest_area, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->opa,
+                       dsc->mask, dsc->mask_stride);
         }
     }
     else {
 #if LV_DRAW_COMPLEX
         if(dsc->src_buf == NULL) {
-            fill_blended(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride, dsc->blend_mode);
+            fill_blended(dsc->dest_buf, &dsc->dest_area, dsc->dest_stride, dsc->color, dsc->opa, dsc->mask, dsc->mask_stride,
+                         dsc->blend_mode);
         }
         else {
-            map_blended(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride, dsc->blend_mode);
+            map_blended(dsc->dest_buf, &dsc->dest_area, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->opa,
+                        dsc->mask, dsc->mask_stride, dsc->blend_mode);
         }
 #endif
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide)
 {
@@ -246,6 +333,14 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
+#if USE_RGB565_KERNELS
+    if(mask || opa < LV_OPA_MAX) {
+        lv_draw_sw_blend_rgb565_get_kernels()->fill((uint16_t *)dest_buf, dest_stride, w, h, color.full, opa,
+                                                    mask, mask_stride);
+        return;
+    }
+#endif
+
     int32_t x;
     int32_t y;
 
@@ -647,6 +742,14 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
+#if USE_RGB565_KERNELS
+    if(mask || opa < LV_OPA_MAX) {
+        lv_draw_sw_blend_rgb565_get_kernels()->map((uint16_t *)dest_buf, dest_stride, (const uint16_t *)src_buf, src_stride,
+                                                   w, h, opa, mask, mask_stride);
+        return;
+    }
+#endif
+
     int32_t x;
     int32_t y;
 
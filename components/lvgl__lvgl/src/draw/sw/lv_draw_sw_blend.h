@@ -21,6 +21,8 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Max. number of workers which can help the rendering thread in blending*/
+#define LV_DRAW_SW_BLEND_WORKER_MAX 7
 
 /**********************
  *      TYPEDEFS
@@ -38,6 +40,22 @@ typedef struct {
     lv_blend_mode_t blend_mode;     /**< E.g. LV_BLEND_MODE_ADDITIVE*/
 } lv_draw_sw_blend_dsc_t;
 
+/**
+ * Workers to blend large areas in parallel, e.g. on the other core of a dual core MCU.
+ * The area is split into horizontal stripes which are blended at the same time by the rendering thread
+ * and the workers. As the stripes don't overlap the result is the same as with a single thread.
+ */
+typedef struct {
+    uint32_t worker_cnt;    /**< Number of workers besides the rendering thread (max. LV_DRAW_SW_BLEND_WORKER_MAX)*/
+    uint32_t min_px;        /**< Don't split areas having less pixels than this*/
+
+    /**Start `job_cb(param)` on the `worker_id`th worker (0 .. worker_cnt - 1) and return immediately*/
+    void (*dispatch_cb)(uint32_t worker_id, void (*job_cb)(void * param), void * param);
+
+    /**Wait until all the dispatched jobs are finished*/
+    void (*join_cb)(void);
+} lv_draw_sw_blend_workers_t;
+
 struct _lv_draw_ctx_t;
 
 /**********************
@@ -59,6 +77,13 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_sw_blend_dsc_t * dsc);
 
+/**
+ * Set the workers to blend large areas in parallel with the rendering thread.
+ * Only the normal and the special blend modes are split, not `set_px_cb` and `screen_transp`.
+ * @param workers       pointer to a static worker descriptor or `NULL` to blend only on the rendering thread
+ */
+void lv_draw_sw_blend_set_workers(const lv_draw_sw_blend_workers_t * workers);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,431 @@
+/**
+ * @file lv_draw_sw_blend_rgb565.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_rgb565.h"
+#include "../../misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The channels of an RGB565 pixel spread to 32 bit (0b00000GGGGGG00000RRRRR000000BBBBB) to have room for a multiplication*/
+#define SPREAD_MASK     0x7E0F81FU
+
+/*Sizes below which building a look up table doesn't pay off*/
+#define FILL_LUT_MIN_PX 64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fill_c(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa,
+                   const lv_opa_t * mask, lv_coord_t mask_stride);
+static void map_c(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                  int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+static void fill_packed(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa,
+                        const lv_opa_t * mask, lv_coord_t mask_stride);
+static void map_packed(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                       int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_draw_sw_blend_rgb565_kernels_t kernels_c = {
+    .fill = fill_c,
+    .map = map_c,
+};
+
+static const lv_draw_sw_blend_rgb565_kernels_t kernels_packed = {
+    .fill = fill_packed,
+    .map = map_packed,
+};
+
+static const lv_draw_sw_blend_rgb565_kernels_t * kernels_act = &kernels_c;
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_COLOR_16_SWAP
+    #define PX_LOAD(px)     ((uint16_t)(((px) << 8) | ((px) >> 8)))
+    #define PX_STORE(px)    ((uint16_t)(((px) << 8) | ((px) >> 8)))
+#else
+    #define PX_LOAD(px)     (px)
+    #define PX_STORE(px)    (px)
+#endif
+
+#if LV_COLOR_16_SWAP
+    #define PAIR_LOAD(w)    ((((w) & 0x00FF00FFU) << 8) | (((w) >> 8) & 0x00FF00FFU))
+    #define PAIR_STORE(w)   ((((w) & 0x00FF00FFU) << 8) | (((w) >> 8) & 0x00FF00FFU))
+#else
+    #define PAIR_LOAD(w)    (w)
+    #define PAIR_STORE(w)   (w)
+#endif
+
+#define SPREAD(px)      ((((uint32_t)(px)) | ((uint32_t)(px) << 16)) & SPREAD_MASK)
+#define UNSPREAD(v)     ((uint16_t)((v) | ((v) >> 16)))
+
+/*Same as `lv_color_mix` with `LV_COLOR_MIX_ROUND_OFS 0` where `mix5 = (mix + 4) >> 3`*/
+#define MIX_SPREAD(fg_spread, bg_spread, mix5) \
+    ((((((fg_spread) - (bg_spread)) * (mix5)) >> 5) + (bg_spread)) & SPREAD_MASK)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blend_rgb565_set_kernels(const lv_draw_sw_blend_rgb565_kernels_t * kernels)
+{
+    kernels_act = kernels ? kernels : &kernels_c;
+}
+
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_kernels(void)
+{
+    return kernels_act;
+}
+
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_c_kernels(void)
+{
+    return &kernels_c;
+}
+
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_packed_kernels(void)
+{
+    return &kernels_packed;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline uint16_t mix_px(uint32_t fg_spread, uint16_t bg, uint32_t mix5)
+{
+    uint32_t bg_spread = SPREAD(PX_LOAD(bg));
+    uint32_t res = MIX_SPREAD(fg_spread, bg_spread, mix5);
+    return PX_STORE(UNSPREAD(res));
+}
+
+/**
+ * Fill with opacity and without mask the way `fill_normal` does it, i.e. with a pre-multiplied color
+ */
+static void fill_opa(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa)
+{
+    /*Introduce the same rounding error on opa as lv_color_mix. (252 + 4) >> 3 << 3 would overflow to 0 so limit it.*/
+    uint32_t opa_q = (((uint32_t)opa + 4) >> 3) << 3;
+    if(opa_q > LV_OPA_COVER) opa_q = LV_OPA_COVER;
+    opa = (lv_opa_t)opa_q;
+    uint32_t opa_inv = 255 - opa;
+
+    uint16_t c = PX_LOAD(color);
+    uint32_t r_premult = (uint32_t)(c >> 11) * opa;
+    uint32_t g_premult = (uint32_t)((c >> 5) & 0x3F) * opa;
+    uint32_t b_premult = (uint32_t)(c & 0x1F) * opa;
+
+    int32_t x;
+    int32_t y;
+
+    /*Too small for a look up table: cache the last result as most of the pixels are usually the same*/
+    if(w * h < FILL_LUT_MIN_PX) {
+        uint16_t last_dest = PX_STORE(0);
+        uint16_t last_res = PX_STORE((uint16_t)((LV_UDIV255(r_premult) << 11) | (LV_UDIV255(g_premult) << 5) |
+                                                LV_UDIV255(b_premult)));
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                if(dest[x] != last_dest) {
+                    last_dest = dest[x];
+                    uint16_t d = PX_LOAD(last_dest);
+                    uint32_t r = LV_UDIV255(r_premult + (uint32_t)(d >> 11) * opa_inv);
+                    uint32_t g = LV_UDIV255(g_premult + (uint32_t)((d >> 5) & 0x3F) * opa_inv);
+                    uint32_t b = LV_UDIV255(b_premult + (uint32_t)(d & 0x1F) * opa_inv);
+                    last_res = PX_STORE((uint16_t)((r << 11) | (g << 5) | b));
+                }
+                dest[x] = last_res;
+            }
+            dest += dest_stride;
+        }
+        return;
+    }
+
+    /*The result of every channel value of the destination*/
+    uint16_t r_lut[32];
+    uint16_t g_lut[64];
+    uint16_t b_lut[32];
+    uint32_t i;
+    for(i = 0; i < 32; i++) {
+        r_lut[i] = (uint16_t)(LV_UDIV255(r_premult + i * opa_inv) << 11);
+        b_lut[i] = (uint16_t)LV_UDIV255(b_premult + i * opa_inv);
+    }
+    for(i = 0; i < 64; i++) {
+        g_lut[i] = (uint16_t)(LV_UDIV255(g_premult + i * opa_inv) << 5);
+    }
+
+    for(y = 0; y < h; y++) {
+        x = 0;
+        for(; x < w - 1; x += 2) {
+            uint16_t d0 = PX_LOAD(dest[x]);
+            uint16_t d1 = PX_LOAD(dest[x + 1]);
+            uint16_t res0 = r_lut[d0 >> 11] | g_lut[(d0 >> 5) & 0x3F] | b_lut[d0 & 0x1F];
+            uint16_t res1 = r_lut[d1 >> 11] | g_lut[(d1 >> 5) & 0x3F] | b_lut[d1 & 0x1F];
+            dest[x] = PX_STORE(res0);
+            dest[x + 1] = PX_STORE(res1);
+        }
+        if(x < w) {
+            uint16_t d = PX_LOAD(dest[x]);
+            dest[x] = PX_STORE((uint16_t)(r_lut[d >> 11] | g_lut[(d >> 5) & 0x3F] | b_lut[d & 0x1F]));
+        }
+        dest += dest_stride;
+    }
+}
+
+static void fill_c(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa,
+                   const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    if(mask == NULL) {
+        fill_opa(dest, dest_stride, w, h, color, opa);
+        return;
+    }
+
+    uint32_t fg_spread = SPREAD(PX_LOAD(color));
+    bool cover = opa >= LV_OPA_MAX;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        /*Skip or fill 4 pixels at once where the mask is fully transparent or covering*/
+        for(; x < w && ((lv_uintptr_t)&mask[x] & 0x3); x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            uint32_t a = cover ? mask[x] : (mask[x] == LV_OPA_COVER ? opa : ((uint32_t)mask[x] * opa) >> 8);
+            dest[x] = mix_px(fg_spread, dest[x], (a + 4) >> 3);
+        }
+        for(; x < w - 3; x += 4) {
+            uint32_t mask32 = *((const uint32_t *)&mask[x]);
+            if(mask32 == 0) continue;
+            if(mask32 == 0xFFFFFFFF && cover) {
+                dest[x] = color;
+                dest[x + 1] = color;
+                dest[x + 2] = color;
+                dest[x + 3] = color;
+                continue;
+            }
+            int32_t i;
+            for(i = x; i < x + 4; i++) {
+                if(mask[i] == LV_OPA_TRANSP) continue;
+                uint32_t a = cover ? mask[i] : (mask[i] == LV_OPA_COVER ? opa : ((uint32_t)mask[i] * opa) >> 8);
+                dest[i] = mix_px(fg_spread, dest[i], (a + 4) >> 3);
+            }
+        }
+        for(; x < w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            uint32_t a = cover ? mask[x] : (mask[x] == LV_OPA_COVER ? opa : ((uint32_t)mask[x] * opa) >> 8);
+            dest[x] = mix_px(fg_spread, dest[x], (a + 4) >> 3);
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+static void map_c(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                  int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t x;
+    int32_t y;
+
+    if(mask == NULL) {
+        uint32_t mix5 = ((uint32_t)opa + 4) >> 3;
+        for(y = 0; y < h; y++) {
+            x = 0;
+            for(; x < w - 1; x += 2) {
+                uint32_t fg0 = SPREAD(PX_LOAD(src[x]));
+                uint32_t fg1 = SPREAD(PX_LOAD(src[x + 1]));
+                uint16_t res0 = mix_px(fg0, dest[x], mix5);
+                uint16_t res1 = mix_px(fg1, dest[x + 1], mix5);
+                dest[x] = res0;
+                dest[x + 1] = res1;
+            }
+            if(x < w) dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], mix5);
+            dest += dest_stride;
+            src += src_stride;
+        }
+        return;
+    }
+
+    bool cover = opa > LV_OPA_MAX;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        for(; x < w && ((lv_uintptr_t)&mask[x] & 0x3); x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            uint32_t a = cover ? mask[x] : (mask[x] >= LV_OPA_MAX ? opa : ((uint32_t)mask[x] * opa) >> 8);
+            dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], (a + 4) >> 3);
+        }
+        for(; x < w - 3; x += 4) {
+            uint32_t mask32 = *((const uint32_t *)&mask[x]);
+            if(mask32 == 0) continue;
+            if(mask32 == 0xFFFFFFFF && cover) {
+                dest[x] = src[x];
+                dest[x + 1] = src[x + 1];
+                dest[x + 2] = src[x + 2];
+                dest[x + 3] = src[x + 3];
+                continue;
+            }
+            int32_t i;
+            for(i = x; i < x + 4; i++) {
+                if(mask[i] == LV_OPA_TRANSP) continue;
+                uint32_t a = cover ? mask[i] : (mask[i] >= LV_OPA_MAX ? opa : ((uint32_t)mask[i] * opa) >> 8);
+                dest[i] = mix_px(SPREAD(PX_LOAD(src[i])), dest[i], (a + 4) >> 3);
+            }
+        }
+        for(; x < w; x++) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            uint32_t a = cover ? mask[x] : (mask[x] >= LV_OPA_MAX ? opa : ((uint32_t)mask[x] * opa) >> 8);
+            dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], (a + 4) >> 3);
+        }
+        dest += dest_stride;
+        src += src_stride;
+        mask += mask_stride;
+    }
+}
+
+/*
+ * Two pixels loaded as one 32 bit word can be blended with two multiplications instead of one per pixel:
+ * `w & SPREAD_MASK` holds B0, R0 and G1, `ROR16(w) & SPREAD_MASK` holds B1, R1 and G0 on the same bits
+ * as a spread pixel. The channels are independent so both halves are mixed like a spread pixel.
+ */
+#define ROR16(w)    (((w) >> 16) | ((w) << 16))
+
+static inline uint32_t mix_pair(uint32_t fg_lo, uint32_t fg_hi, uint32_t bg, uint32_t mix5)
+{
+    bg = PAIR_LOAD(bg);
+    uint32_t res_lo = MIX_SPREAD(fg_lo, bg & SPREAD_MASK, mix5);
+    uint32_t res_hi = MIX_SPREAD(fg_hi, ROR16(bg) & SPREAD_MASK, mix5);
+    return PAIR_STORE(res_lo | ROR16(res_hi));
+}
+
+static inline uint32_t mask_to_mix(lv_opa_t m, lv_opa_t opa, bool cover, lv_opa_t opa_full_th)
+{
+    uint32_t a = cover ? m : (m >= opa_full_th ? opa : ((uint32_t)m * opa) >> 8);
+    return (a + 4) >> 3;
+}
+
+/**
+ * Fill with mask two pixels at once. Without mask the pre-multiplied fill of the C kernels is used
+ * as it rounds differently than `lv_color_mix`.
+ */
+static void fill_packed(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa,
+                        const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    if(mask == NULL) {
+        fill_opa(dest, dest_stride, w, h, color, opa);
+        return;
+    }
+
+    uint32_t fg_spread = SPREAD(PX_LOAD(color));
+    uint32_t color32 = ((uint32_t)color << 16) | color;
+    uint32_t fg_pair = PAIR_LOAD(color32);
+    uint32_t fg_lo = fg_pair & SPREAD_MASK;
+    uint32_t fg_hi = ROR16(fg_pair) & SPREAD_MASK;
+    bool cover = opa >= LV_OPA_MAX;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if((lv_uintptr_t)dest & 0x2) {
+            if(w > 0 && mask[0] != LV_OPA_TRANSP) dest[0] = mix_px(fg_spread, dest[0], mask_to_mix(mask[0], opa, cover,
+                                                                                                      LV_OPA_COVER));
+            x = 1;
+        }
+
+        for(; x < w - 1; x += 2) {
+            lv_opa_t m0 = mask[x];
+            lv_opa_t m1 = mask[x + 1];
+            uint32_t * d32 = (uint32_t *)&dest[x];
+            if(m0 == m1) {
+                if(m0 == LV_OPA_TRANSP) continue;
+                if(m0 == LV_OPA_COVER && cover) *d32 = color32;
+                else *d32 = mix_pair(fg_lo, fg_hi, *d32, mask_to_mix(m0, opa, cover, LV_OPA_COVER));
+            }
+            else {
+                if(m0 != LV_OPA_TRANSP) dest[x] = mix_px(fg_spread, dest[x], mask_to_mix(m0, opa, cover, LV_OPA_COVER));
+                if(m1 != LV_OPA_TRANSP) dest[x + 1] = mix_px(fg_spread, dest[x + 1], mask_to_mix(m1, opa, cover, LV_OPA_COVER));
+            }
+        }
+
+        if(x < w && mask[x] != LV_OPA_TRANSP) dest[x] = mix_px(fg_spread, dest[x], mask_to_mix(mask[x], opa, cover,
+                                                                                                     LV_OPA_COVER));
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+/**
+ * Blend two pixels at once. Rows where the source and destination can't be read as aligned 32 bit words together
+ * are blended by the C kernel.
+ */
+static void map_packed(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                       int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    bool cover = opa > LV_OPA_MAX;
+    uint32_t mix5_opa = ((uint32_t)opa + 4) >> 3;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(((lv_uintptr_t)dest ^ (lv_uintptr_t)src) & 0x2) {
+            map_c(dest, dest_stride, src, src_stride, w, 1, opa, mask, mask_stride);
+        }
+        else if(mask == NULL) {
+            x = 0;
+            if(((lv_uintptr_t)dest & 0x2) && w > 0) {
+                dest[0] = mix_px(SPREAD(PX_LOAD(src[0])), dest[0], mix5_opa);
+                x = 1;
+            }
+            for(; x < w - 1; x += 2) {
+                uint32_t fg = PAIR_LOAD(*(const uint32_t *)&src[x]);
+                uint32_t * d32 = (uint32_t *)&dest[x];
+                *d32 = mix_pair(fg & SPREAD_MASK, ROR16(fg) & SPREAD_MASK, *d32, mix5_opa);
+            }
+            if(x < w) dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], mix5_opa);
+        }
+        else {
+            x = 0;
+            if(((lv_uintptr_t)dest & 0x2) && w > 0) {
+                if(mask[0] != LV_OPA_TRANSP) dest[0] = mix_px(SPREAD(PX_LOAD(src[0])), dest[0], mask_to_mix(mask[0], opa, cover,
+                                                                                                                LV_OPA_MAX));
+                x = 1;
+            }
+            for(; x < w - 1; x += 2) {
+                lv_opa_t m0 = mask[x];
+                lv_opa_t m1 = mask[x + 1];
+                uint32_t * d32 = (uint32_t *)&dest[x];
+                if(m0 == m1) {
+                    if(m0 == LV_OPA_TRANSP) continue;
+                    uint32_t s32 = *(const uint32_t *)&src[x];
+                    if(m0 == LV_OPA_COVER && cover) {
+                        *d32 = s32;
+                    }
+                    else {
+                        uint32_t fg = PAIR_LOAD(s32);
+                        *d32 = mix_pair(fg & SPREAD_MASK, ROR16(fg) & SPREAD_MASK, *d32, mask_to_mix(m0, opa, cover, LV_OPA_MAX));
+                    }
+                }
+                else {
+                    if(m0 != LV_OPA_TRANSP) dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], mask_to_mix(m0, opa, cover,
+                                                                                                                 LV_OPA_MAX));
+                    if(m1 != LV_OPA_TRANSP) dest[x + 1] = mix_px(SPREAD(PX_LOAD(src[x + 1])), dest[x + 1], mask_to_mix(m1, opa, cover,
+                                                                                                                             LV_OPA_MAX));
+                }
+            }
+            if(x < w && mask[x] != LV_OPA_TRANSP) dest[x] = mix_px(SPREAD(PX_LOAD(src[x])), dest[x], mask_to_mix(mask[x], opa,
+                                                                                                                   cover, LV_OPA_MAX));
+        }
+        dest += dest_stride;
+        src += src_stride;
+        if(mask) mask += mask_stride;
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file lv_draw_sw_blend_rgb565.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_H
+#define LV_DRAW_SW_BLEND_RGB565_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Blend kernels working on RGB565 pixels (byte swapped if `LV_COLOR_16_SWAP` is enabled).
+ * They are used by the normal blend mode of `lv_draw_sw_blend_basic` with `LV_COLOR_DEPTH 16`
+ * and `LV_COLOR_MIX_ROUND_OFS 0` for every case except the opaque fill and copy.
+ * A kernel must give exactly the same result as `lv_color_mix`.
+ */
+typedef struct {
+    /**
+     * Fill an area with a color.
+     * Without mask: `dest = lv_color_mix(color, dest, opa)` with `opa < LV_OPA_MAX`
+     * With mask: the mask values are applied as in `lv_draw_sw_blend_basic`
+     */
+    void (*fill)(uint16_t * dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color, lv_opa_t opa,
+                 const lv_opa_t * mask, lv_coord_t mask_stride);
+
+    /**
+     * Blend an image to an area.
+     * Without mask: `dest = lv_color_mix(src, dest, opa)` with `opa < LV_OPA_MAX`
+     * With mask: the mask values are applied as in `lv_draw_sw_blend_basic`
+     */
+    void (*map)(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+} lv_draw_sw_blend_rgb565_kernels_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the kernels to use for RGB565 blending, e.g. a SIMD implementation of the target.
+ * @param kernels   pointer to a static kernel set or `NULL` to use the portable C kernels
+ */
+void lv_draw_sw_blend_rgb565_set_kernels(const lv_draw_sw_blend_rgb565_kernels_t * kernels);
+
+/**
+ * Get the kernels used for RGB565 blending.
+ * @return          pointer to the current kernel set
+ */
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_kernels(void);
+
+/**
+ * Get the portable C kernels. Another kernel set can use them for the cases it doesn't accelerate.
+ * @return          pointer to the portable kernel set
+ */
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_c_kernels(void);
+
+/**
+ * Get the packed kernels. They load and store two pixels as one 32 bit word and mix the channels of both
+ * pixels with two multiplications if the two pixels are blended with the same opacity.
+ * Portable C, the same result as the C kernels with half of the memory accesses.
+ * @return          pointer to the packed kernel set
+ */
+const lv_draw_sw_blend_rgb565_kernels_t * lv_draw_sw_blend_rgb565_get_packed_kernels(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_RGB565_H*/
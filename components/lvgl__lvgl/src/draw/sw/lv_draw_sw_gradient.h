@@ -34,15 +34,10 @@ typedef lv_color_t lv_grad_color_t;
 #endif
 
 /** To avoid recomputing gradient for each draw operation,
- *  it's possible to cache the computation in this structure instance.
+ *  the computation is cached in the draw cache in this structure.
  *  Whenever possible, this structure is reused instead of recomputing the gradient map */
 typedef struct _lv_gradient_cache_t {
-    uint32_t        key;          /**< A discriminating key that's built from the drawing operation.
-                                   * If the key does not match, the cache item is not used */
-    uint32_t        life : 30;    /**< A life counter that's incremented on usage. Higher counter is
-                                   * less likely to be evicted from the cache */
     uint32_t        filled : 1;   /**< Used to skip dithering in it if already done */
-    uint32_t        not_cached: 1; /**< The cache was too small so this item is not managed by the cache*/
     lv_color_t   *  map;          /**< The computed gradient low bitdepth color map, points into the
                                    * cache's buffer, no free needed */
     lv_coord_t      alloc_size;   /**< The map allocated size in colors */
@@ -71,12 +66,13 @@ lv_grad_color_t /* LV_ATTRIBUTE_FAST_MEM */ lv_gradient_calculate(const lv_grad_
                                                                   lv_coord_t frac);
 
 /**
- * Set the gradient cache size
+ * Set the gradient cache size. The gradients share the draw cache with the circles of the radius masks,
+ * so it's the same as `lv_draw_cache_set_size()`.
  * @param max_bytes Max cahce size
  */
 void lv_gradient_set_cache_size(size_t max_bytes);
 
-/** Free the gradient cache */
+/** Drop the cached gradients which are not being drawn */
 void lv_gradient_free_cache(void);
 
 /** Get a gradient cache from the given parameters */
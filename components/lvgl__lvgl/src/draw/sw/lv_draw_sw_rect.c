@@ -11,6 +11,7 @@
 #include "../../misc/lv_txt_ap.h"
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
+#include "../../misc/lv_gc.h"
 #include "lv_draw_sw_dither.h"
 
 /*********************
@@ -20,10 +21,31 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+#undef ALIGN
+#if defined(LV_ARCH_64)
+    #define ALIGN(X)    (((X) + 7) & ~7)
+#else
+    #define ALIGN(X)    (((X) + 3) & ~3)
+#endif
+
+#define SHADOW_CACHE_ON     (LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if SHADOW_CACHE_ON
+/*A blurred shadow corner in the cache. `size * size` opacity values follow it.*/
+typedef struct {
+    uint32_t life;      /*Value of `sh_cache_life` when it was used the last time*/
+    lv_coord_t sw;      /*Shadow width*/
+    lv_coord_t r;       /*Clamped radius*/
+    lv_coord_t w;       /*Width of the blurred area but at most `2 * size` as larger areas have the same corner*/
+    lv_coord_t h;       /*Height of the blurred area with the same limit*/
+    lv_coord_t size;    /*`sw + r`*/
+} sh_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -41,6 +63,11 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t *
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
 #endif
 
+#if SHADOW_CACHE_ON
+static const lv_opa_t * shadow_cache_get(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_add(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h, const lv_opa_t * sh_buf);
+#endif
+
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
                          lv_coord_t rout, lv_coord_t rin, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 
@@ -50,10 +77,13 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+#if SHADOW_CACHE_ON
+    static uint8_t * sh_cache_end;      /*End of the last entry*/
+    static uint32_t sh_cache_size;      /*Size of `_lv_shadow_cache_mem`*/
+    static uint32_t sh_cache_life;      /*Incremented on every use to find the least recently used entry*/
+    static uint32_t sh_cache_hit_cnt;
+    static uint32_t sh_cache_miss_cnt;
+    static bool sh_cache_mem_own;       /*The memory was allocated by `lv_draw_sw_shadow_cache_set_buf`*/
 #endif
 
 /**********************
@@ -80,6 +110,57 @@ void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, c
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_sw_shadow_cache_set_buf(void * buf, uint32_t size)
+{
+#if SHADOW_CACHE_ON
+    if(sh_cache_mem_own) lv_mem_free(LV_GC_ROOT(_lv_shadow_cache_mem));
+
+    sh_cache_mem_own = buf == NULL && size > 0;
+    if(sh_cache_mem_own) {
+        buf = lv_mem_alloc(size);
+        LV_ASSERT_MALLOC(buf);
+        if(buf == NULL) {
+            sh_cache_mem_own = false;
+            size = 0;
+        }
+    }
+
+    LV_GC_ROOT(_lv_shadow_cache_mem) = buf;
+    sh_cache_end = buf;
+    sh_cache_size = buf ? size : 0;
+#else
+    LV_UNUSED(buf);
+    LV_UNUSED(size);
+#endif
+}
+
+void lv_draw_sw_shadow_cache_monitor(lv_draw_sw_shadow_cache_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_draw_sw_shadow_cache_monitor_t));
+#if SHADOW_CACHE_ON
+    mon_p->hit_cnt = sh_cache_hit_cnt;
+    mon_p->miss_cnt = sh_cache_miss_cnt;
+    mon_p->total_size = sh_cache_size;
+    if(sh_cache_size == 0) return;
+
+    uint8_t * p = LV_GC_ROOT(_lv_shadow_cache_mem);
+    while(p < sh_cache_end) {
+        sh_cache_entry_t * e = (sh_cache_entry_t *)p;
+        p += ALIGN(sizeof(sh_cache_entry_t)) + ALIGN(e->size * e->size);
+        mon_p->entry_cnt++;
+    }
+    mon_p->used_size = (uint32_t)(sh_cache_end - LV_GC_ROOT(_lv_shadow_cache_mem));
+#endif
+}
+
+void lv_draw_sw_shadow_cache_reset_stat(void)
+{
+#if SHADOW_CACHE_ON
+    sh_cache_hit_cnt = 0;
+    sh_cache_miss_cnt = 0;
+#endif
+}
+
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
 #if LV_COLOR_SCREEN_TRANSP && LV_COLOR_DEPTH == 32
@@ -478,23 +559,20 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
 
     lv_opa_t * sh_buf;
 
-#if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
+#if SHADOW_CACHE_ON
+    lv_coord_t core_w = lv_area_get_width(&core_area);
+    lv_coord_t core_h = lv_area_get_height(&core_area);
+    const lv_opa_t * sh_cached = shadow_cache_get(dsc->shadow_width, r_sh, core_w, core_h);
+    if(sh_cached) {
+        /*Use a copy as the buffer is mirrored while drawing*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, sh_cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        shadow_cache_add(dsc->shadow_width, r_sh, core_w, core_h, sh_buf);
     }
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1101,6 +1179,88 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(lv_coord_t size, lv_coord_t
 
     lv_mem_buf_release(sh_ups_blur_buf);
 }
+
+#if SHADOW_CACHE_ON
+/**
+ * Find a blurred shadow corner in the cache.
+ * @param sw        shadow width
+ * @param r         clamped radius
+ * @param w         width of the blurred area
+ * @param h         height of the blurred area
+ * @return          pointer to the `(sw + r)^2` opacity values or `NULL` if not cached
+ */
+static const lv_opa_t * shadow_cache_get(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    lv_coord_t size = sw + r;
+    w = LV_MIN(w, 2 * size);
+    h = LV_MIN(h, 2 * size);
+
+    uint8_t * p = LV_GC_ROOT(_lv_shadow_cache_mem);
+    while(p < sh_cache_end) {
+        sh_cache_entry_t * e = (sh_cache_entry_t *)p;
+        if(e->sw == sw && e->r == r && e->w == w && e->h == h) {
+            sh_cache_life++;
+            e->life = sh_cache_life;
+            sh_cache_hit_cnt++;
+            return p + ALIGN(sizeof(sh_cache_entry_t));
+        }
+        p += ALIGN(sizeof(sh_cache_entry_t)) + ALIGN(e->size * e->size);
+    }
+
+    sh_cache_miss_cnt++;
+    return NULL;
+}
+
+/**
+ * Save a blurred shadow corner in the cache.
+ * Drop the least recently used corners until it fits.
+ * @param sw        shadow width
+ * @param r         clamped radius
+ * @param w         width of the blurred area
+ * @param h         height of the blurred area
+ * @param sh_buf    the `(sw + r)^2` opacity values
+ */
+static void shadow_cache_add(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h, const lv_opa_t * sh_buf)
+{
+    lv_coord_t size = sw + r;
+    if(size > LV_SHADOW_CACHE_SIZE) return;
+
+    uint32_t entry_size = ALIGN(sizeof(sh_cache_entry_t)) + ALIGN(size * size);
+    if(entry_size > sh_cache_size) return;
+
+    uint8_t * mem = LV_GC_ROOT(_lv_shadow_cache_mem);
+    while((uint32_t)(sh_cache_end - mem) + entry_size > sh_cache_size) {
+        /*Find the least recently used entry and move the next entries to its place*/
+        uint8_t * oldest = NULL;
+        uint32_t oldest_size = 0;
+        uint8_t * p = mem;
+        while(p < sh_cache_end) {
+            sh_cache_entry_t * e = (sh_cache_entry_t *)p;
+            uint32_t s = ALIGN(sizeof(sh_cache_entry_t)) + ALIGN(e->size * e->size);
+            if(oldest == NULL || sh_cache_life - e->life > sh_cache_life - ((sh_cache_entry_t *)oldest)->life) {
+                oldest = p;
+                oldest_size = s;
+            }
+            p += s;
+        }
+
+        /*The areas overlap so copy from the front*/
+        sh_cache_end -= oldest_size;
+        for(p = oldest; p < sh_cache_end; p++) p[0] = p[oldest_size];
+    }
+
+    sh_cache_entry_t * e = (sh_cache_entry_t *)sh_cache_end;
+    sh_cache_life++;
+    e->life = sh_cache_life;
+    e->sw = sw;
+    e->r = r;
+    e->w = LV_MIN(w, 2 * size);
+    e->h = LV_MIN(h, 2 * size);
+    e->size = size;
+    lv_memcpy(sh_cache_end + ALIGN(sizeof(sh_cache_entry_t)), sh_buf, size * size);
+    sh_cache_end += entry_size;
+}
+#endif
 #endif
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
@@ -1360,8 +1520,10 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
 
     lv_draw_mask_free_param(&mask_rin_param);
     lv_draw_mask_remove_id(mask_rin_id);
-    lv_draw_mask_free_param(&mask_rout_param);
-    lv_draw_mask_remove_id(mask_rout_id);
+    if(mask_rout_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&mask_rout_param);
+        lv_draw_mask_remove_id(mask_rout_id);
+    }
     lv_mem_buf_release(blend_dsc.mask_buf);
 
 #else /*LV_DRAW_COMPLEX*/
@@ -33,6 +33,25 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+/**
+ * A source pixel mixed with its neighbor. Upscaling uses the same pixel and neighbor more times.
+ */
+typedef struct {
+    lv_color_t c;       /**< The neighbor mixed with the pixel*/
+    lv_opa_t a;         /**< Opacity of the neighbor mixed with the opacity of the pixel*/
+    uint8_t same;       /**< 1: the color of the neighbor and the pixel are the same*/
+} aa_mix_t;
+
+/**
+ * A destination column of an anti-aliased upscale
+ */
+typedef struct {
+    int32_t ofs;        /**< Byte offset of the source pixel in the row*/
+    int32_t next_ofs;   /**< Byte offset of the horizontal neighbor from the source pixel*/
+    int32_t col;        /**< Index of the source column in the vertical mixes*/
+    int32_t fract;      /**< Weight of the horizontal neighbor*/
+} aa_col_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -65,13 +84,51 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                             int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
 
+static bool zoom_no_aa(point_transform_dsc_t * t, const lv_area_t * dest_area, const uint8_t * src,
+                       lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                       lv_color_t * cbuf, uint8_t * abuf);
+
+static bool zoom_aa(point_transform_dsc_t * t, const lv_area_t * dest_area, const uint8_t * src,
+                    lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                    lv_color_t * cbuf, uint8_t * abuf);
+
+static void aa_edge_px(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       lv_img_cf_t cf, lv_color_t ck, int32_t xs_int, int32_t ys_int, int32_t x_next, int32_t y_next,
+                       int32_t xs_fract, int32_t ys_fract, lv_color_t * c, lv_opa_t * a);
+
+static bool exact_row(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, bool aa);
+
+static void step_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                    int32_t base, int32_t step, int32_t x_min, int32_t x_max, int32_t x_end,
+                    lv_color_t * cbuf, uint8_t * abuf);
+
+static void gather_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                      int32_t base, const int32_t * idx, int32_t x_min, int32_t x_max, int32_t x_end,
+                      lv_color_t * cbuf, uint8_t * abuf);
+
+static void clip_to_src(int32_t start, int32_t step, lv_coord_t size, int32_t * x_min, int32_t * x_max);
+
+static bool fast_path_cf(lv_img_cf_t cf);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+static bool fast_paths_en = true;
+static lv_draw_sw_transform_stat_t transform_stat;
 
 /**********************
  *      MACROS
  **********************/
+/*Read a color from a byte address as the pixels of ARGB images are not aligned*/
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+    #define READ_COLOR(c, px)   (c).full = (px)[0]
+#elif LV_COLOR_DEPTH == 16
+    #define READ_COLOR(c, px)   (c).full = (px)[0] + ((px)[1] << 8)
+#elif LV_COLOR_DEPTH == 32
+    #define READ_COLOR(c, px)   (c).full = *((uint32_t *)(px))
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -105,8 +162,28 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
     tr_dsc.pivot_x_256 = tr_dsc.pivot.x * 256;
     tr_dsc.pivot_y_256 = tr_dsc.pivot.y * 256;
 
+    /*`32767 >> 5` would shrink the image by 1023/1024 at some right angles, so use the exact values*/
+    if(tr_dsc.angle % 900 == 0) {
+        tr_dsc.sinma = tr_dsc.sinma > 0 ? 1024 : (tr_dsc.sinma < 0 ? -1024 : 0);
+        tr_dsc.cosma = tr_dsc.cosma > 0 ? 1024 : (tr_dsc.cosma < 0 ? -1024 : 0);
+    }
+
     lv_coord_t dest_w = lv_area_get_width(dest_area);
     lv_coord_t dest_h = lv_area_get_height(dest_area);
+
+    /*Without rotation and anti-aliasing every row samples the same columns*/
+    if(fast_paths_en && tr_dsc.angle == 0 && draw_dsc->antialias == 0 &&
+       zoom_no_aa(&tr_dsc, dest_area, src_buf, src_w, src_h, src_stride, cf, cbuf, abuf)) {
+        return;
+    }
+
+    /*Upscale with anti-aliasing: the neighbors are shared by more destination pixels*/
+    if(fast_paths_en && tr_dsc.angle == 0 && draw_dsc->antialias && draw_dsc->zoom > LV_IMG_ZOOM_NONE &&
+       zoom_aa(&tr_dsc, dest_area, src_buf, src_w, src_h, src_stride, cf, cbuf, abuf)) {
+        return;
+    }
+
+    bool exact_en = fast_paths_en && fast_path_cf(cf);
     lv_coord_t y;
     for(y = 0; y < dest_h; y++) {
         int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
@@ -125,7 +202,12 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
         int32_t xs_ups = xs1_ups + 0x80;
         int32_t ys_ups = ys1_ups + 0x80;
 
-        if(draw_dsc->antialias == 0) {
+        if(exact_en && exact_row(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                                 cbuf, abuf, cf, draw_dsc->antialias)) {
+            transform_stat.exact_cnt++;
+        }
+        else if(draw_dsc->antialias == 0) {
+            transform_stat.generic_cnt++;
             switch(cf) {
                 case LV_IMG_CF_TRUE_COLOR_ALPHA:
                     argb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
@@ -145,6 +227,7 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
             }
         }
         else {
+            transform_stat.generic_cnt++;
             argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
         }
 
@@ -153,6 +236,21 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
     }
 }
 
+void lv_draw_sw_transform_set_fast_paths(bool en)
+{
+    fast_paths_en = en;
+}
+
+void lv_draw_sw_transform_get_stat(lv_draw_sw_transform_stat_t * stat)
+{
+    *stat = transform_stat;
+}
+
+void lv_draw_sw_transform_reset_stat(void)
+{
+    lv_memset_00(&transform_stat, sizeof(transform_stat));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -427,41 +525,560 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
         }
         /*Partially out of the image*/
         else {
+            aa_edge_px(src, src_w, src_h, src_stride, cf, ck, xs_int, ys_int, x_next, y_next, xs_fract, ys_fract,
+                       &cbuf[x], &abuf[x]);
+        }
+    }
+}
+
+
+/**
+ * Anti-aliased pixel whose horizontal or vertical neighbor is out of the image: the pixel is faded out.
+ * @param c         store the color here
+ * @param a         store the opacity here
+ */
+static void aa_edge_px(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       lv_img_cf_t cf, lv_color_t ck, int32_t xs_int, int32_t ys_int, int32_t x_next, int32_t y_next,
+                       int32_t xs_fract, int32_t ys_fract, lv_color_t * c, lv_opa_t * a)
+{
+    int32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    const uint8_t * src_tmp = src + (ys_int * src_stride * px_size) + xs_int * px_size;
+
 #if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            cbuf[x].full = src_tmp[0];
+    c->full = src_tmp[0];
 #elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+    c->full = src_tmp[0] + (src_tmp[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
+    c->full = *((uint32_t *)src_tmp);
 #endif
-            lv_opa_t a;
-            switch(cf) {
-                case LV_IMG_CF_TRUE_COLOR_ALPHA:
-                    a = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    break;
-                case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
-                    a = cbuf[x].full == ck.full ? 0x00 : 0xff;
-                    break;
+    lv_opa_t px_a;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            px_a = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            px_a = c->full == ck.full ? 0x00 : 0xff;
+            break;
 #if LV_COLOR_DEPTH == 16
-                case LV_IMG_CF_RGB565A8:
-                    a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
-                    break;
+        case LV_IMG_CF_RGB565A8:
+            px_a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
+            break;
 #endif
-                default:
-                    a = 0xff;
-            }
+        default:
+            px_a = 0xff;
+    }
+
+    if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
+        *a = (px_a * (0xFF - xs_fract)) >> 8;
+    }
+    else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
+        *a = (px_a * (0xFF - ys_fract)) >> 8;
+    }
+    else {
+        *a = 0x00;
+    }
+}
+
+/**
+ * Get the direction and the weight of the neighbor pixel the same way as `argb_and_rgb_aa`
+ * @param ups       upscaled source coordinate of the pixel
+ * @param next      store the direction of the neighbor here (-1 or 1)
+ * @return          weight of the neighbor (0x00..0xFE)
+ */
+static inline int32_t aa_neighbor(int32_t ups, int32_t * next)
+{
+    int32_t fract = ups & 0xFF;
+    if(fract < 0x80) {
+        *next = -1;
+        return (0x7F - fract) * 2;
+    }
+    else {
+        *next = 1;
+        return (fract - 0x80) * 2;
+    }
+}
+
+/**
+ * Mix a pixel with its neighbor the same way as `argb_and_rgb_aa`
+ * @param m         store the result here
+ * @param px_base   the pixel
+ * @param px_next   its horizontal or vertical neighbor
+ * @param fract     weight of the neighbor
+ * @param has_alpha true: ARGB image, false: RGB image
+ */
+static inline void aa_mix(aa_mix_t * m, const uint8_t * px_base, const uint8_t * px_next, int32_t fract,
+                          bool has_alpha)
+{
+    lv_color_t c_base;
+    lv_color_t c_next;
+    READ_COLOR(c_base, px_base);
+    READ_COLOR(c_next, px_next);
+    if(has_alpha) {
+        lv_opa_t a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        lv_opa_t a_next = px_next[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        if(a_next != a_base) a_next = ((a_next * fract) + (a_base * (0x100 - fract))) >> 8;
+        m->a = a_next;
+    }
+    else {
+        m->a = 0xff;
+    }
+    m->same = c_base.full == c_next.full;
+    m->c = m->same ? c_base : lv_color_mix(c_next, c_base, fract);
+}
+
+/**
+ * Upscale with anti-aliasing and without rotation.
+ * Every source pixel is mixed with its vertical neighbor only once in a row
+ * and with its horizontal neighbors only once for all the rows sampling the same source row.
+ * The result is the same as with the generic transformation.
+ * @return          false if `cf` is not supported or there is no memory for the buffers
+ */
+static bool zoom_aa(point_transform_dsc_t * t, const lv_area_t * dest_area, const uint8_t * src,
+                    lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                    lv_color_t * cbuf, uint8_t * abuf)
+{
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA) return false;
+
+    bool has_alpha = cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    int32_t px_size = has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    lv_coord_t dest_w = lv_area_get_width(dest_area);
+    lv_coord_t dest_h = lv_area_get_height(dest_area);
 
-            if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
-                abuf[x] = (a * (0xFF - xs_fract)) >> 8;
+    /*The mapping of the columns is the same in every row without rotation*/
+    int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
+    transform_point_upscaled(t, dest_area->x1, dest_area->y1, &xs1_ups, &ys1_ups);
+    transform_point_upscaled(t, dest_area->x2, dest_area->y1, &xs2_ups, &ys2_ups);
+    int32_t xs_step_256 = 0;
+    if(dest_w > 1) xs_step_256 = (256 * (xs2_ups - xs1_ups)) / (dest_w - 1);
+    int32_t xs_ups_start = xs1_ups + 0x80;
+
+    /*The source columns of the destination pixels whose pixel and horizontal neighbor are in the image.
+     *The zoom is positive so they are contiguous.*/
+    int32_t x_first = dest_w;
+    int32_t x_last = -1;
+    int32_t x;
+    for(x = 0; x < dest_w; x++) {
+        int32_t xs_ups = xs_ups_start + ((xs_step_256 * x) >> 8);
+        int32_t x_next;
+        aa_neighbor(xs_ups, &x_next);
+        int32_t xs_int = xs_ups >> 8;
+        if(xs_int + x_next >= 0 && xs_int + x_next < src_w && xs_int >= 0 && xs_int < src_w) {
+            if(x_first > x) x_first = x;
+            x_last = x;
+        }
+    }
+    if(x_first > x_last) return false;
+
+    int32_t xs_first = (xs_ups_start + ((xs_step_256 * x_first) >> 8)) >> 8;
+    int32_t xs_last = (xs_ups_start + ((xs_step_256 * x_last) >> 8)) >> 8;
+    int32_t col_cnt = xs_last - xs_first + 1;
+    int32_t in_cnt = x_last - x_first + 1;
+
+    /*Source column and horizontal mix per destination column and vertical mix per source column*/
+    aa_col_t * cols = lv_mem_buf_get(in_cnt * (sizeof(aa_col_t) + sizeof(aa_mix_t)) + col_cnt * sizeof(aa_mix_t));
+    if(cols == NULL) return false;
+    aa_mix_t * hor = (aa_mix_t *)(cols + in_cnt);
+    aa_mix_t * ver = hor + in_cnt;
+
+    for(x = x_first; x <= x_last; x++) {
+        int32_t xs_ups = xs_ups_start + ((xs_step_256 * x) >> 8);
+        int32_t x_next;
+        aa_col_t * col = &cols[x - x_first];
+        col->fract = aa_neighbor(xs_ups, &x_next);
+        col->ofs = (xs_ups >> 8) * px_size;
+        col->next_ofs = x_next * px_size;
+        col->col = (xs_ups >> 8) - xs_first;
+    }
+
+    lv_color_t ck = _LV_COLOR_ZERO_INITIALIZER;
+    int32_t hor_ys_int = -1;
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        transform_point_upscaled(t, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
+        int32_t ys_ups = ys1_ups + 0x80;
+        int32_t ys_int = ys_ups >> 8;
+        int32_t y_next;
+        int32_t ys_fract = aa_neighbor(ys_ups, &y_next);
+
+        if(ys_int < 0 || ys_int >= src_h) {
+            lv_memset_00(abuf, dest_w);
+            cbuf += dest_w;
+            abuf += dest_w;
+            continue;
+        }
+
+        /*The first and last rows are faded out*/
+        if(ys_int + y_next < 0 || ys_int + y_next >= src_h) {
+            argb_and_rgb_aa(src, src_w, src_h, src_stride, xs_ups_start, ys_ups, xs_step_256, 0, dest_w, cbuf, abuf, cf);
+            transform_stat.generic_cnt++;
+            cbuf += dest_w;
+            abuf += dest_w;
+            continue;
+        }
+
+        const uint8_t * row = src + ys_int * src_stride * px_size;
+        const uint8_t * row_next = row + y_next * src_stride * px_size;
+        const uint8_t * px = row + xs_first * px_size;
+        int32_t i;
+        for(i = 0; i < col_cnt; i++) {
+            aa_mix(&ver[i], px, px + (row_next - row), ys_fract, has_alpha);
+            px += px_size;
+        }
+
+        if(hor_ys_int != ys_int) {
+            for(i = 0; i < in_cnt; i++) {
+                px = row + cols[i].ofs;
+                aa_mix(&hor[i], px, px + cols[i].next_ofs, cols[i].fract, has_alpha);
             }
-            else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
-                abuf[x] = (a * (0xFF - ys_fract)) >> 8;
+            hor_ys_int = ys_int;
+        }
+        transform_stat.zoom_aa_cnt++;
+
+        /*Fully or partially out of the image on the left and right*/
+        for(x = 0; x < dest_w; x++) {
+            if(x == x_first) {
+                x = x_last;
+                continue;
             }
-            else {
+            int32_t xs_ups = xs_ups_start + ((xs_step_256 * x) >> 8);
+            int32_t xs_int = xs_ups >> 8;
+            if(xs_int < 0 || xs_int >= src_w) {
                 abuf[x] = 0x00;
+                continue;
+            }
+            int32_t x_next;
+            int32_t xs_fract = aa_neighbor(xs_ups, &x_next);
+            aa_edge_px(src, src_w, src_h, src_stride, cf, ck, xs_int, ys_int, x_next, y_next, xs_fract, ys_fract,
+                       &cbuf[x], &abuf[x]);
+        }
+
+        lv_color_t * c_act = cbuf + x_first;
+        lv_opa_t * a_act = abuf + x_first;
+        for(i = 0; i < in_cnt; i++) {
+            const aa_mix_t * h = &hor[i];
+            const aa_mix_t * v = &ver[cols[i].col];
+            lv_opa_t a = (v->a + h->a) >> 1;
+            a_act[i] = a;
+            if(a == 0x00) continue;
+
+            if(v->same && h->same) READ_COLOR(c_act[i], row + cols[i].ofs);
+            else c_act[i] = lv_color_mix(h->c, v->c, LV_OPA_50);
+        }
+
+        cbuf += dest_w;
+        abuf += dest_w;
+    }
+
+    lv_mem_buf_release(cols);
+    return true;
+}
+
+/**
+ * Zoom without rotation and anti-aliasing (nearest neighbor).
+ * The source column of every destination column is mapped only once and
+ * the rows sampling the same source row as the row above are copied.
+ * The result is the same as with the generic transformation.
+ * @return          false if `cf` is not supported or there is no memory for the look-up table
+ */
+static bool zoom_no_aa(point_transform_dsc_t * t, const lv_area_t * dest_area, const uint8_t * src,
+                       lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                       lv_color_t * cbuf, uint8_t * abuf)
+{
+    if(!fast_path_cf(cf)) return false;
+
+    lv_coord_t dest_w = lv_area_get_width(dest_area);
+    lv_coord_t dest_h = lv_area_get_height(dest_area);
+    int32_t * col_lut = lv_mem_buf_get(dest_w * sizeof(int32_t));
+    if(col_lut == NULL) return false;
+
+    /*Map the columns the same way as the generic transformation does in every row*/
+    int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
+    transform_point_upscaled(t, dest_area->x1, dest_area->y1, &xs1_ups, &ys1_ups);
+    transform_point_upscaled(t, dest_area->x2, dest_area->y1, &xs2_ups, &ys2_ups);
+    int32_t xs_step_256 = 0;
+    if(dest_w > 1) xs_step_256 = (256 * (xs2_ups - xs1_ups)) / (dest_w - 1);
+    int32_t xs_ups = xs1_ups + 0x80;
+
+    /*The zoom is positive so the columns in the image are contiguous*/
+    int32_t x_min = dest_w;
+    int32_t x_max = -1;
+    int32_t x;
+    for(x = 0; x < dest_w; x++) {
+        col_lut[x] = (xs_ups + ((xs_step_256 * x) >> 8)) >> 8;
+        if(col_lut[x] >= 0 && col_lut[x] < src_w) {
+            if(x_min > x) x_min = x;
+            x_max = x;
+        }
+    }
+
+    /*`lv_memcpy` copies the opacity rows byte by byte if they are not aligned the same way
+     *and then sampling the row again is faster*/
+    bool repeat_en = (dest_w & (sizeof(void *) - 1)) == 0;
+    int32_t ys_int_prev = 0;
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        transform_point_upscaled(t, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
+        int32_t ys_int = (ys1_ups + 0x80) >> 8;
+        if(repeat_en && y > 0 && ys_int == ys_int_prev) {
+            lv_memcpy(cbuf, cbuf - dest_w, dest_w * sizeof(lv_color_t));
+            lv_memcpy(abuf, abuf - dest_w, dest_w);
+            transform_stat.repeat_cnt++;
+        }
+        else {
+            if(ys_int < 0 || ys_int >= src_h) lv_memset_00(abuf, dest_w);
+            else gather_px(src, src_h, src_stride, cf, ys_int * src_stride, col_lut, x_min, x_max, dest_w, cbuf, abuf);
+            transform_stat.lut_cnt++;
+        }
+
+        ys_int_prev = ys_int;
+        cbuf += dest_w;
+        abuf += dest_w;
+    }
+
+    lv_mem_buf_release(col_lut);
+    return true;
+}
+
+/**
+ * Copy a row if all of its pixels hit the center of a source pixel and the neighbors are whole source pixels away.
+ * It's the case with rotation by right angles and with integer downscale.
+ * The result is the same as with the generic transformation.
+ * @return          false if the row can't be copied this way
+ */
+static bool exact_row(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf, bool aa)
+{
+    if((xs_ups & 0xFF) != 0x80 || (ys_ups & 0xFF) != 0x80) return false;
+    if((xs_step & 0xFFFF) != 0 || (ys_step & 0xFFFF) != 0) return false;
+
+    /*With anti-aliasing the pixels next to a chroma keyed pixel are transparent too*/
+    if(aa && cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) return false;
+
+    int32_t xs_int = xs_ups >> 8;
+    int32_t ys_int = ys_ups >> 8;
+    int32_t xs_d = xs_step >> 16;
+    int32_t ys_d = ys_step >> 16;
+    int32_t x_min = 0;
+    int32_t x_max = x_end - 1;
+    clip_to_src(xs_int, xs_d, src_w, &x_min, &x_max);
+    clip_to_src(ys_int, ys_d, src_h, &x_min, &x_max);
+
+    int32_t base = (ys_int + ys_d * x_min) * src_stride + xs_int + xs_d * x_min;
+    step_px(src, src_h, src_stride, cf, base, ys_d * src_stride + xs_d, x_min, x_max, x_end, cbuf, abuf);
+
+    /*The anti-aliasing fades the last column and row as their right and bottom neighbors are missing*/
+    if(aa) {
+        int32_t x;
+        for(x = x_min; x <= x_max; x++) {
+            if(xs_int + xs_d * x == src_w - 1 || ys_int + ys_d * x == src_h - 1) {
+                abuf[x] = (abuf[x] * 0xFF) >> 8;
             }
         }
     }
+
+    return true;
+}
+
+/**
+ * Copy source pixels which are the same distance from each other to a row without any mixing
+ * @param base      index of the source pixel (`y * src_stride + x`) of `x_min`
+ * @param step      difference of the source pixel index of the neighbor destination pixels
+ * @param x_min     first destination pixel in the image, the pixels before it are transparent
+ * @param x_max     last destination pixel in the image, the pixels after it are transparent
+ * @param x_end     number of pixels in the row
+ */
+static void step_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                    int32_t base, int32_t step, int32_t x_min, int32_t x_max, int32_t x_end,
+                    lv_color_t * cbuf, uint8_t * abuf)
+{
+    LV_UNUSED(src_h);       /*Used only by RGB565A8*/
+    LV_UNUSED(src_stride);
+
+    if(x_min > x_max) {
+        lv_memset_00(abuf, x_end);
+        return;
+    }
+
+    lv_memset_00(abuf, x_min);
+    lv_memset_00(abuf + x_max + 1, x_end - x_max - 1);
+
+    lv_color_t * cbuf_end = cbuf + x_max + 1;
+    cbuf += x_min;
+    abuf += x_min;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR: {
+                const lv_color_t * src_c = (const lv_color_t *)src + base;
+                lv_memset_ff(abuf, x_max - x_min + 1);
+                while(cbuf < cbuf_end) {
+                    *cbuf = *src_c;
+                    cbuf++;
+                    src_c += step;
+                }
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                lv_disp_t * d = _lv_refr_get_disp_refreshing();
+                lv_color_t ck = d->driver->color_chroma_key;
+                const lv_color_t * src_c = (const lv_color_t *)src + base;
+                while(cbuf < cbuf_end) {
+                    *cbuf = *src_c;
+                    *abuf = src_c->full == ck.full ? 0x00 : 0xff;
+                    cbuf++;
+                    abuf++;
+                    src_c += step;
+                }
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+                const uint8_t * src_tmp = src + base * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                step *= LV_IMG_PX_SIZE_ALPHA_BYTE;
+                while(cbuf < cbuf_end) {
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+                    cbuf->full = src_tmp[0];
+#elif LV_COLOR_DEPTH == 16
+                    cbuf->full = src_tmp[0] + (src_tmp[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+                    cbuf->full = *((uint32_t *)src_tmp);
+#endif
+                    *abuf = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                    cbuf++;
+                    abuf++;
+                    src_tmp += step;
+                }
+                break;
+            }
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8: {
+                const lv_color_t * src_c = (const lv_color_t *)src + base;
+                const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t) + base;
+                while(cbuf < cbuf_end) {
+                    *cbuf = *src_c;
+                    *abuf = *src_a;
+                    cbuf++;
+                    abuf++;
+                    src_c += step;
+                    src_a += step;
+                }
+                break;
+            }
+#endif
+        default:
+            break;
+    }
+}
+
+/**
+ * Copy source pixels to a row without any mixing
+ * @param base      index of the source pixel added to all indices
+ * @param idx       index of the source pixel (`y * src_stride + x`) of the destination pixels
+ * @param x_min     first destination pixel in the image, the pixels before it are transparent
+ * @param x_max     last destination pixel in the image, the pixels after it are transparent
+ * @param x_end     number of pixels in the row
+ */
+static void gather_px(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride, lv_img_cf_t cf,
+                      int32_t base, const int32_t * idx, int32_t x_min, int32_t x_max, int32_t x_end,
+                      lv_color_t * cbuf, uint8_t * abuf)
+{
+    LV_UNUSED(src_h);       /*Used only by RGB565A8*/
+    LV_UNUSED(src_stride);
+
+    if(x_min > x_max) {
+        lv_memset_00(abuf, x_end);
+        return;
+    }
+
+    lv_memset_00(abuf, x_min);
+    lv_memset_00(abuf + x_max + 1, x_end - x_max - 1);
+
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    int32_t x;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            for(x = x_min; x <= x_max; x++) {
+                cbuf[x] = src_c[base + idx[x]];
+            }
+            lv_memset_ff(abuf + x_min, x_max - x_min + 1);
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                lv_disp_t * d = _lv_refr_get_disp_refreshing();
+                lv_color_t ck = d->driver->color_chroma_key;
+                for(x = x_min; x <= x_max; x++) {
+                    cbuf[x] = src_c[base + idx[x]];
+                    abuf[x] = cbuf[x].full == ck.full ? 0x00 : 0xff;
+                }
+                break;
+            }
+        case LV_IMG_CF_TRUE_COLOR_ALPHA: {
+                for(x = x_min; x <= x_max; x++) {
+                    const uint8_t * src_tmp = src + (base + idx[x]) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+                    cbuf[x].full = src_tmp[0];
+#elif LV_COLOR_DEPTH == 16
+                    cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+                    cbuf[x].full = *((uint32_t *)src_tmp);
+#endif
+                    abuf[x] = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                }
+                break;
+            }
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8: {
+                const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t);
+                for(x = x_min; x <= x_max; x++) {
+                    cbuf[x] = src_c[base + idx[x]];
+                    abuf[x] = src_a[base + idx[x]];
+                }
+                break;
+            }
+#endif
+        default:
+            break;
+    }
+}
+
+/**
+ * Limit a range of destination pixels to the ones where `start + step * x` is in the source image.
+ * @param start     source coordinate of the first destination pixel
+ * @param step      change of the source coordinate on the next destination pixel
+ * @param size      size of the source image in this direction
+ * @param x_min     first destination pixel, increased if needed
+ * @param x_max     last destination pixel, decreased if needed. Less than `x_min` if no pixel is in the image.
+ */
+static void clip_to_src(int32_t start, int32_t step, lv_coord_t size, int32_t * x_min, int32_t * x_max)
+{
+    int32_t lo = 0;
+    int32_t hi;
+    if(step == 0) {
+        hi = start >= 0 && start < size ? *x_max : -1;
+    }
+    else if(step > 0) {
+        if(start < 0) lo = (-start + step - 1) / step;
+        hi = start < size ? (size - 1 - start) / step : -1;
+    }
+    else {
+        if(start >= size) lo = (start - size + 1 - step - 1) / -step;
+        hi = start >= 0 ? start / -step : -1;
+    }
+
+    if(*x_min < lo) *x_min = lo;
+    if(*x_max > hi) *x_max = hi;
+}
+
+static bool fast_path_cf(lv_img_cf_t cf)
+{
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+#endif
+            return true;
+        default:
+            return false;
+    }
 }
 
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
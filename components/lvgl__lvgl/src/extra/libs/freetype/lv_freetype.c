@@ -169,6 +169,10 @@ bool lv_ft_font_init(lv_ft_info_t * info)
 
 void lv_ft_font_destroy(lv_font_t * font)
 {
+    lv_txt_layout_cache_invalidate_font(font);
+#if LV_USE_DIGITLABEL
+    lv_digitlabel_invalidate_font(font);
+#endif
 #if LV_FREETYPE_CACHE_SIZE >= 0
     lv_ft_font_destroy_cache(font);
 #else
@@ -2,7 +2,6 @@
 
 #if LV_USE_TINY_TTF
 #include <stdio.h>
-#include "../../../misc/lv_lru.h"
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -63,7 +62,31 @@ static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 #include "stb_rect_pack.h"
 #include "stb_truetype_htcw.h"
 
-typedef struct ttf_font_desc {
+/* a page of the glyph atlas. glyphs are packed with stb_rect_pack and a page is only freed as a whole */
+typedef struct ttf_atlas_page {
+    struct ttf_atlas_page * next;
+    uint32_t life;          /* the value of `ttf_face_t::life` when a glyph of the page was last used */
+    uint32_t size;          /* bytes allocated for the page */
+    int w;
+    int h;
+    stbrp_context packer;
+    stbrp_node * nodes;
+    uint8_t * buf;          /* w * h 8 bpp pixels */
+} ttf_atlas_page_t;
+
+/* a glyph rendered to an atlas page */
+typedef struct ttf_atlas_glyph {
+    uint32_t unicode_letter;
+    lv_coord_t font_size;
+    ttf_atlas_page_t * page;
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} ttf_atlas_glyph_t;
+
+/* the parsed font file and its glyph atlas. shared by the fonts of different sizes created from the same face */
+typedef struct ttf_face {
     lv_fs_file_t file;
 #if LV_TINY_TTF_FILE_SUPPORT
     ttf_cb_stream_t stream;
@@ -71,16 +94,208 @@ typedef struct ttf_font_desc {
     const uint8_t * stream;
 #endif
     stbtt_fontinfo info;
-    float scale;
     int ascent;
     int descent;
-    lv_lru_t * bitmap_cache;
+    int line_gap;
+    uint32_t ref_cnt;
+    /* atlas */
+    size_t cache_size;      /* byte budget of the atlas pages */
+    size_t used_size;
+    uint32_t life;
+    ttf_atlas_page_t * pages;
+    ttf_atlas_glyph_t * glyphs;
+    uint32_t glyph_cnt;
+    uint32_t glyph_cap;
+    int32_t * index;        /* open addressing hash table of glyph indices. -1: empty slot */
+    uint32_t index_cap;     /* power of 2 */
+    uint8_t * bitmap_buf;   /* the last returned glyph bitmap */
+    size_t bitmap_buf_size;
+    lv_tiny_ttf_cache_stats_t stats;
+} ttf_face_t;
+
+typedef struct ttf_font_desc {
+    ttf_face_t * face;
+    float scale;
+    lv_coord_t font_size;
 } ttf_font_desc_t;
 
-typedef struct ttf_bitmap_cache_key {
-    uint32_t unicode_letter;
-    lv_coord_t line_height;
-} ttf_bitmap_cache_key_t;
+static uint32_t atlas_hash(uint32_t unicode_letter, lv_coord_t font_size)
+{
+    return (unicode_letter * 2654435761u) ^ ((uint32_t)font_size * 40503u);
+}
+
+static const ttf_atlas_glyph_t * atlas_find(ttf_face_t * face, uint32_t unicode_letter, lv_coord_t font_size)
+{
+    if(face->index_cap == 0) return NULL;
+    uint32_t mask = face->index_cap - 1;
+    uint32_t i = atlas_hash(unicode_letter, font_size) & mask;
+    while(face->index[i] >= 0) {
+        const ttf_atlas_glyph_t * g = &face->glyphs[face->index[i]];
+        if(g->unicode_letter == unicode_letter && g->font_size == font_size) return g;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+static void atlas_index_rebuild(ttf_face_t * face)
+{
+    uint32_t mask = face->index_cap - 1;
+    uint32_t i;
+    for(i = 0; i < face->index_cap; i++) face->index[i] = -1;
+    for(i = 0; i < face->glyph_cnt; i++) {
+        uint32_t h = atlas_hash(face->glyphs[i].unicode_letter, face->glyphs[i].font_size) & mask;
+        while(face->index[h] >= 0) h = (h + 1) & mask;
+        face->index[h] = (int32_t)i;
+    }
+}
+
+static void atlas_page_free(ttf_face_t * face, ttf_atlas_page_t * page)
+{
+    ttf_atlas_page_t ** prev_next = &face->pages;
+    while(*prev_next != page) prev_next = &(*prev_next)->next;
+    *prev_next = page->next;
+
+    /* drop the glyphs of the page */
+    uint32_t i;
+    uint32_t cnt = 0;
+    for(i = 0; i < face->glyph_cnt; i++) {
+        if(face->glyphs[i].page != page) face->glyphs[cnt++] = face->glyphs[i];
+    }
+    face->glyph_cnt = cnt;
+    if(face->index_cap) atlas_index_rebuild(face);
+
+    face->used_size -= page->size;
+    TTF_FREE(page);
+}
+
+static void atlas_free(ttf_face_t * face)
+{
+    while(face->pages) {
+        ttf_atlas_page_t * next = face->pages->next;
+        TTF_FREE(face->pages);
+        face->pages = next;
+    }
+    TTF_FREE(face->glyphs);
+    TTF_FREE(face->index);
+    TTF_FREE(face->bitmap_buf);
+    face->glyphs = NULL;
+    face->index = NULL;
+    face->bitmap_buf = NULL;
+    face->glyph_cnt = 0;
+    face->glyph_cap = 0;
+    face->index_cap = 0;
+    face->bitmap_buf_size = 0;
+    face->used_size = 0;
+}
+
+static ttf_atlas_page_t * atlas_page_create(ttf_face_t * face, int w, int h)
+{
+    size_t size = sizeof(ttf_atlas_page_t) + w * sizeof(stbrp_node) + (size_t)w * h;
+    /* evict the least recently used pages to stay in the budget, but keep at least the new page */
+    while(face->pages && face->used_size + size > face->cache_size) {
+        ttf_atlas_page_t * lru = face->pages;
+        ttf_atlas_page_t * page;
+        for(page = face->pages->next; page; page = page->next) {
+            if(page->life < lru->life) lru = page;
+        }
+        atlas_page_free(face, lru);
+        face->stats.evict++;
+    }
+
+    ttf_atlas_page_t * page = (ttf_atlas_page_t *)TTF_MALLOC(size);
+    if(page == NULL) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        return NULL;
+    }
+    page->size = size;
+    page->w = w;
+    page->h = h;
+    page->life = face->life;
+    page->nodes = (stbrp_node *)(page + 1);
+    page->buf = (uint8_t *)(page->nodes + w);
+    lv_memset_00(page->buf, (size_t)w * h);
+    stbrp_init_target(&page->packer, w, h, page->nodes, w);
+
+    page->next = face->pages;
+    face->pages = page;
+    face->used_size += size;
+    return page;
+}
+
+/* render a glyph into the atlas. return NULL if it doesn't exist or on out of memory*/
+static const ttf_atlas_glyph_t * atlas_add(ttf_face_t * face, float scale, lv_coord_t font_size, uint32_t unicode_letter)
+{
+    int g1 = stbtt_FindGlyphIndex(&face->info, (int)unicode_letter);
+    if(g1 == 0) {
+        /* Glyph not found */
+        return NULL;
+    }
+    int x1, y1, x2, y2;
+    stbtt_GetGlyphBitmapBox(&face->info, g1, scale, scale, &x1, &y1, &x2, &y2);
+    int w = x2 - x1 + 1;
+    int h = y2 - y1 + 1;
+
+    /* make room for the new glyph in the arrays first so that failing later can't leave a half added glyph */
+    if(face->glyph_cnt == face->glyph_cap) {
+        uint32_t cap = face->glyph_cap ? face->glyph_cap * 2 : 32;
+        ttf_atlas_glyph_t * glyphs = (ttf_atlas_glyph_t *)lv_mem_realloc(face->glyphs, cap * sizeof(ttf_atlas_glyph_t));
+        if(glyphs == NULL) return NULL;
+        face->glyphs = glyphs;
+        face->glyph_cap = cap;
+    }
+    if((face->glyph_cnt + 1) * 2 > face->index_cap) {
+        uint32_t cap = face->index_cap ? face->index_cap * 2 : 64;
+        int32_t * index = (int32_t *)lv_mem_realloc(face->index, cap * sizeof(int32_t));
+        if(index == NULL) return NULL;
+        face->index = index;
+        face->index_cap = cap;
+        atlas_index_rebuild(face);
+    }
+
+    /* find a page with free space. glyphs larger than a page get a page of their own */
+    stbrp_rect rect;
+    rect.id = 0;
+    rect.w = w;
+    rect.h = h;
+    rect.was_packed = 0;
+    ttf_atlas_page_t * page = NULL;
+    if(w <= LV_TINY_TTF_ATLAS_PAGE_SIZE && h <= LV_TINY_TTF_ATLAS_PAGE_SIZE) {
+        for(page = face->pages; page; page = page->next) {
+            if(page->w != LV_TINY_TTF_ATLAS_PAGE_SIZE || page->h != LV_TINY_TTF_ATLAS_PAGE_SIZE) continue;
+            stbrp_pack_rects(&page->packer, &rect, 1);
+            if(rect.was_packed) break;
+        }
+        if(page == NULL) page = atlas_page_create(face, LV_TINY_TTF_ATLAS_PAGE_SIZE, LV_TINY_TTF_ATLAS_PAGE_SIZE);
+    }
+    else {
+        page = atlas_page_create(face, w, h);
+    }
+    if(page == NULL) return NULL;
+    if(!rect.was_packed) {
+        stbrp_pack_rects(&page->packer, &rect, 1);
+        if(!rect.was_packed) return NULL;
+    }
+    page->life = face->life;
+
+    stbtt_MakeGlyphBitmap(&face->info, page->buf + rect.y * page->w + rect.x, w, h, page->w, scale, scale, g1);
+
+    ttf_atlas_glyph_t * g = &face->glyphs[face->glyph_cnt];
+    g->unicode_letter = unicode_letter;
+    g->font_size = font_size;
+    g->page = page;
+    g->x = (uint16_t)rect.x;
+    g->y = (uint16_t)rect.y;
+    g->w = (uint16_t)w;
+    g->h = (uint16_t)h;
+
+    uint32_t mask = face->index_cap - 1;
+    uint32_t i = atlas_hash(unicode_letter, font_size) & mask;
+    while(face->index[i] >= 0) i = (i + 1) & mask;
+    face->index[i] = (int32_t)face->glyph_cnt;
+    face->glyph_cnt++;
+
+    return g;
+}
 
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
@@ -98,21 +313,22 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
+    const stbtt_fontinfo * info = &dsc->face->info;
+    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
     if(g1 == 0) {
         /* Glyph not found */
         return false;
     }
     int x1, y1, x2, y2;
 
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
+    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
     int g2 = 0;
     if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
+        g2 = stbtt_FindGlyphIndex(info, (int)unicode_letter_next);
     }
     int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
+    stbtt_GetGlyphHMetrics(info, g1, &advw, &lsb);
+    int k = stbtt_GetGlyphKernAdvance(info, g1, g2);
     dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
 
@@ -130,45 +346,63 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
 static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-    if(g1 == 0) {
-        /* Glyph not found */
-        return NULL;
+    ttf_face_t * face = dsc->face;
+    face->life++;
+    /*Try to load from the atlas*/
+    const ttf_atlas_glyph_t * g = atlas_find(face, unicode_letter, dsc->font_size);
+    if(g) {
+        face->stats.hit++;
+        g->page->life = face->life;
     }
-    int x1, y1, x2, y2;
-    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int w, h;
-    w = x2 - x1 + 1;
-    h = y2 - y1 + 1;
-    uint32_t stride = w;
-    /*Try to load from cache*/
-    ttf_bitmap_cache_key_t cache_key;
-    lv_memset(&cache_key, 0, sizeof(cache_key)); /*Zero padding*/
-    cache_key.unicode_letter = unicode_letter;
-    cache_key.line_height = font->line_height;
-    uint8_t * buffer = NULL;
-    lv_lru_get(dsc->bitmap_cache, &cache_key, sizeof(cache_key), (void **)&buffer);
-    if(buffer) {
-        return buffer;
-    }
-    LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
-    /*Prepare space in cache*/
-    size_t szb = h * stride;
-    buffer = lv_mem_alloc(szb);
-    if(!buffer) {
-        LV_LOG_ERROR("failed to allocate cache value");
+    else {
+        LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
+        face->stats.miss++;
+        g = atlas_add(face, dsc->scale, dsc->font_size, unicode_letter);
+        if(g == NULL) return NULL;
+    }
+    /*The glyph bitmaps have no stride so copy the glyph out of its page*/
+    size_t szb = (size_t)g->w * g->h;
+    if(szb > face->bitmap_buf_size) {
+        uint8_t * buf = (uint8_t *)lv_mem_realloc(face->bitmap_buf, szb);
+        if(buf == NULL) {
+            LV_LOG_ERROR("tiny_ttf: out of memory\n");
+            return NULL;
+        }
+        face->bitmap_buf = buf;
+        face->bitmap_buf_size = szb;
+    }
+    const uint8_t * src = g->page->buf + g->y * g->page->w + g->x;
+    uint8_t * dst = face->bitmap_buf;
+    uint32_t y;
+    for(y = 0; y < g->h; y++) {
+        lv_memcpy(dst, src, g->w);
+        dst += g->w;
+        src += g->page->w;
+    }
+    return face->bitmap_buf;
+}
+
+static lv_font_t * ttf_font_create(ttf_face_t * face, lv_coord_t font_size)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
+    if(dsc == NULL) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
         return NULL;
     }
-    lv_memset(buffer, 0, szb);
-    if(LV_LRU_OK != lv_lru_set(dsc->bitmap_cache, &cache_key, sizeof(cache_key), buffer, szb)) {
-        LV_LOG_ERROR("failed to add cache value");
-        lv_mem_free(buffer);
+    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    if(out_font == NULL) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        TTF_FREE(dsc);
         return NULL;
     }
-    /*Render into cache*/
-    stbtt_MakeGlyphBitmap(info, buffer, w, h, stride, dsc->scale, dsc->scale, g1);
-    return buffer;
+    dsc->face = face;
+    face->ref_cnt++;
+    lv_memset(out_font, 0, sizeof(lv_font_t));
+    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
+    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
+    out_font->dsc = dsc;
+    lv_tiny_ttf_set_size(out_font, font_size);
+    return out_font;
 }
 
 static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
@@ -178,60 +412,55 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
         LV_LOG_ERROR("tiny_ttf: invalid argument\n");
         return NULL;
     }
-    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
-    if(dsc == NULL) {
+    ttf_face_t * face = (ttf_face_t *)TTF_MALLOC(sizeof(ttf_face_t));
+    if(face == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
         return NULL;
     }
+    lv_memset(face, 0, sizeof(ttf_face_t));
 #if LV_TINY_TTF_FILE_SUPPORT
     if(path != NULL) {
-        if(LV_FS_RES_OK != lv_fs_open(&dsc->file, path, LV_FS_MODE_RD)) {
+        if(LV_FS_RES_OK != lv_fs_open(&face->file, path, LV_FS_MODE_RD)) {
             LV_LOG_ERROR("tiny_ttf: unable to open %s\n", path);
-            goto err_after_dsc;
+            goto err_after_face;
         }
-        dsc->stream.file = &dsc->file;
+        face->stream.file = &face->file;
     }
     else {
-        dsc->stream.file = NULL;
-        dsc->stream.data = (const uint8_t *)data;
-        dsc->stream.size = data_size;
-        dsc->stream.position = 0;
+        face->stream.file = NULL;
+        face->stream.data = (const uint8_t *)data;
+        face->stream.size = data_size;
+        face->stream.position = 0;
     }
-    if(0 == stbtt_InitFont(&dsc->info, &dsc->stream, stbtt_GetFontOffsetForIndex(&dsc->stream, 0))) {
+    if(0 == stbtt_InitFont(&face->info, &face->stream, stbtt_GetFontOffsetForIndex(&face->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        goto err_after_file;
     }
 
 #else
-    dsc->stream = (const uint8_t *)data;
+    face->stream = (const uint8_t *)data;
     LV_UNUSED(data_size);
-    if(0 == stbtt_InitFont(&dsc->info, dsc->stream, stbtt_GetFontOffsetForIndex(dsc->stream, 0))) {
+    if(0 == stbtt_InitFont(&face->info, face->stream, stbtt_GetFontOffsetForIndex(face->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        goto err_after_face;
     }
 #endif
+    stbtt_GetFontVMetrics(&face->info, &face->ascent, &face->descent, &face->line_gap);
+    face->cache_size = cache_size;
 
-    dsc->bitmap_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
-    if(dsc->bitmap_cache == NULL) {
-        LV_LOG_ERROR("failed to create lru cache");
-        goto err_after_dsc;
-    }
-
-    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    lv_font_t * out_font = ttf_font_create(face, font_size);
     if(out_font == NULL) {
-        LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        goto err_after_bitmap_cache;
+        goto err_after_file;
     }
-    lv_memset(out_font, 0, sizeof(lv_font_t));
-    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
-    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
-    out_font->dsc = dsc;
-    lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
-err_after_bitmap_cache:
-    lv_lru_del(dsc->bitmap_cache);
-err_after_dsc:
-    TTF_FREE(dsc);
+err_after_file:
+#if LV_TINY_TTF_FILE_SUPPORT
+    if(face->stream.file != NULL) {
+        lv_fs_close(&face->file);
+    }
+#endif
+err_after_face:
+    TTF_FREE(face);
     return NULL;
 }
 #if LV_TINY_TTF_FILE_SUPPORT
@@ -252,6 +481,15 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coor
 {
     return lv_tiny_ttf_create_data_ex(data, data_size, font_size, 4096);
 }
+lv_font_t * lv_tiny_ttf_create_size(const lv_font_t * font, lv_coord_t font_size)
+{
+    if(font == NULL || font_size <= 0) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    return ttf_font_create(dsc->face, font_size);
+}
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
 {
     if(font_size <= 0) {
@@ -259,24 +497,66 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
         return;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    dsc->scale = stbtt_ScaleForMappingEmToPixels(&dsc->info, font_size);
-    int line_gap = 0;
-    stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
-    font->line_height = (lv_coord_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
-    font->base_line = (lv_coord_t)(dsc->scale * (line_gap - dsc->descent));
+    ttf_face_t * face = dsc->face;
+    dsc->font_size = font_size;
+    dsc->scale = stbtt_ScaleForMappingEmToPixels(&face->info, font_size);
+    font->line_height = (lv_coord_t)(dsc->scale * (face->ascent - face->descent + face->line_gap));
+    font->base_line = (lv_coord_t)(dsc->scale * (face->line_gap - face->descent));
+    lv_txt_layout_cache_invalidate_font(font);
+#if LV_USE_DIGITLABEL
+    lv_digitlabel_invalidate_font(font);
+#endif
+}
+uint32_t lv_tiny_ttf_prewarm(lv_font_t * font, const char * txt)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    ttf_face_t * face = dsc->face;
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        if(letter < 0x20 || atlas_find(face, letter, dsc->font_size)) continue;
+        if(atlas_add(face, dsc->scale, dsc->font_size, letter)) cnt++;
+    }
+    return cnt;
+}
+void lv_tiny_ttf_get_cache_stats(const lv_font_t * font, lv_tiny_ttf_cache_stats_t * stats)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    ttf_face_t * face = dsc->face;
+    *stats = face->stats;
+    stats->glyph_cnt = face->glyph_cnt;
+    stats->page_cnt = 0;
+    ttf_atlas_page_t * page;
+    for(page = face->pages; page; page = page->next) stats->page_cnt++;
+    stats->used_size = face->used_size;
+}
+void lv_tiny_ttf_flush_cache(lv_font_t * font)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    atlas_free(dsc->face);
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
+        lv_txt_layout_cache_invalidate_font(font);
+#if LV_USE_DIGITLABEL
+        lv_digitlabel_invalidate_font(font);
+#endif
         if(font->dsc != NULL) {
-            ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
+            ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+            ttf_face_t * face = dsc->face;
+            face->ref_cnt--;
+            if(face->ref_cnt == 0) {
 #if LV_TINY_TTF_FILE_SUPPORT
-            if(ttf->stream.file != NULL) {
-                lv_fs_close(&ttf->file);
-            }
+                if(face->stream.file != NULL) {
+                    lv_fs_close(&face->file);
+                }
 #endif
-            lv_lru_del(ttf->bitmap_cache);
-            TTF_FREE(ttf);
+                atlas_free(face);
+                TTF_FREE(face);
+            }
+            TTF_FREE(dsc);
         }
         TTF_FREE(font);
     }
@@ -25,6 +25,15 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t hit;           /* glyph bitmaps found in the atlas */
+    uint32_t miss;          /* glyph bitmaps rasterized */
+    uint32_t evict;         /* atlas pages dropped to stay in the cache size */
+    uint32_t glyph_cnt;     /* glyphs currently in the atlas */
+    uint32_t page_cnt;      /* pages currently in the atlas */
+    size_t used_size;       /* bytes used by the atlas pages */
+} lv_tiny_ttf_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -43,9 +52,22 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coor
 /* create a font from the specified data pointer with the specified line height and the specified cache size.*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size);
 
+/* create a font with an other size from the same face. the new font shares the parsed font data and
+ * the glyph atlas (and its cache size) with the original font.*/
+lv_font_t * lv_tiny_ttf_create_size(const lv_font_t * font, lv_coord_t font_size);
+
 /* set the size of the font to a new font_size*/
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size);
 
+/* render the glyphs of a UTF-8 text into the glyph atlas in advance. return the number of glyphs rendered*/
+uint32_t lv_tiny_ttf_prewarm(lv_font_t * font, const char * txt);
+
+/* get the statistics of the glyph atlas of a font. the statistics are shared by the fonts of a face*/
+void lv_tiny_ttf_get_cache_stats(const lv_font_t * font, lv_tiny_ttf_cache_stats_t * stats);
+
+/* free the glyph atlas of a font (and the other sizes of its face)*/
+void lv_tiny_ttf_flush_cache(lv_font_t * font);
+
 /* destroy a font previously created with lv_tiny_ttf_create_xxxx()*/
 void lv_tiny_ttf_destroy(lv_font_t * font);
 
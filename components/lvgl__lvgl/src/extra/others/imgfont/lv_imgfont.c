@@ -78,6 +78,11 @@ void lv_imgfont_destroy(lv_font_t * font)
         return;
     }
 
+    lv_txt_layout_cache_invalidate_font(font);
+#if LV_USE_DIGITLABEL
+    lv_digitlabel_invalidate_font(font);
+#endif
+
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_mem_free(dsc);
 }
@@ -34,12 +34,19 @@ static void lv_chart_event(const lv_obj_class_t * class_p, lv_event_t * e);
 
 static void draw_div_lines(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
+static void draw_series_line_decim(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_line_dsc_t * line_dsc,
+                                   lv_coord_t x_ofs, lv_coord_t y_ofs, lv_coord_t w, lv_coord_t h);
 static void draw_series_bar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_series_scatter(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_cursors(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static void draw_axes(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static uint32_t get_index_from_x(lv_obj_t * obj, lv_coord_t x);
 static void invalidate_point(lv_obj_t * obj, uint16_t i);
+static uint32_t decim_get_block_size(lv_obj_t * obj);
+static void decim_scan(const lv_chart_series_t * ser, uint32_t from, uint32_t to, lv_coord_t * min, lv_coord_t * max);
+static bool decim_prepare(lv_obj_t * obj);
+static void decim_update(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t id, lv_coord_t old_value);
+static void decim_free(lv_obj_t * obj);
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, lv_coord_t ** a);
 lv_chart_tick_dsc_t * get_tick_gsc(lv_obj_t * obj, lv_chart_axis_t axis);
 
@@ -168,6 +175,18 @@ void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode
     lv_obj_invalidate(obj);
 }
 
+void lv_chart_set_decimation(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(chart->decimation == en) return;
+
+    chart->decimation = en;
+    if(!en) decim_free(obj);
+    lv_chart_refresh(obj);
+}
+
 void lv_chart_set_div_line_count(lv_obj_t * obj, uint8_t hdiv, uint8_t vdiv)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -258,6 +277,14 @@ uint16_t lv_chart_get_point_count(const lv_obj_t * obj)
     return chart->point_cnt;
 }
 
+bool lv_chart_get_decimation(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    return chart->decimation;
+}
+
 uint16_t lv_chart_get_x_start_point(const lv_obj_t * obj, lv_chart_series_t * ser)
 {
     LV_ASSERT_NULL(ser);
@@ -331,6 +358,8 @@ void lv_chart_refresh(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    chart->decim_block = 0; /*The points might have been changed directly, rebuild the blocks when drawn*/
     lv_obj_invalidate(obj);
 }
 
@@ -365,6 +394,8 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * obj, lv_color_t color, lv_cha
         return NULL;
     }
 
+    ser->decim_y = NULL;
+    chart->decim_block = 0;
     ser->start_point = 0;
     ser->y_ext_buf_assigned = false;
     ser->hidden = 0;
@@ -389,6 +420,7 @@ void lv_chart_remove_series(lv_obj_t * obj, lv_chart_series_t * series)
     lv_chart_t * chart    = (lv_chart_t *)obj;
     if(!series->y_ext_buf_assigned && series->y_points) lv_mem_free(series->y_points);
     if(!series->x_ext_buf_assigned && series->x_points) lv_mem_free(series->x_points);
+    if(series->decim_y) lv_mem_free(series->decim_y);
 
     _lv_ll_remove(&chart->series_ll, series);
     lv_mem_free(series);
@@ -538,7 +570,9 @@ void lv_chart_set_next_value(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_t
     LV_ASSERT_NULL(ser);
 
     lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_coord_t old_value = ser->y_points[ser->start_point];
     ser->y_points[ser->start_point] = value;
+    decim_update(obj, ser, ser->start_point, old_value);
     invalidate_point(obj, ser->start_point);
     ser->start_point = (ser->start_point + 1) % chart->point_cnt;
     invalidate_point(obj, ser->start_point);
@@ -569,7 +603,9 @@ void lv_chart_set_value_by_id(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t
     lv_chart_t * chart  = (lv_chart_t *)obj;
 
     if(id >= chart->point_cnt) return;
+    lv_coord_t old_value = ser->y_points[id];
     ser->y_points[id] = value;
+    decim_update(obj, ser, id, old_value);
     invalidate_point(obj, id);
 }
 
@@ -599,7 +635,7 @@ void lv_chart_set_ext_y_array(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_
     if(!ser->y_ext_buf_assigned && ser->y_points) lv_mem_free(ser->y_points);
     ser->y_ext_buf_assigned = true;
     ser->y_points = array;
-    lv_obj_invalidate(obj);
+    lv_chart_refresh(obj);
 }
 
 void lv_chart_set_ext_x_array(lv_obj_t * obj, lv_chart_series_t * ser, lv_coord_t array[])
@@ -681,6 +717,7 @@ static void lv_chart_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         ser = _lv_ll_get_head(&chart->series_ll);
 
         if(!ser->y_ext_buf_assigned) lv_mem_free(ser->y_points);
+        if(ser->decim_y) lv_mem_free(ser->decim_y);
 
         _lv_ll_remove(&chart->series_ll, ser);
         lv_mem_free(ser);
@@ -910,6 +947,12 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
     /*If there are at least as much points as pixels then draw only vertical lines*/
     bool crowded_mode = chart->point_cnt >= w ? true : false;
 
+    if(crowded_mode && decim_prepare(obj)) {
+        draw_series_line_decim(obj, draw_ctx, &line_dsc_default, x_ofs, y_ofs, w, h);
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+
     /*Go through all data lines*/
     _LV_LL_READ_BACK(&chart->series_ll, ser) {
         if(ser->hidden) continue;
@@ -1034,6 +1077,144 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
     draw_ctx->clip_area = clip_area_ori;
 }
 
+/**
+ * Get the points of a series to draw in the `step`-th step of the decimated drawing.
+ * The blocks are drawn from the one of the start point. In shift mode the start point
+ * splits its block: the first part is drawn in the first step, the rest in the last step.
+ * @param chart         pointer to a chart
+ * @param ser           pointer to a series
+ * @param start_point   index of the first point on the X axis
+ * @param step          0..block count
+ * @param from          store the index of the first point here
+ * @param to            store the index after the last point here
+ * @param min           store the smallest value of the points here
+ * @param max           store the largest value of the points here
+ * @return              false: no points to draw in this step
+ */
+static bool decim_get_points(lv_chart_t * chart, lv_chart_series_t * ser, uint32_t start_point, uint32_t step,
+                             uint32_t * from, uint32_t * to, lv_coord_t * min, lv_coord_t * max)
+{
+    uint32_t block = chart->decim_block;
+    uint32_t block_cnt = (chart->point_cnt + block - 1) / block;
+    uint32_t start_block = start_point / block;
+
+    if(step == 0) {
+        *from = start_point;
+        *to = LV_MIN((start_block + 1) * block, chart->point_cnt);
+    }
+    else if(step < block_cnt) {
+        *from = ((start_block + step) % block_cnt) * block;
+        *to = LV_MIN(*from + block, chart->point_cnt);
+    }
+    else {
+        *from = start_block * block;
+        *to = start_point;
+        if(*from == *to) return false;
+    }
+
+    /*Only the parts of a split block need to be scanned*/
+    if(step < block_cnt && *from % block == 0) {
+        *min = ser->decim_y[2 * (*from / block)];
+        *max = ser->decim_y[2 * (*from / block) + 1];
+    }
+    else {
+        decim_scan(ser, *from, *to, min, max);
+    }
+
+    return true;
+}
+
+static void draw_series_line_decim(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_line_dsc_t * line_dsc,
+                                   lv_coord_t x_ofs, lv_coord_t y_ofs, lv_coord_t w, lv_coord_t h)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    const lv_area_t * clip_area = draw_ctx->clip_area;
+    uint32_t block_cnt = (chart->point_cnt + chart->decim_block - 1) / chart->decim_block;
+    lv_coord_t line_w = line_dsc->width;
+
+    lv_draw_rect_dsc_t area_dsc;
+    lv_draw_rect_dsc_init(&area_dsc);
+    area_dsc.bg_opa = lv_obj_get_style_bg_opa(obj, LV_PART_ITEMS);
+
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(&chart->series_ll, ser) {
+        if(ser->hidden) continue;
+        line_dsc->color = ser->color;
+        area_dsc.bg_color = ser->color;
+
+        uint32_t start_point = lv_chart_get_x_start_point(obj, ser);
+        lv_coord_t ymin = chart->ymin[ser->y_axis_sec];
+        lv_coord_t yrange = chart->ymax[ser->y_axis_sec] - ymin;
+
+        /*Fill the area below the lines first, then draw a vertical line from the min. to the max. of
+         *every block, joined to the last point of the previous block*/
+        uint32_t pass;
+        for(pass = 0; pass < 2; pass++) {
+            if(pass == 0 && area_dsc.bg_opa <= LV_OPA_MIN) continue;
+
+            bool last_valid = false;
+            lv_coord_t y_last = 0;
+            lv_area_t fill_area;
+            fill_area.x1 = LV_COORD_MIN;
+            fill_area.y2 = h + y_ofs;
+
+            uint32_t step;
+            for(step = 0; step <= block_cnt; step++) {
+                uint32_t from;
+                uint32_t to;
+                lv_coord_t min;
+                lv_coord_t max;
+                if(!decim_get_points(chart, ser, start_point, step, &from, &to, &min, &max)) continue;
+
+                /*A block covers at most one column so it's drawn at its first point*/
+                uint32_t id = (from + chart->point_cnt - start_point) % chart->point_cnt;
+                lv_coord_t x = ((int32_t)w * id) / (chart->point_cnt - 1) + x_ofs;
+                if(x > clip_area->x2 + line_w) break;
+
+                lv_point_t p1 = {x, 0};
+                lv_point_t p2 = {x, 0};
+                bool valid = min != LV_CHART_POINT_NONE;
+                if(valid) {
+                    p1.y = h - (int32_t)((int32_t)max - ymin) * h / yrange + y_ofs;
+                    p2.y = h - (int32_t)((int32_t)min - ymin) * h / yrange + y_ofs;
+                    if(last_valid) {
+                        p1.y = LV_MIN(p1.y, y_last);
+                        p2.y = LV_MAX(p2.y, y_last);
+                    }
+                }
+
+                lv_coord_t last = ser->y_points[to - 1];
+                last_valid = last != LV_CHART_POINT_NONE;
+                if(last_valid) y_last = h - (int32_t)((int32_t)last - ymin) * h / yrange + y_ofs;
+
+                if(!valid || x < clip_area->x1 - line_w) continue;
+
+                if(pass == 0) {
+                    /*Blocks sharing a column are filled together from the lowest line*/
+                    if(fill_area.x1 == x) {
+                        fill_area.y1 = LV_MAX(fill_area.y1, p2.y + 1);
+                        continue;
+                    }
+                    if(fill_area.x1 != LV_COORD_MIN && fill_area.y1 <= fill_area.y2) {
+                        lv_draw_rect(draw_ctx, &area_dsc, &fill_area);
+                    }
+                    fill_area.x1 = x;
+                    fill_area.x2 = x;
+                    fill_area.y1 = p2.y + 1;
+                }
+                else {
+                    if(p1.y == p2.y) p2.y++;    /*If they are the same no line will be drawn*/
+                    lv_draw_line(draw_ctx, line_dsc, &p1, &p2);
+                }
+            }
+
+            if(pass == 0 && fill_area.x1 != LV_COORD_MIN && fill_area.y1 <= fill_area.y2) {
+                lv_draw_rect(draw_ctx, &area_dsc, &fill_area);
+            }
+        }
+    }
+}
+
 static void draw_series_scatter(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
 {
 
@@ -1704,6 +1885,16 @@ static void invalidate_point(lv_obj_t * obj, uint16_t i)
         coords.y1 -= line_width + point_w;
         coords.y2 += line_width + point_w;
 
+        if(chart->decim_block) {
+            /*Only the column of the block and the join to the next block change. No points are drawn.*/
+            uint32_t from = i - i % chart->decim_block;
+            uint32_t to = LV_MIN(from + chart->decim_block, chart->point_cnt - 1u);
+            coords.x1 = ((int32_t)w * from) / (chart->point_cnt - 1) + x_ofs - line_width;
+            coords.x2 = ((int32_t)w * to) / (chart->point_cnt - 1) + x_ofs + line_width;
+            lv_obj_invalidate_area(obj, &coords);
+            return;
+        }
+
         if(i < chart->point_cnt - 1) {
             coords.x1 = ((w * i) / (chart->point_cnt - 1)) + x_ofs - line_width - point_w;
             coords.x2 = ((w * (i + 1)) / (chart->point_cnt - 1)) + x_ofs + line_width + point_w;
@@ -1740,6 +1931,114 @@ static void invalidate_point(lv_obj_t * obj, uint16_t i)
     }
 }
 
+/**
+ * Get the number of points in a block of the decimated drawing.
+ * A block covers at most one column, so its min. and max. are drawn where its points would be.
+ * @param obj       pointer to a chart object
+ * @return          number of points in a block or 0 if the chart is not drawn decimated
+ */
+static uint32_t decim_get_block_size(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(!chart->decimation || chart->type != LV_CHART_TYPE_LINE || chart->point_cnt < 2) return 0;
+
+    lv_coord_t w = ((int32_t)lv_obj_get_content_width(obj) * chart->zoom_x) >> 8;
+    if(w <= 0 || chart->point_cnt < w) return 0;
+
+    return LV_MAX(1, (chart->point_cnt - 1) / w);
+}
+
+/*Get the min. and max. of the points in [from, to). LV_CHART_POINT_NONE if all are LV_CHART_POINT_NONE*/
+static void decim_scan(const lv_chart_series_t * ser, uint32_t from, uint32_t to, lv_coord_t * min, lv_coord_t * max)
+{
+    *min = LV_CHART_POINT_NONE;
+    *max = LV_CHART_POINT_NONE;
+
+    uint32_t i;
+    for(i = from; i < to; i++) {
+        lv_coord_t v = ser->y_points[i];
+        if(v == LV_CHART_POINT_NONE) continue;
+        if(*min == LV_CHART_POINT_NONE || v < *min) *min = v;
+        if(*max == LV_CHART_POINT_NONE || v > *max) *max = v;
+    }
+}
+
+/**
+ * Build the blocks of all series if the chart is drawn decimated and they are missing or outdated
+ * @param obj       pointer to a chart object
+ * @return          true: the blocks are ready to draw
+ */
+static bool decim_prepare(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    uint32_t block = decim_get_block_size(obj);
+    if(block == chart->decim_block) return block != 0;
+
+    chart->decim_block = 0;
+    if(block == 0) return false;
+
+    uint32_t block_cnt = (chart->point_cnt + block - 1) / block;
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(&chart->series_ll, ser) {
+        lv_coord_t * decim_y = lv_mem_realloc(ser->decim_y, sizeof(lv_coord_t) * 2 * block_cnt);
+        LV_ASSERT_MALLOC(decim_y);
+        if(decim_y == NULL) return false;
+        ser->decim_y = decim_y;
+
+        uint32_t b;
+        for(b = 0; b < block_cnt; b++) {
+            decim_scan(ser, b * block, LV_MIN((b + 1) * block, chart->point_cnt), &decim_y[2 * b], &decim_y[2 * b + 1]);
+        }
+    }
+
+    chart->decim_block = block;
+    return true;
+}
+
+/**
+ * Update the block of a changed point. The block is scanned again only if its min. or max. was removed.
+ * @param obj       pointer to a chart object
+ * @param ser       pointer to the series of the point
+ * @param id        index of the point
+ * @param old_value the value of the point before the change
+ */
+static void decim_update(lv_obj_t * obj, lv_chart_series_t * ser, uint16_t id, lv_coord_t old_value)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    if(chart->decim_block == 0) return;
+    if(chart->decim_block != decim_get_block_size(obj)) {
+        /*E.g. resized: rebuild all blocks when drawn*/
+        chart->decim_block = 0;
+        return;
+    }
+
+    uint32_t from = id - id % chart->decim_block;
+    lv_coord_t * min = &ser->decim_y[2 * (from / chart->decim_block)];
+    lv_coord_t * max = min + 1;
+    lv_coord_t v = ser->y_points[id];
+
+    if(old_value != LV_CHART_POINT_NONE &&
+       ((old_value == *min && (v == LV_CHART_POINT_NONE || v > old_value)) ||
+        (old_value == *max && (v == LV_CHART_POINT_NONE || v < old_value)))) {
+        decim_scan(ser, from, LV_MIN(from + chart->decim_block, chart->point_cnt), min, max);
+    }
+    else if(v != LV_CHART_POINT_NONE) {
+        if(*min == LV_CHART_POINT_NONE || v < *min) *min = v;
+        if(*max == LV_CHART_POINT_NONE || v > *max) *max = v;
+    }
+}
+
+static void decim_free(lv_obj_t * obj)
+{
+    lv_chart_t * chart  = (lv_chart_t *)obj;
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(&chart->series_ll, ser) {
+        if(ser->decim_y) lv_mem_free(ser->decim_y);
+        ser->decim_y = NULL;
+    }
+    chart->decim_block = 0;
+}
+
 static void new_points_alloc(lv_obj_t * obj, lv_chart_series_t * ser, uint32_t cnt, lv_coord_t ** a)
 {
     if((*a) == NULL) return;
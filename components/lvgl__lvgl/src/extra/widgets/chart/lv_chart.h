@@ -71,6 +71,7 @@ typedef uint8_t lv_chart_axis_t;
 typedef struct {
     lv_coord_t * x_points;
     lv_coord_t * y_points;
+    lv_coord_t * decim_y;   /**< Min. and max. value of every block of points for the decimated drawing*/
     lv_color_t color;
     uint16_t start_point;
     uint8_t hidden : 1;
@@ -113,8 +114,10 @@ typedef struct {
     uint16_t point_cnt;    /**< Point number in a data line*/
     uint16_t zoom_x;
     uint16_t zoom_y;
+    uint16_t decim_block;   /**< Points in a block of `decim_y`. 0: the blocks are not built*/
     lv_chart_type_t type  : 3; /**< Line or column chart*/
     lv_chart_update_mode_t update_mode : 1;
+    uint8_t decimation : 1; /**< Draw crowded line series from the min. and max. of the blocks*/
 } lv_chart_t;
 
 extern const lv_obj_class_t lv_chart_class;
@@ -173,6 +176,16 @@ void lv_chart_set_range(lv_obj_t * obj, lv_chart_axis_t axis, lv_coord_t min, lv
  */
 void lv_chart_set_update_mode(lv_obj_t * obj, lv_chart_update_mode_t update_mode);
 
+/**
+ * Enable the decimated drawing of line charts with at least as many points as pixels.
+ * The minimum and maximum of every block of points are kept up to date when the values change,
+ * so drawing depends only on the width of the chart and a new value invalidates only its columns.
+ * If `bg_opa` of `LV_PART_ITEMS` is set the area below the lines is also filled.
+ * @param obj       pointer to a chart object
+ * @param en        true: enable the decimated drawing; false: draw every point
+ */
+void lv_chart_set_decimation(lv_obj_t * obj, bool en);
+
 /**
  * Set the number of horizontal and vertical division lines
  * @param obj       pointer to a chart object
@@ -238,6 +251,13 @@ lv_chart_type_t lv_chart_get_type(const lv_obj_t * obj);
  */
 uint16_t lv_chart_get_point_count(const lv_obj_t * obj);
 
+/**
+ * Get whether the decimated drawing is enabled
+ * @param obj       pointer to chart object
+ * @return          true: decimated drawing is enabled
+ */
+bool lv_chart_get_decimation(const lv_obj_t * obj);
+
 /**
  * Get the current index of the x-axis start point in the data array
  * @param chart     pointer to a chart object
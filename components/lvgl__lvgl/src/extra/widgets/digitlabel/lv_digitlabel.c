@@ -0,0 +1,563 @@
+/**
+ * @file lv_digitlabel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_digitlabel.h"
+#if LV_USE_DIGITLABEL
+
+#include "../../../misc/lv_assert.h"
+#include "../../../misc/lv_gc.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_digitlabel_class
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A pre-rendered glyph of the atlas*/
+typedef struct {
+    uint32_t letter;
+    lv_coord_t cell_w;      /*Width of the letter's cell. The same for all digits.*/
+    lv_point_t ofs;         /*Position of `img` in the cell*/
+    lv_img_dsc_t img;       /*`data == NULL` if the glyph has no visible pixels (e.g. space)*/
+} lv_digitlabel_glyph_t;
+
+/*The glyphs of `LV_DIGITLABEL_CHARSET` rendered with a given font and color.
+ *Shared by all digit labels using the same font and color.*/
+typedef struct _lv_digitlabel_atlas_t {
+    struct _lv_digitlabel_atlas_t * next;
+    const lv_font_t * font;
+    lv_color_t color;
+    uint32_t ref_cnt;
+    lv_coord_t line_h;
+    uint32_t glyph_cnt;
+    lv_digitlabel_glyph_t * glyphs;
+    uint8_t * px_buf;       /*The pixels of all glyphs in `LV_IMG_CF_TRUE_COLOR_ALPHA` format*/
+} lv_digitlabel_atlas_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_digitlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_digitlabel_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_digitlabel_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void update_atlas(lv_obj_t * obj);
+static void invalidate_changed_cells(lv_obj_t * obj, const char * old_txt, const char * new_txt);
+static lv_coord_t get_cell_w(const lv_digitlabel_atlas_t * atlas, uint32_t letter);
+static lv_coord_t get_text_x(lv_obj_t * obj, const char * txt);
+static const lv_digitlabel_glyph_t * atlas_find(const lv_digitlabel_atlas_t * atlas, uint32_t letter);
+static lv_digitlabel_atlas_t * atlas_get(const lv_font_t * font, lv_color_t color);
+static void atlas_release(lv_digitlabel_atlas_t * atlas);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_digitlabel_class  = {
+    .base_class = &lv_obj_class,
+    .constructor_cb = lv_digitlabel_constructor,
+    .destructor_cb = lv_digitlabel_destructor,
+    .event_cb = lv_digitlabel_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_digitlabel_t),
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_digitlabel_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_digitlabel_set_text(lv_obj_t * obj, const char * text)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+
+    /*If text is NULL then just refresh with the current text*/
+    if(text == NULL || text == dlabel->text) {
+        lv_obj_invalidate(obj);
+        lv_obj_refresh_self_size(obj);
+        return;
+    }
+
+    if(strcmp(text, dlabel->text) == 0) return;
+
+    size_t old_len = strlen(dlabel->text);
+    size_t new_len = strlen(text);
+
+    invalidate_changed_cells(obj, dlabel->text, text);
+
+    if(old_len == new_len) {
+        /*Typical for clocks: reuse the buffer*/
+        lv_memcpy(dlabel->text, text, new_len + 1);
+    }
+    else {
+        char * new_txt = lv_mem_alloc(new_len + 1);
+        LV_ASSERT_MALLOC(new_txt);
+        if(new_txt == NULL) return;
+        lv_memcpy(new_txt, text, new_len + 1);
+        lv_mem_free(dlabel->text);
+        dlabel->text = new_txt;
+
+        lv_obj_refresh_self_size(obj);
+    }
+}
+
+void lv_digitlabel_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(fmt);
+
+    va_list args;
+    va_start(args, fmt);
+    char * text = _lv_txt_set_text_vfmt(fmt, args);
+    va_end(args);
+
+    if(text == NULL) return;
+    lv_digitlabel_set_text(obj, text);
+    lv_mem_free(text);
+}
+
+void lv_digitlabel_invalidate_font(const lv_font_t * font)
+{
+    lv_digitlabel_atlas_t ** prev_next = (lv_digitlabel_atlas_t **)&LV_GC_ROOT(_lv_digitlabel_atlas_head);
+    while(*prev_next) {
+        lv_digitlabel_atlas_t * atlas = *prev_next;
+        if(font == NULL || atlas->font == font) {
+            /*The digit labels still using it get a new atlas when they are drawn or measured next time*/
+            *prev_next = atlas->next;
+            atlas->next = NULL;
+            atlas->font = NULL;
+        }
+        else {
+            prev_next = &atlas->next;
+        }
+    }
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+char * lv_digitlabel_get_text(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+    return dlabel->text;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_digitlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+    dlabel->atlas = NULL;
+    dlabel->text = lv_mem_alloc(1);
+    LV_ASSERT_MALLOC(dlabel->text);
+    if(dlabel->text) dlabel->text[0] = '\0';
+
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_digitlabel_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+
+    if(dlabel->atlas) atlas_release(dlabel->atlas);
+    dlabel->atlas = NULL;
+
+    lv_mem_free(dlabel->text);
+    dlabel->text = NULL;
+}
+
+static void lv_digitlabel_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        update_atlas(obj);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        update_atlas(obj);
+        if(dlabel->atlas == NULL) return;
+
+        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+        lv_coord_t w = 0;
+        uint32_t i = 0;
+        while(dlabel->text[i] != '\0') {
+            uint32_t letter = _lv_txt_encoded_next(dlabel->text, &i);
+            w += get_cell_w(dlabel->atlas, letter) + letter_space;
+        }
+        if(w > 0) w -= letter_space;
+
+        lv_point_t * self_size = lv_event_get_param(e);
+        self_size->x = LV_MAX(self_size->x, w);
+        self_size->y = LV_MAX(self_size->y, dlabel->atlas->line_h);
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    /*The text color might have changed by a state change which doesn't send LV_EVENT_STYLE_CHANGED*/
+    update_atlas(obj);
+    lv_digitlabel_atlas_t * atlas = dlabel->atlas;
+    if(atlas == NULL) return;
+
+    lv_opa_t opa = lv_obj_get_style_text_opa(obj, LV_PART_MAIN);
+    if(opa <= LV_OPA_MIN) return;
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    img_dsc.opa = opa;
+    img_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, LV_PART_MAIN);
+
+    /*For the letters which are not in the atlas*/
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    lv_area_t cell;
+    lv_obj_get_content_coords(obj, &cell);
+    cell.y2 = cell.y1 + atlas->line_h - 1;
+    cell.x1 = get_text_x(obj, dlabel->text);
+
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    uint32_t i = 0;
+    while(dlabel->text[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(dlabel->text, &i);
+        lv_coord_t cell_w = get_cell_w(atlas, letter);
+        cell.x2 = cell.x1 + cell_w - 1;
+
+        if(_lv_area_is_on(&cell, draw_ctx->clip_area)) {
+            const lv_digitlabel_glyph_t * glyph = atlas_find(atlas, letter);
+            if(glyph == NULL) {
+                lv_point_t pos;
+                pos.x = cell.x1;
+                pos.y = cell.y1;
+                lv_draw_letter(draw_ctx, &label_dsc, &pos, letter);
+            }
+            else if(glyph->img.data) {
+                lv_area_t img_area;
+                img_area.x1 = cell.x1 + glyph->ofs.x;
+                img_area.y1 = cell.y1 + glyph->ofs.y;
+                img_area.x2 = img_area.x1 + glyph->img.header.w - 1;
+                img_area.y2 = img_area.y1 + glyph->img.header.h - 1;
+                lv_draw_img(draw_ctx, &img_dsc, &img_area, &glyph->img);
+            }
+        }
+
+        cell.x1 += cell_w + letter_space;
+    }
+}
+
+/**
+ * Get the atlas matching the current font and text color of the digit label
+ * @param obj       pointer to a digit label object
+ */
+static void update_atlas(lv_obj_t * obj)
+{
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_color_t color = lv_obj_get_style_text_color_filtered(obj, LV_PART_MAIN);
+
+    lv_digitlabel_atlas_t * atlas = dlabel->atlas;
+    if(atlas && atlas->font && atlas->font == font && atlas->color.full == color.full) return;
+
+    if(atlas) atlas_release(atlas);
+    dlabel->atlas = font ? atlas_get(font, color) : NULL;
+}
+
+/**
+ * Invalidate the cells whose letter or position is different in the new text
+ * @param obj       pointer to a digit label object
+ * @param old_txt   the current text
+ * @param new_txt   the text to set
+ */
+static void invalidate_changed_cells(lv_obj_t * obj, const char * old_txt, const char * new_txt)
+{
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+
+    update_atlas(obj);
+    lv_digitlabel_atlas_t * atlas = dlabel->atlas;
+    if(atlas == NULL) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_area_t area;
+    lv_obj_get_content_coords(obj, &area);
+    area.y2 = area.y1 + atlas->line_h - 1;
+
+    lv_coord_t x_old = get_text_x(obj, old_txt);
+    lv_coord_t x_new = get_text_x(obj, new_txt);
+    uint32_t i_old = 0;
+    uint32_t i_new = 0;
+    while(old_txt[i_old] != '\0' || new_txt[i_new] != '\0') {
+        uint32_t letter_old = old_txt[i_old] != '\0' ? _lv_txt_encoded_next(old_txt, &i_old) : 0;
+        uint32_t letter_new = new_txt[i_new] != '\0' ? _lv_txt_encoded_next(new_txt, &i_new) : 0;
+        lv_coord_t w_old = letter_old ? get_cell_w(atlas, letter_old) : 0;
+        lv_coord_t w_new = letter_new ? get_cell_w(atlas, letter_new) : 0;
+
+        if(letter_old != letter_new || x_old != x_new) {
+            if(w_old > 0) {
+                area.x1 = x_old;
+                area.x2 = x_old + w_old - 1;
+                lv_obj_invalidate_area(obj, &area);
+            }
+            if(w_new > 0 && (x_new != x_old || w_new != w_old)) {
+                area.x1 = x_new;
+                area.x2 = x_new + w_new - 1;
+                lv_obj_invalidate_area(obj, &area);
+            }
+        }
+
+        x_old += w_old + letter_space;
+        x_new += w_new + letter_space;
+    }
+}
+
+/**
+ * Get the width of a letter's cell
+ * @param atlas     pointer to an atlas
+ * @param letter    a letter
+ * @return          width of the cell. All digits have the same width.
+ */
+static lv_coord_t get_cell_w(const lv_digitlabel_atlas_t * atlas, uint32_t letter)
+{
+    const lv_digitlabel_glyph_t * glyph = atlas_find(atlas, letter);
+    if(glyph) return glyph->cell_w;
+
+    return lv_font_get_glyph_width(atlas->font, letter, 0);
+}
+
+/**
+ * Get the x coordinate of a text's first cell according to the text align
+ * @param obj       pointer to a digit label object
+ * @param txt       the text
+ * @return          the absolute x coordinate of the first cell
+ */
+static lv_coord_t get_text_x(lv_obj_t * obj, const char * txt)
+{
+    lv_digitlabel_t * dlabel = (lv_digitlabel_t *)obj;
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    if(align != LV_TEXT_ALIGN_CENTER && align != LV_TEXT_ALIGN_RIGHT) return content.x1;
+
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t w = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        w += get_cell_w(dlabel->atlas, letter) + letter_space;
+    }
+    if(w > 0) w -= letter_space;
+
+    if(align == LV_TEXT_ALIGN_CENTER) return content.x1 + (lv_area_get_width(&content) - w) / 2;
+    else return content.x2 + 1 - w;
+}
+
+static const lv_digitlabel_glyph_t * atlas_find(const lv_digitlabel_atlas_t * atlas, uint32_t letter)
+{
+    uint32_t i;
+    for(i = 0; i < atlas->glyph_cnt; i++) {
+        if(atlas->glyphs[i].letter == letter) return &atlas->glyphs[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Get an atlas for a font and color. An existing atlas is shared, else a new one is rendered.
+ * @param font      pointer to a font
+ * @param color     color of the glyphs
+ * @return          pointer to the atlas or NULL on out of memory
+ */
+static lv_digitlabel_atlas_t * atlas_get(const lv_font_t * font, lv_color_t color)
+{
+    lv_digitlabel_atlas_t * atlas;
+    for(atlas = LV_GC_ROOT(_lv_digitlabel_atlas_head); atlas != NULL; atlas = atlas->next) {
+        if(atlas->font == font && atlas->color.full == color.full) {
+            atlas->ref_cnt++;
+            return atlas;
+        }
+    }
+
+    const char * charset = LV_DIGITLABEL_CHARSET;
+    uint32_t letter_cnt = _lv_txt_get_encoded_length(charset);
+
+    atlas = lv_mem_alloc(sizeof(lv_digitlabel_atlas_t) + letter_cnt * sizeof(lv_digitlabel_glyph_t));
+    LV_ASSERT_MALLOC(atlas);
+    if(atlas == NULL) return NULL;
+    lv_memset_00(atlas, sizeof(lv_digitlabel_atlas_t));
+    atlas->glyphs = (lv_digitlabel_glyph_t *)(atlas + 1);
+    atlas->font = font;
+    atlas->color = color;
+    atlas->ref_cnt = 1;
+    atlas->line_h = lv_font_get_line_height(font);
+
+    lv_coord_t digit_w = 0;
+    uint32_t d;
+    for(d = '0'; d <= '9'; d++) {
+        digit_w = LV_MAX(digit_w, lv_font_get_glyph_width(font, d, 0));
+    }
+
+    /*First pass: place the glyphs in their cells and measure the required pixel buffer*/
+    uint32_t px_cnt = 0;
+    uint32_t i = 0;
+    while(charset[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(charset, &i);
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) continue;
+
+        /*Let the other glyphs be drawn as normal letters*/
+        if(g.resolved_font->subpx != LV_FONT_SUBPX_NONE) continue;
+        if(g.bpp != 1 && g.bpp != 2 && g.bpp != 3 && g.bpp != 4 && g.bpp != 8) continue;
+
+        lv_digitlabel_glyph_t * glyph = &atlas->glyphs[atlas->glyph_cnt];
+        atlas->glyph_cnt++;
+        lv_memset_00(glyph, sizeof(lv_digitlabel_glyph_t));
+        glyph->letter = letter;
+        glyph->cell_w = (letter >= '0' && letter <= '9') ? digit_w : g.adv_w;
+
+        /*Center digits in their cells, clip the box to the cell*/
+        lv_coord_t box_x = (glyph->cell_w - g.adv_w) / 2 + g.ofs_x;
+        lv_coord_t box_y = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+        lv_area_t box;
+        lv_area_set(&box, box_x, box_y, box_x + g.box_w - 1, box_y + g.box_h - 1);
+        lv_area_t cell;
+        lv_area_set(&cell, 0, 0, glyph->cell_w - 1, atlas->line_h - 1);
+        if(g.box_w == 0 || g.box_h == 0 || !_lv_area_intersect(&box, &box, &cell)) continue;
+
+        glyph->ofs.x = box.x1;
+        glyph->ofs.y = box.y1;
+        glyph->img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        glyph->img.header.w = lv_area_get_width(&box);
+        glyph->img.header.h = lv_area_get_height(&box);
+        glyph->img.data_size = lv_area_get_size(&box) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        px_cnt += lv_area_get_size(&box);
+    }
+
+    atlas->px_buf = lv_mem_alloc(px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    LV_ASSERT_MALLOC(atlas->px_buf);
+    if(atlas->px_buf == NULL) {
+        lv_mem_free(atlas);
+        return NULL;
+    }
+
+    /*Second pass: render the glyphs*/
+    uint8_t * px = atlas->px_buf;
+    for(i = 0; i < atlas->glyph_cnt; i++) {
+        lv_digitlabel_glyph_t * glyph = &atlas->glyphs[i];
+        if(glyph->img.data_size == 0) continue;
+
+        lv_font_glyph_dsc_t g;
+        lv_font_get_glyph_dsc(font, &g, glyph->letter, 0);
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(g.resolved_font, glyph->letter);
+        if(bitmap == NULL) {
+            glyph->img.data_size = 0;
+            continue;
+        }
+
+        uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;    /*Same as in letter drawing*/
+        uint32_t px_max = (1 << bpp) - 1;
+        lv_coord_t box_x = (glyph->cell_w - g.adv_w) / 2 + g.ofs_x;
+        lv_coord_t box_y = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+        lv_coord_t col_start = glyph->ofs.x - box_x;
+        lv_coord_t row_start = glyph->ofs.y - box_y;
+
+        glyph->img.data = px;
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < glyph->img.header.h; y++) {
+            for(x = 0; x < glyph->img.header.w; x++) {
+                uint32_t bit_ofs = ((row_start + y) * g.box_w + col_start + x) * bpp;
+                uint32_t v = (bitmap[bit_ofs >> 3] >> (8 - bpp - (bit_ofs & 0x7))) & px_max;
+                lv_memcpy_small(px, &color, sizeof(lv_color_t));
+                px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (v * 255 + px_max / 2) / px_max;
+                px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+        }
+    }
+
+    atlas->next = LV_GC_ROOT(_lv_digitlabel_atlas_head);
+    LV_GC_ROOT(_lv_digitlabel_atlas_head) = atlas;
+
+    return atlas;
+}
+
+static void atlas_release(lv_digitlabel_atlas_t * atlas)
+{
+    atlas->ref_cnt--;
+    if(atlas->ref_cnt > 0) return;
+
+    /*An invalidated atlas was already removed from the list*/
+    if(atlas->font) {
+        lv_digitlabel_atlas_t ** prev_next = (lv_digitlabel_atlas_t **)&LV_GC_ROOT(_lv_digitlabel_atlas_head);
+        while(*prev_next != atlas) prev_next = &(*prev_next)->next;
+        *prev_next = atlas->next;
+    }
+
+    uint32_t i;
+    for(i = 0; i < atlas->glyph_cnt; i++) {
+        if(atlas->glyphs[i].img.data) lv_img_cache_invalidate_src(&atlas->glyphs[i].img);
+    }
+
+    lv_mem_free(atlas->px_buf);
+    lv_mem_free(atlas);
+}
+
+#endif
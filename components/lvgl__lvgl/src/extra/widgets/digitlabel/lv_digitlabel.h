@@ -0,0 +1,106 @@
+/**
+ * @file lv_digitlabel.h
+ *
+ */
+
+#ifndef LV_DIGITLABEL_H
+#define LV_DIGITLABEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_DIGITLABEL
+
+/*********************
+ *      DEFINES
+ *********************/
+/** The characters pre-rendered into the glyph atlas. Other characters are drawn as normal letters.*/
+#ifndef LV_DIGITLABEL_CHARSET
+# define LV_DIGITLABEL_CHARSET "0123456789 +-.,:%\xC2\xB0" "CF"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_digitlabel_atlas_t;
+
+/*Data of digit label*/
+typedef struct {
+    lv_obj_t obj;
+    char * text;
+    struct _lv_digitlabel_atlas_t * atlas;   /**< Pre-rendered glyphs of the current font and color*/
+} lv_digitlabel_t;
+
+extern const lv_obj_class_t lv_digitlabel_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a digit label object
+ * @param parent    pointer to an object, it will be the parent of the new digit label
+ * @return          pointer to the created digit label
+ */
+lv_obj_t * lv_digitlabel_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set a new text for a digit label. Only the characters which are different from
+ * the previous text (or moved) are redrawn.
+ * @param obj       pointer to a digit label object
+ * @param text      '\0' terminated character string. NULL to refresh with the current text.
+ */
+void lv_digitlabel_set_text(lv_obj_t * obj, const char * text);
+
+/**
+ * Set a new formatted text for a digit label.
+ * @param obj       pointer to a digit label object
+ * @param fmt       `printf`-like format
+ *
+ * Example:
+ * @code
+ * lv_digitlabel_set_text_fmt(label1, "%02d:%02d", hour, min);
+ * @endcode
+ */
+void lv_digitlabel_set_text_fmt(lv_obj_t * obj, const char * fmt, ...) LV_FORMAT_ATTRIBUTE(2, 3);
+
+/**
+ * Drop the pre-rendered glyphs of a font. Should be called when a font is deleted or its
+ * glyphs or line height are changed.
+ * @param font      pointer to a font or NULL to drop the glyphs of all fonts
+ */
+void lv_digitlabel_invalidate_font(const lv_font_t * font);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the text of a digit label
+ * @param obj       pointer to a digit label object
+ * @return          the text of the digit label
+ */
+char * lv_digitlabel_get_text(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DIGITLABEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DIGITLABEL_H*/
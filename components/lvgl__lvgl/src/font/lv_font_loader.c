@@ -117,6 +117,11 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_txt_layout_cache_invalidate_font(font);
+#if LV_USE_DIGITLABEL
+        lv_digitlabel_invalidate_font(font);
+#endif
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
@@ -198,6 +198,16 @@
     #endif
 #endif
 
+/*Serve the `lv_mem_buf_get()` calls of a display refresh from an arena which is reset at the end of the refresh.
+ *The arena grows to the peak usage of the refreshes but not above this size (in bytes). 0: disable*/
+#ifndef LV_MEM_BUF_ARENA_MAX
+    #ifdef CONFIG_LV_MEM_BUF_ARENA_MAX
+        #define LV_MEM_BUF_ARENA_MAX CONFIG_LV_MEM_BUF_ARENA_MAX
+    #else
+        #define LV_MEM_BUF_ARENA_MAX (32U * 1024U)
+    #endif
+#endif
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #ifndef LV_MEMCPY_MEMSET_STD
     #ifdef CONFIG_LV_MEMCPY_MEMSET_STD
@@ -229,6 +239,16 @@
     #endif
 #endif
 
+/*Cost of refreshing one more area compared to drawing a pixel (e.g. walking the widgets and flushing).
+ *Invalid areas are joined if refreshing their bounding box is cheaper than refreshing them one by one.*/
+#ifndef LV_INV_AREA_OVERHEAD
+    #ifdef CONFIG_LV_INV_AREA_OVERHEAD
+        #define LV_INV_AREA_OVERHEAD CONFIG_LV_INV_AREA_OVERHEAD
+    #else
+        #define LV_INV_AREA_OVERHEAD 1024       /*[px]*/
+    #endif
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #ifndef LV_TICK_CUSTOM
@@ -293,7 +313,7 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching a shadow has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
     #ifndef LV_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_SHADOW_CACHE_SIZE
             #define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -301,20 +321,30 @@
             #define LV_SHADOW_CACHE_SIZE 0
         #endif
     #endif
-
-    /* Set number of maximally cached circle data.
-    * The circumference of 1/4 circle are saved for anti-aliasing
-    * radius * 4 bytes are used per circle (the most often used radiuses are saved)
-    * 0: to disable caching */
-    #ifndef LV_CIRCLE_CACHE_SIZE
-        #ifdef CONFIG_LV_CIRCLE_CACHE_SIZE
-            #define LV_CIRCLE_CACHE_SIZE CONFIG_LV_CIRCLE_CACHE_SIZE
-        #else
-            #define LV_CIRCLE_CACHE_SIZE 4
+    #if LV_SHADOW_CACHE_SIZE
+        /*Memory for the cached shadows in bytes. The least recently used shadows are dropped if a new one doesn't fit.
+         *Allocated with `lv_mem_alloc` in `lv_init()`, `lv_draw_sw_shadow_cache_set_buf()` can replace it*/
+        #ifndef LV_SHADOW_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+                #define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+            #else
+                #define LV_SHADOW_CACHE_MEM_SIZE (4 * LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+            #endif
         #endif
     #endif
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Max. number of fully opaque widgets tracked while redrawing an area.
+ *The widgets (or parts of their background) fully covered by them are not drawn at all.
+ *0: to disable occlusion culling*/
+#ifndef LV_REFR_OCCLUDER_MAX
+    #ifdef CONFIG_LV_REFR_OCCLUDER_MAX
+        #define LV_REFR_OCCLUDER_MAX CONFIG_LV_REFR_OCCLUDER_MAX
+    #else
+        #define LV_REFR_OCCLUDER_MAX 8
+    #endif
+#endif
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -366,16 +396,16 @@
     #endif
 #endif
 
-/*Default gradient buffer size.
- *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
- *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
- *If the cache is too small the map will be allocated only while it's required for the drawing.
+/*Default draw cache size in bytes, allocated with `lv_mem_alloc` in `lv_init()`.
+ *The gradient "maps" and the 1/4 circles of the rounded corners (radius * 6 bytes) are saved here
+ *to avoid calculating them again in the next frames. The least recently used ones are dropped if a new one doesn't fit.
+ *If the cache is too small the data will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
-#ifndef LV_GRAD_CACHE_DEF_SIZE
-    #ifdef CONFIG_LV_GRAD_CACHE_DEF_SIZE
-        #define LV_GRAD_CACHE_DEF_SIZE CONFIG_LV_GRAD_CACHE_DEF_SIZE
+#ifndef LV_DRAW_CACHE_SIZE
+    #ifdef CONFIG_LV_DRAW_CACHE_SIZE
+        #define LV_DRAW_CACHE_SIZE CONFIG_LV_DRAW_CACHE_SIZE
     #else
-        #define LV_GRAD_CACHE_DEF_SIZE 0
+        #define LV_DRAW_CACHE_SIZE (2 * 1024)
     #endif
 #endif
 
@@ -796,6 +826,17 @@
     #endif
 #endif
 
+/*Number of resolved style properties to remember per object, part and state.
+ *Saves walking the style list of the object on every style property query.
+ *Each entry costs about 16 bytes of RAM. 0: to disable caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1327,6 +1368,27 @@
     #endif
 #endif
 
+/*Number of measured texts (size and line breaks) to remember.
+ *Saves the re-layout of labels whose text, font and width haven't changed.
+ *Each entry costs about `LV_TXT_LAYOUT_CACHE_TEXT_MAX + 64` bytes of RAM. 0: to disable caching*/
+#ifndef LV_TXT_LAYOUT_CACHE_SIZE
+    #ifdef CONFIG_LV_TXT_LAYOUT_CACHE_SIZE
+        #define LV_TXT_LAYOUT_CACHE_SIZE CONFIG_LV_TXT_LAYOUT_CACHE_SIZE
+    #else
+        #define LV_TXT_LAYOUT_CACHE_SIZE 0
+    #endif
+#endif
+#if LV_TXT_LAYOUT_CACHE_SIZE
+    /*Longer texts are not cached*/
+    #ifndef LV_TXT_LAYOUT_CACHE_TEXT_MAX
+        #ifdef CONFIG_LV_TXT_LAYOUT_CACHE_TEXT_MAX
+            #define LV_TXT_LAYOUT_CACHE_TEXT_MAX CONFIG_LV_TXT_LAYOUT_CACHE_TEXT_MAX
+        #else
+            #define LV_TXT_LAYOUT_CACHE_TEXT_MAX 48
+        #endif
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -1700,6 +1762,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_DIGITLABEL
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_DIGITLABEL
+            #define LV_USE_DIGITLABEL CONFIG_LV_USE_DIGITLABEL
+        #else
+            #define LV_USE_DIGITLABEL 0
+        #endif
+    #else
+        #define LV_USE_DIGITLABEL 1
+    #endif
+#endif
+
 #ifndef LV_USE_IMGBTN
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_IMGBTN
@@ -2234,6 +2308,14 @@
             #define LV_TINY_TTF_FILE_SUPPORT 0
         #endif
     #endif
+    /*Width and height of a glyph atlas page [px]. The cache size of a font is spent on such pages.*/
+    #ifndef LV_TINY_TTF_ATLAS_PAGE_SIZE
+        #ifdef CONFIG_LV_TINY_TTF_ATLAS_PAGE_SIZE
+            #define LV_TINY_TTF_ATLAS_PAGE_SIZE CONFIG_LV_TINY_TTF_ATLAS_PAGE_SIZE
+        #else
+            #define LV_TINY_TTF_ATLAS_PAGE_SIZE 64
+        #endif
+    #endif
 #endif
 
 /*Rlottie library*/
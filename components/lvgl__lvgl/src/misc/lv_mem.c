@@ -39,9 +39,20 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#define ARENA_CHUNK_NONE   0xFFFFFFFF
+#define ARENA_ALIGN(x)     (((x) + 7) & ~7U)
+#define ARENA_GROW_STEP    1024
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_MEM_BUF_ARENA_MAX
+/*Header of the buffers in the arena*/
+typedef struct {
+    uint32_t prev;  /*Offset of the previous chunk's header or `ARENA_CHUNK_NONE`*/
+    uint32_t used;
+} arena_chunk_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -61,6 +72,16 @@
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_MEM_BUF_ARENA_MAX
+    static uint32_t arena_size;
+    static uint32_t arena_top;      /*Offset of the first free byte*/
+    static uint32_t arena_last;     /*Offset of the last chunk's header*/
+    static uint32_t arena_need;     /*The arena size which would have been enough in this frame*/
+    static uint32_t frame_depth;
+    static lv_mem_buf_frame_monitor_t frame_mon;
+    static lv_mem_buf_frame_monitor_t frame_mon_last;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -111,6 +132,17 @@ void lv_mem_init(void)
  */
 void lv_mem_deinit(void)
 {
+#if LV_MEM_BUF_ARENA_MAX
+#if LV_MEM_CUSTOM
+    lv_mem_free(LV_GC_ROOT(_lv_mem_buf_arena));
+#endif
+    LV_GC_ROOT(_lv_mem_buf_arena) = NULL;
+    arena_size = 0;
+    arena_top = 0;
+    arena_last = ARENA_CHUNK_NONE;
+    frame_depth = 0;
+#endif
+
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
     lv_mem_init();
@@ -278,6 +310,29 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
+#if LV_MEM_BUF_ARENA_MAX
+    /*During a refresh use the arena and fall back to the pool if it's full*/
+    if(frame_depth) {
+        uint32_t chunk_size = ARENA_ALIGN(sizeof(arena_chunk_t) + size);
+        if(arena_top + chunk_size > arena_need) arena_need = arena_top + chunk_size;
+
+        if(arena_top + chunk_size <= arena_size) {
+            arena_chunk_t * chunk = (arena_chunk_t *)(LV_GC_ROOT(_lv_mem_buf_arena) + arena_top);
+            chunk->prev = arena_last;
+            chunk->used = 1;
+            arena_last = arena_top;
+            arena_top += chunk_size;
+
+            frame_mon.arena_cnt++;
+            if(arena_top > frame_mon.arena_max_used) frame_mon.arena_max_used = arena_top;
+            MEM_TRACE("returning arena buffer (offset: %d)", arena_last);
+            return chunk + 1;
+        }
+
+        frame_mon.pool_cnt++;
+    }
+#endif
+
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
@@ -332,6 +387,23 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+#if LV_MEM_BUF_ARENA_MAX
+    uint8_t * arena = LV_GC_ROOT(_lv_mem_buf_arena);
+    if(arena && (uint8_t *)p >= arena && (uint8_t *)p < arena + arena_top) {
+        arena_chunk_t * chunk = (arena_chunk_t *)p - 1;
+        chunk->used = 0;
+
+        /*Free the released chunks from the top. Usually the buffers are released in reverse order*/
+        while(arena_last != ARENA_CHUNK_NONE) {
+            chunk = (arena_chunk_t *)(arena + arena_last);
+            if(chunk->used) break;
+            arena_top = arena_last;
+            arena_last = chunk->prev;
+        }
+        return;
+    }
+#endif
+
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
             LV_GC_ROOT(lv_mem_buf[i]).used = 0;
@@ -357,6 +429,60 @@ void lv_mem_buf_free_all(void)
     }
 }
 
+void _lv_mem_buf_frame_begin(void)
+{
+#if LV_MEM_BUF_ARENA_MAX
+    frame_depth++;
+    if(frame_depth > 1) return;
+
+    arena_top = 0;
+    arena_last = ARENA_CHUNK_NONE;
+    arena_need = 0;
+    lv_memset_00(&frame_mon, sizeof(frame_mon));
+#endif
+}
+
+void _lv_mem_buf_frame_end(void)
+{
+#if LV_MEM_BUF_ARENA_MAX
+    if(frame_depth == 0) return;
+    frame_depth--;
+    if(frame_depth > 0) return;
+
+    if(arena_last != ARENA_CHUNK_NONE) {
+        LV_LOG_WARN("not all buffers were released during the refresh");
+    }
+    arena_top = 0;
+    arena_last = ARENA_CHUNK_NONE;
+
+    /*Grow the arena to the peak need of this refresh*/
+    if(arena_need > arena_size && arena_size < LV_MEM_BUF_ARENA_MAX) {
+        uint32_t new_size = (arena_need + ARENA_GROW_STEP - 1) & ~(ARENA_GROW_STEP - 1);
+        if(new_size > LV_MEM_BUF_ARENA_MAX) new_size = LV_MEM_BUF_ARENA_MAX;
+
+        /*Nothing is used in the arena so it doesn't need to be copied*/
+        lv_mem_free(LV_GC_ROOT(_lv_mem_buf_arena));
+        LV_GC_ROOT(_lv_mem_buf_arena) = lv_mem_alloc(new_size);
+        arena_size = LV_GC_ROOT(_lv_mem_buf_arena) ? new_size : 0;
+        MEM_TRACE("arena resized to %d bytes", arena_size);
+    }
+
+    frame_mon.arena_size = arena_size;
+    frame_mon_last = frame_mon;
+    MEM_TRACE("refresh finished: %d arena buffers, %d pool buffers, %d bytes max. used", frame_mon.arena_cnt,
+              frame_mon.pool_cnt, frame_mon.arena_max_used);
+#endif
+}
+
+void lv_mem_buf_frame_monitor(lv_mem_buf_frame_monitor_t * mon_p)
+{
+#if LV_MEM_BUF_ARENA_MAX
+    *mon_p = frame_mon_last;
+#else
+    lv_memset_00(mon_p, sizeof(lv_mem_buf_frame_monitor_t));
+#endif
+}
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -51,6 +51,16 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+/**
+ * Usage of the temporal buffers in the last display refresh
+ */
+typedef struct {
+    uint32_t arena_cnt;     /**< Number of buffers served from the arena*/
+    uint32_t pool_cnt;      /**< Number of buffers served from the pool because the arena was full*/
+    uint32_t arena_size;    /**< Size of the arena for the next refresh*/
+    uint32_t arena_max_used; /**< Max. used size of the arena*/
+} lv_mem_buf_frame_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -114,10 +124,28 @@ void * lv_mem_buf_get(uint32_t size);
 void lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Free all memory buffers of the pool. The arena used during refresh is kept.
  */
 void lv_mem_buf_free_all(void);
 
+/**
+ * Start serving `lv_mem_buf_get()` from the arena. Called when a display refresh begins.
+ * Can be nested, only the outermost call has effect.
+ */
+void _lv_mem_buf_frame_begin(void);
+
+/**
+ * Reset the arena and grow it if the refresh needed more. Called when a display refresh ends.
+ */
+void _lv_mem_buf_frame_end(void);
+
+/**
+ * Give information about the temporal buffers used in the last display refresh
+ * @param mon_p pointer to a lv_mem_buf_frame_monitor_t variable,
+ *              the result will be stored here
+ */
+void lv_mem_buf_frame_monitor(lv_mem_buf_frame_monitor_t * mon_p);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -17,6 +17,8 @@
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_IDX_NONE 0xFFFFFFFF
+#define HEAP_MIN_SIZE 8
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +27,24 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static bool heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t idx);
+static void heap_sift_down(uint32_t idx);
+static inline bool timer_is_earlier(const lv_timer_t * a, const lv_timer_t * b);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static bool timer_act_deleted;
+static uint32_t handler_cnt;
+static uint32_t heap_cnt;
+static uint32_t heap_size;
 
 /**********************
  *      MACROS
@@ -55,6 +65,9 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    heap_cnt = 0;
+    heap_size = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -85,6 +98,7 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
     static uint32_t busy_time         = 0;
 
     uint32_t handler_start = lv_tick_get();
+    handler_cnt++;
 
     if(handler_start == 0) {
         static uint32_t run_cnt = 0;
@@ -95,39 +109,23 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
+    /*Run the timers in the order of their deadlines until the earliest one is not due.
+     *A timer runs only once in a call even if its period is shorter than the time spent here*/
+    while(heap_cnt) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(timer->repeat_count != 0) {
+            if(lv_timer_time_remaining(timer) != 0) break;
+            if(timer->handler_cnt == handler_cnt) break;
         }
-    } while(LV_GC_ROOT(_lv_timer_act));
 
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
+        lv_timer_exec(timer);
+    }
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    /*The earliest timer is always on the top of the heap*/
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    if(heap_cnt) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        time_till_next = timer->repeat_count == 0 ? 0 : lv_timer_time_remaining(timer);
     }
 
     busy_time += lv_tick_elaps(handler_start);
@@ -178,8 +176,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_idx = HEAP_IDX_NONE;
+    new_timer->handler_cnt = handler_cnt - 1;
 
-    timer_created = true;
+    if(!heap_insert(new_timer)) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), new_timer);
+        lv_mem_free(new_timer);
+        return NULL;
+    }
 
     return new_timer;
 }
@@ -200,8 +204,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    if(timer == LV_GC_ROOT(_lv_timer_act)) timer_act_deleted = true;
 
     lv_mem_free(timer);
 }
@@ -212,12 +217,19 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+    if(timer->paused) return;
+
     timer->paused = true;
+    heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
+
+    /*The heap was already large enough with this timer in it so it can't fail*/
     timer->paused = false;
+    heap_insert(timer);
 }
 
 /**
@@ -228,6 +240,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    heap_update(timer);
 }
 
 /**
@@ -237,6 +250,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 /**
@@ -247,6 +261,7 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+    heap_update(timer);
 }
 
 /**
@@ -257,6 +272,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    heap_update(timer);
 }
 
 /**
@@ -293,37 +309,35 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a timer which is due and delete it if its repeat count is over
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count != 0) {
+        /* Decrement the repeat count and reschedule the timer before executing the timer_cb
+         * so that the heap is valid if the callback creates, deletes or modifies timers.*/
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+        timer->handler_cnt = handler_cnt;
+        heap_update(timer);
+
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        timer_act_deleted = false;
         TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+        if(timer->timer_cb) timer->timer_cb(timer);
         TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
         LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+        LV_GC_ROOT(_lv_timer_act) = NULL;
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
-        if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
-            TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-            lv_timer_del(timer);
-        }
+        /*The timer deleted itself*/
+        if(timer_act_deleted) return;
     }
 
-    return exec;
+    if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
+        TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+        lv_timer_del(timer);
+    }
 }
 
 /**
@@ -339,3 +353,112 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Tell whether a timer needs to run earlier than an other.
+ * @param a pointer to lv_timer
+ * @param b pointer to lv_timer
+ * @return true: `a` is earlier than `b`
+ */
+static inline bool timer_is_earlier(const lv_timer_t * a, const lv_timer_t * b)
+{
+    /*Timers with zero repeat count are waiting only to be deleted*/
+    if(a->repeat_count == 0) return b->repeat_count != 0;
+    if(b->repeat_count == 0) return false;
+
+    /*Compare the deadlines in a way which works with the overflow of the tick too*/
+    int32_t diff = (int32_t)((a->last_run + a->period) - (b->last_run + b->period));
+    if(diff != 0) return diff < 0;
+
+    /*With the same deadline the timer which hasn't run in this `lv_timer_handler` call is the earlier*/
+    return a->handler_cnt != handler_cnt && b->handler_cnt == handler_cnt;
+}
+
+/**
+ * Add a timer to the heap of the scheduled timers
+ * @param timer pointer to lv_timer
+ * @return true: success; false: out of memory
+ */
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(heap_cnt == heap_size) {
+        uint32_t new_size = heap_size ? heap_size * 2 : HEAP_MIN_SIZE;
+        lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return false;
+        LV_GC_ROOT(_lv_timer_heap) = new_heap;
+        heap_size = new_size;
+    }
+
+    LV_GC_ROOT(_lv_timer_heap)[heap_cnt] = timer;
+    timer->heap_idx = heap_cnt;
+    heap_cnt++;
+    heap_sift_up(timer->heap_idx);
+
+    return true;
+}
+
+/**
+ * Remove a timer from the heap of the scheduled timers if it's there
+ * @param timer pointer to lv_timer
+ */
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->heap_idx;
+    if(idx == HEAP_IDX_NONE) return;
+
+    timer->heap_idx = HEAP_IDX_NONE;
+    heap_cnt--;
+    if(idx == heap_cnt) return;
+
+    /*Move the last timer to the free place and restore the order from there*/
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    heap[idx] = heap[heap_cnt];
+    heap[idx]->heap_idx = idx;
+    heap_sift_up(idx);
+    heap_sift_down(heap[idx]->heap_idx);
+}
+
+/**
+ * Move a timer to its place in the heap after its deadline has changed
+ * @param timer pointer to lv_timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    if(timer->heap_idx == HEAP_IDX_NONE) return;
+
+    heap_sift_up(timer->heap_idx);
+    heap_sift_down(timer->heap_idx);
+}
+
+static void heap_sift_up(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[idx];
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!timer_is_earlier(timer, heap[parent])) break;
+        heap[idx] = heap[parent];
+        heap[idx]->heap_idx = idx;
+        idx = parent;
+    }
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
+
+static void heap_sift_down(uint32_t idx)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[idx];
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && timer_is_earlier(heap[child + 1], heap[child])) child++;
+        if(!timer_is_earlier(heap[child], timer)) break;
+        heap[idx] = heap[child];
+        heap[idx]->heap_idx = idx;
+        idx = child;
+    }
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
@@ -39,7 +39,8 @@ struct _lv_timer_t;
 typedef void (*lv_timer_cb_t)(struct _lv_timer_t *);
 
 /**
- * Descriptor of a lv_timer
+ * Descriptor of a lv_timer.
+ * Modify it only with the `lv_timer_...` functions as they also reschedule the timer.
  */
 typedef struct _lv_timer_t {
     uint32_t period; /**< How often the timer should run*/
@@ -47,6 +48,8 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t heap_idx; /**< Index in the scheduler's heap. Not in the heap while paused*/
+    uint32_t handler_cnt; /**< The `lv_timer_handler` call in which the timer ran last time*/
     uint32_t paused : 1;
 } lv_timer_t;
 
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include <stdarg.h>
+#include <string.h>
 #include "lv_txt.h"
 #include "lv_txt_ap.h"
 #include "lv_math.h"
@@ -22,10 +23,30 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+typedef struct {
+    const lv_font_t * font;     /*NULL if the entry is unused*/
+    uint32_t hash;
+    uint32_t life;              /*Value of `layout_cache_life` when the entry was last used*/
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+    uint16_t len;
+    lv_txt_layout_t layout;
+    char text[LV_TXT_LAYOUT_CACHE_TEXT_MAX];    /*Not '\0' terminated*/
+} lv_txt_layout_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void txt_measure(lv_point_t * size_res, lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                        lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    static const lv_txt_layout_t * layout_cache_get(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                                    lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -49,6 +70,11 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    static lv_txt_layout_cache_entry_t layout_cache[LV_TXT_LAYOUT_CACHE_SIZE];
+    static uint32_t layout_cache_life;
+    static lv_txt_layout_cache_stats_t layout_cache_stats;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -99,41 +125,59 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
-    uint32_t line_start     = 0;
-    uint32_t new_line_start = 0;
-    uint16_t letter_height = lv_font_get_line_height(font);
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    const lv_txt_layout_t * layout = layout_cache_get(text, font, letter_space, line_space, max_width, flag);
+    if(layout) {
+        *size_res = layout->size;
+        return;
+    }
+#endif
 
-    /*Calc. the height and longest line*/
-    while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+    txt_measure(size_res, NULL, text, font, letter_space, line_space, max_width, flag);
+}
 
-        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
-            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
-            return;
-        }
-        else {
-            size_res->y += letter_height;
-            size_res->y += line_space;
-        }
+const lv_txt_layout_t * _lv_txt_get_layout(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                           lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    if(text == NULL) return NULL;
+    if(font == NULL) return NULL;
 
-        /*Calculate the longest line*/
-        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
-                                                      flag);
+    if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
-        size_res->x = LV_MAX(act_line_length, size_res->x);
-        line_start  = new_line_start;
-    }
+    const lv_txt_layout_t * layout = layout_cache_get(text, font, letter_space, line_space, max_width, flag);
+    if(layout == NULL || layout->line_cnt == 0) return NULL;
+    return layout;
+#else
+    LV_UNUSED(text);
+    LV_UNUSED(font);
+    LV_UNUSED(letter_space);
+    LV_UNUSED(line_space);
+    LV_UNUSED(max_width);
+    LV_UNUSED(flag);
+    return NULL;
+#endif
+}
 
-    /*Make the text one line taller if the last character is '\n' or '\r'*/
-    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
-        size_res->y += letter_height + line_space;
+void lv_txt_layout_cache_invalidate_font(const lv_font_t * font)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    uint32_t i;
+    for(i = 0; i < LV_TXT_LAYOUT_CACHE_SIZE; i++) {
+        if(font == NULL || layout_cache[i].font == font) layout_cache[i].font = NULL;
     }
+#else
+    LV_UNUSED(font);
+#endif
+}
 
-    /*Correction with the last line space or set the height manually if the text is empty*/
-    if(size_res->y == 0)
-        size_res->y = letter_height;
-    else
-        size_res->y -= line_space;
+void lv_txt_layout_cache_get_stats(lv_txt_layout_cache_stats_t * stats)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    *stats = layout_cache_stats;
+#else
+    lv_memset_00(stats, sizeof(lv_txt_layout_cache_stats_t));
+#endif
 }
 
 /**
@@ -496,6 +540,139 @@ void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? _lv_txt_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Measure a text line by line.
+ * @param size_res store the size of the text here. Should be zeroed.
+ * @param layout if not NULL store the size and the line breaks here too
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param line_space line space of the text
+ * @param max_width max width of the text, already adjusted to `LV_TEXT_FLAG_EXPAND`
+ * @param flags settings for the text from ::lv_text_flag_t
+ */
+static void txt_measure(lv_point_t * size_res, lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                        lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    uint32_t line_start     = 0;
+    uint32_t new_line_start = 0;
+    uint32_t line_cnt       = 0;
+    uint16_t letter_height = lv_font_get_line_height(font);
+
+    if(layout) layout->line_cnt = 0;
+
+    /*Calc. the height and longest line*/
+    while(text[line_start] != '\0') {
+        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
+            if(layout) layout->size = *size_res;
+            return;
+        }
+        else {
+            size_res->y += letter_height;
+            size_res->y += line_space;
+        }
+
+        /*Calculate the longest line*/
+        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
+                                                      flag);
+
+        if(layout && line_cnt < LV_TXT_LAYOUT_LINE_MAX) {
+            layout->line_start[line_cnt] = line_start;
+            layout->line_w[line_cnt] = act_line_length;
+        }
+        line_cnt++;
+
+        size_res->x = LV_MAX(act_line_length, size_res->x);
+        line_start  = new_line_start;
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0)
+        size_res->y = letter_height;
+    else
+        size_res->y -= line_space;
+
+    if(layout) {
+        layout->size = *size_res;
+        if(line_cnt <= LV_TXT_LAYOUT_LINE_MAX) {
+            layout->line_start[line_cnt] = line_start;
+            layout->line_cnt = line_cnt;
+        }
+    }
+}
+
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+/**
+ * Find a text in the layout cache or measure it and add it to the cache.
+ * The text is compared byte-by-byte on hash match so a changed text never gets a stale layout.
+ * @return pointer to the layout or NULL if the text is longer than `LV_TXT_LAYOUT_CACHE_TEXT_MAX`
+ */
+static const lv_txt_layout_t * layout_cache_get(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                                lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    /*FNV-1a hash of the text*/
+    uint32_t hash = 2166136261UL;
+    uint32_t len;
+    for(len = 0; text[len] != '\0'; len++) {
+        if(len >= LV_TXT_LAYOUT_CACHE_TEXT_MAX) return NULL;
+        hash = (hash ^ (uint8_t)text[len]) * 16777619UL;
+    }
+
+    layout_cache_life++;
+
+    lv_txt_layout_cache_entry_t * oldest = &layout_cache[0];
+    uint32_t i;
+    for(i = 0; i < LV_TXT_LAYOUT_CACHE_SIZE; i++) {
+        lv_txt_layout_cache_entry_t * e = &layout_cache[i];
+        if(e->font == NULL) {
+            /*Use a free entry rather than evicting one*/
+            if(oldest->font != NULL) oldest = e;
+            continue;
+        }
+
+        if(e->hash == hash && e->len == len && e->font == font && e->flag == flag &&
+           e->letter_space == letter_space && e->line_space == line_space && e->max_width == max_width &&
+           memcmp(e->text, text, len) == 0) {
+            e->life = layout_cache_life;
+            layout_cache_stats.hit++;
+            return &e->layout;
+        }
+
+        if(oldest->font != NULL && e->life < oldest->life) oldest = e;
+    }
+
+    layout_cache_stats.miss++;
+    if(oldest->font != NULL) layout_cache_stats.evict++;
+
+    oldest->font = font;
+    oldest->hash = hash;
+    oldest->life = layout_cache_life;
+    oldest->letter_space = letter_space;
+    oldest->line_space = line_space;
+    oldest->max_width = max_width;
+    oldest->flag = flag;
+    oldest->len = len;
+    lv_memcpy(oldest->text, text, len);
+
+    lv_point_t size = {0, 0};
+    txt_measure(&size, &oldest->layout, text, font, letter_space, line_space, max_width, flag);
+
+    return &oldest->layout;
+}
+#endif
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
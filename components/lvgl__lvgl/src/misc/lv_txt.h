@@ -32,6 +32,11 @@ extern "C" {
 #define LV_TXT_ENC_UTF8 1
 #define LV_TXT_ENC_ASCII 2
 
+/*Max. number of lines whose breaks are stored in a layout cache entry*/
+#ifndef LV_TXT_LAYOUT_LINE_MAX
+#define LV_TXT_LAYOUT_LINE_MAX 8
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -65,6 +70,25 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/**
+ * Measured size and line breaks of a text, as stored in the layout cache.
+ */
+typedef struct {
+    lv_point_t size;                                /**< The size `lv_txt_get_size` would return*/
+    uint16_t line_cnt;                              /**< Number of lines, 0 if they didn't fit into `line_start`*/
+    uint16_t line_start[LV_TXT_LAYOUT_LINE_MAX + 1]; /**< Byte index of the lines' first char. `line_start[line_cnt]` is the text's length*/
+    lv_coord_t line_w[LV_TXT_LAYOUT_LINE_MAX];      /**< Width of the lines as `lv_txt_get_width` would return*/
+} lv_txt_layout_t;
+
+/**
+ * Statistics of the layout cache.
+ */
+typedef struct {
+    uint32_t hit;       /**< Number of layout passes saved by the cache*/
+    uint32_t miss;      /**< Number of cacheable texts which had to be measured*/
+    uint32_t evict;     /**< Number of entries dropped to make place for new ones*/
+} lv_txt_layout_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -83,6 +107,36 @@ typedef uint8_t lv_text_align_t;
 void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                      lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
 
+/**
+ * Get the size and line breaks of a text from the layout cache. The text is measured and
+ * added to the cache if it's not there yet.
+ * The returned pointer is valid only until the next text measurement.
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param line_space line space of the text
+ * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid
+ * line breaks
+ * @param flags settings for the text from ::lv_text_flag_t
+ * @return pointer to the layout or NULL if the text can't be cached (caching is disabled,
+ * the text is too long or has too many lines)
+ */
+const lv_txt_layout_t * _lv_txt_get_layout(const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                                           lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
+
+/**
+ * Drop the cached layouts measured with a font. Should be called when a font is deleted or its
+ * glyphs or line height are changed.
+ * @param font pointer to a font or NULL to drop all cached layouts
+ */
+void lv_txt_layout_cache_invalidate_font(const lv_font_t * font);
+
+/**
+ * Get the statistics of the layout cache.
+ * @param stats store the statistics here
+ */
+void lv_txt_layout_cache_get_stats(lv_txt_layout_cache_stats_t * stats);
+
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
@@ -0,0 +1,186 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+#include <time.h>
+
+#define HOR_RES     800
+#define VER_RES     480
+#define POINT_CNT   10000
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[HOR_RES * VER_RES];
+static lv_obj_t * chart;
+static lv_chart_series_t * ser;
+
+/*A slow wave with some noise like a temperature history*/
+static lv_coord_t history_value(uint32_t i)
+{
+    return 50 + lv_trigo_sin((i * 360 / 2000) % 360) / 1000 + lv_rand(0, 10);
+}
+
+static void refresh_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    chart = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(chart, HOR_RES, 400);
+    lv_obj_set_style_line_width(chart, 1, LV_PART_ITEMS);
+    lv_chart_set_point_count(chart, POINT_CNT);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 120);
+    ser = lv_chart_add_series(chart, lv_color_hex(0xff0000), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_decimation(chart, true);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_chart_decimation_keeps_peaks(void)
+{
+    lv_chart_set_all_value(chart, ser, 60);
+    lv_chart_set_value_by_id(chart, ser, 1234, 120);
+    lv_chart_set_value_by_id(chart, ser, 5678, 0);
+    refresh_screen();
+
+    lv_point_t peak;
+    lv_point_t dip;
+    lv_chart_get_point_pos_by_id(chart, ser, 1234, &peak);
+    lv_chart_get_point_pos_by_id(chart, ser, 5678, &dip);
+    peak.x += chart->coords.x1;
+    peak.y += chart->coords.y1;
+    dip.x += chart->coords.x1;
+    dip.y += chart->coords.y1;
+
+    /*The single points are drawn even if there are 12 points in a column.
+     *They are in the column of their block, which can start on the previous pixel.
+     *The last pixel of the vertical lines is not drawn.*/
+    dip.y--;
+    uint32_t red = lv_color_to32(lv_color_hex(0xff0000));
+    TEST_ASSERT_TRUE(lv_color_to32(test_fb[peak.y * HOR_RES + peak.x]) == red ||
+                     lv_color_to32(test_fb[peak.y * HOR_RES + peak.x - 1]) == red);
+    TEST_ASSERT_TRUE(lv_color_to32(test_fb[dip.y * HOR_RES + dip.x]) == red ||
+                     lv_color_to32(test_fb[dip.y * HOR_RES + dip.x - 1]) == red);
+}
+
+void test_chart_decimation_fills_area(void)
+{
+    lv_obj_set_style_bg_opa(chart, LV_OPA_COVER, LV_PART_ITEMS);
+    lv_chart_set_all_value(chart, ser, 60);
+    refresh_screen();
+
+    lv_point_t p;
+    lv_chart_get_point_pos_by_id(chart, ser, 5000, &p);
+    p.x += chart->coords.x1;
+    p.y += chart->coords.y1;
+
+    /*Filled below the line down to the bottom of the chart, not above*/
+    uint32_t red = lv_color_to32(lv_color_hex(0xff0000));
+    TEST_ASSERT_EQUAL_HEX32(red, lv_color_to32(test_fb[(p.y + 20) * HOR_RES + p.x]));
+    TEST_ASSERT_EQUAL_HEX32(red, lv_color_to32(test_fb[(chart->coords.y2 - 20) * HOR_RES + p.x]));
+    TEST_ASSERT_NOT_EQUAL(red, lv_color_to32(test_fb[(p.y - 20) * HOR_RES + p.x]));
+}
+
+void test_chart_decimation_incremental_same_as_rebuilt(void)
+{
+    uint32_t mode;
+    for(mode = 0; mode < 2; mode++) {
+        lv_chart_set_update_mode(chart, mode == 0 ? LV_CHART_UPDATE_MODE_CIRCULAR : LV_CHART_UPDATE_MODE_SHIFT);
+        lv_chart_set_all_value(chart, ser, LV_CHART_POINT_NONE);
+        refresh_screen();
+
+        /*Wrap around and overwrite the min. and max. of the blocks*/
+        uint32_t i;
+        for(i = 0; i < POINT_CNT + POINT_CNT / 3; i++) {
+            lv_chart_set_next_value(chart, ser, history_value(i));
+        }
+        lv_chart_set_value_by_id(chart, ser, 4321, LV_CHART_POINT_NONE);
+        refresh_screen();
+        memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+        /*Rebuild the blocks from the points*/
+        lv_chart_refresh(chart);
+        refresh_screen();
+        TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+    }
+}
+
+void test_chart_decimation_invalidates_the_new_column(void)
+{
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_all_value(chart, ser, 60);
+    refresh_screen();
+
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_chart_set_next_value(chart, ser, history_value(i));
+
+        /*The block of the new point and the one of the next point if it starts a new block.
+         *2 columns, the line width and the 5 px margin of `lv_obj_invalidate_area` on both sides.*/
+        TEST_ASSERT_LESS_OR_EQUAL(2, disp->inv_p);
+        uint32_t a;
+        for(a = 0; a < disp->inv_p; a++) {
+            TEST_ASSERT_LESS_OR_EQUAL(14, lv_area_get_width(&disp->inv_areas[a]));
+        }
+        lv_refr_now(NULL);
+    }
+
+    /*Without decimation the points and their neighbors are invalidated*/
+    lv_chart_set_decimation(chart, false);
+    lv_refr_now(NULL);
+    lv_chart_set_next_value(chart, ser, 60);
+    TEST_ASSERT_GREATER_THAN(14, lv_area_get_width(&disp->inv_areas[0]));
+}
+
+void test_chart_decimation_benchmark(void)
+{
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) {
+        lv_chart_set_next_value(chart, ser, history_value(i));
+    }
+
+    const uint32_t rounds = 20;
+    clock_t t_full[2];
+    clock_t t_append[2];
+    uint32_t decim;
+    for(decim = 0; decim < 2; decim++) {
+        lv_chart_set_decimation(chart, decim);
+        refresh_screen();
+
+        clock_t t_start = clock();
+        for(i = 0; i < rounds; i++) {
+            refresh_screen();
+        }
+        t_full[decim] = clock() - t_start;
+
+        /*Append a value and redraw what has changed*/
+        t_start = clock();
+        for(i = 0; i < rounds * 10; i++) {
+            lv_chart_set_next_value(chart, ser, history_value(i));
+            lv_refr_now(NULL);
+        }
+        t_append[decim] = clock() - t_start;
+    }
+
+    TEST_PRINTF("chart %d points full redraw: %d us all points, %d us decimated", POINT_CNT,
+                (int)(t_full[0] * 1000000 / CLOCKS_PER_SEC / rounds),
+                (int)(t_full[1] * 1000000 / CLOCKS_PER_SEC / rounds));
+    TEST_PRINTF("chart %d points append: %d us all points, %d us decimated", POINT_CNT,
+                (int)(t_append[0] * 1000000 / CLOCKS_PER_SEC / rounds / 10),
+                (int)(t_append[1] * 1000000 / CLOCKS_PER_SEC / rounds / 10));
+}
+
+#endif
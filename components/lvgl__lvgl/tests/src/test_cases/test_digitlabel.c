@@ -0,0 +1,136 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../../src/misc/lv_gc.h"
+
+static lv_obj_t * dlabel;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    dlabel = lv_digitlabel_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_digitlabel_set_text(void)
+{
+    lv_digitlabel_set_text(dlabel, "12:34");
+    TEST_ASSERT_EQUAL_STRING("12:34", lv_digitlabel_get_text(dlabel));
+
+    lv_digitlabel_set_text_fmt(dlabel, "%d.%d°C", 21, 5);
+    TEST_ASSERT_EQUAL_STRING("21.5°C", lv_digitlabel_get_text(dlabel));
+}
+
+void test_digitlabel_digits_have_the_same_width(void)
+{
+    lv_digitlabel_set_text(dlabel, "11");
+    lv_obj_update_layout(dlabel);
+    lv_coord_t w1 = lv_obj_get_width(dlabel);
+
+    lv_digitlabel_set_text(dlabel, "88");
+    lv_obj_update_layout(dlabel);
+    TEST_ASSERT_EQUAL(w1, lv_obj_get_width(dlabel));
+    TEST_ASSERT_EQUAL(lv_font_get_line_height(LV_FONT_DEFAULT), lv_obj_get_height(dlabel));
+}
+
+void test_digitlabel_invalidate_only_changed_digit(void)
+{
+    /*The width of a digit cell*/
+    lv_digitlabel_set_text(dlabel, "0");
+    lv_obj_update_layout(dlabel);
+    lv_coord_t cell_w = lv_obj_get_width(dlabel);
+
+    lv_digitlabel_set_text(dlabel, "12:34:56");
+    lv_obj_update_layout(dlabel);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    lv_digitlabel_set_text(dlabel, "12:34:57");
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    /*Only the last digit's cell (plus the few pixels LVGL adds around transformed areas)*/
+    TEST_ASSERT_GREATER_THAN(dlabel->coords.x2 - 2 * cell_w, disp->inv_areas[0].x1);
+    TEST_ASSERT_GREATER_OR_EQUAL(dlabel->coords.x2, disp->inv_areas[0].x2);
+}
+
+void test_digitlabel_draw(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "0123456789");
+    lv_obj_set_pos(label, 10, 10);
+
+    lv_digitlabel_set_text(dlabel, "0123456789");
+    lv_obj_set_pos(dlabel, 10, 40);
+    lv_obj_update_layout(dlabel);
+
+    /*The atlas is shared and released with the last user*/
+    lv_obj_t * dlabel2 = lv_digitlabel_create(lv_scr_act());
+    lv_digitlabel_set_text(dlabel2, "-12.5°C");
+    lv_obj_set_pos(dlabel2, 10, 70);
+    lv_refr_now(NULL);
+    lv_obj_del(dlabel2);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_STRING("0123456789", lv_digitlabel_get_text(dlabel));
+}
+
+void test_digitlabel_invalidate_font(void)
+{
+    lv_digitlabel_set_text(dlabel, "12:34");
+    lv_refr_now(NULL);
+    struct _lv_digitlabel_atlas_t * atlas = ((lv_digitlabel_t *)dlabel)->atlas;
+    TEST_ASSERT_NOT_NULL(atlas);
+    TEST_ASSERT_EQUAL_PTR(atlas, LV_GC_ROOT(_lv_digitlabel_atlas_head));
+
+    /*The old atlas is not shared anymore, even while a digit label still uses it*/
+    lv_digitlabel_invalidate_font(LV_FONT_DEFAULT);
+    TEST_ASSERT_NULL(LV_GC_ROOT(_lv_digitlabel_atlas_head));
+    lv_obj_t * dlabel2 = lv_digitlabel_create(lv_scr_act());
+    lv_digitlabel_set_text(dlabel2, "56:78");
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_EQUAL(atlas, ((lv_digitlabel_t *)dlabel2)->atlas);
+
+    /*Both digit labels use the new atlas after the next redraw*/
+    lv_obj_invalidate(dlabel);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_PTR(((lv_digitlabel_t *)dlabel2)->atlas, ((lv_digitlabel_t *)dlabel)->atlas);
+    TEST_ASSERT_EQUAL_PTR(((lv_digitlabel_t *)dlabel)->atlas, LV_GC_ROOT(_lv_digitlabel_atlas_head));
+}
+
+void test_digitlabel_tiny_ttf_resized_and_destroyed(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 20);
+    lv_obj_set_style_text_font(dlabel, font, 0);
+    lv_digitlabel_set_text(dlabel, "12:34");
+    lv_obj_update_layout(dlabel);
+    lv_refr_now(NULL);
+    lv_coord_t h = lv_obj_get_height(dlabel);
+
+    /*The glyphs rendered with the old size are not used*/
+    lv_tiny_ttf_set_size(font, 40);
+    lv_obj_refresh_self_size(dlabel);
+    lv_obj_update_layout(dlabel);
+    TEST_ASSERT_GREATER_THAN(h, lv_obj_get_height(dlabel));
+    TEST_ASSERT_EQUAL(font->line_height, lv_obj_get_height(dlabel));
+    lv_refr_now(NULL);
+
+    lv_obj_set_style_text_font(dlabel, LV_FONT_DEFAULT, 0);
+    lv_refr_now(NULL);
+    lv_tiny_ttf_destroy(font);
+    TEST_ASSERT_EQUAL_PTR(((lv_digitlabel_t *)dlabel)->atlas, LV_GC_ROOT(_lv_digitlabel_atlas_head));
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include <string.h>
+#include <time.h>
+
+#define FB_PX           (800 * 480)
+#define CACHE_SIZE      (32 * 1024)
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[FB_PX];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_draw_cache_set_size(CACHE_SIZE);
+    lv_draw_cache_flush();
+    lv_draw_cache_reset_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_draw_cache_set_size(LV_DRAW_CACHE_SIZE);
+}
+
+/*Cards with a gradient and rounded corners like a themed dashboard.
+ *Every card has an other gradient and there are more radiuses than the old 4 element circle cache had*/
+static void create_cards(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 20 + (i % 6) * 130, 20 + (i / 6) * 110);
+        lv_obj_set_size(obj, 110, 90);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(0x102030 + i * 0x0a0400), 0);
+        lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x2060a0 + i * 0x000c08), 0);
+        lv_obj_set_style_bg_grad_dir(obj, i % 2 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR, 0);
+        lv_obj_set_style_radius(obj, 4 + i * 2, 0);
+        lv_obj_set_style_border_width(obj, 2, 0);
+        lv_obj_set_style_border_color(obj, lv_color_white(), 0);
+    }
+}
+
+static void refresh_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_draw_cache_render_the_same(void)
+{
+    create_cards(18);
+
+    lv_draw_cache_set_size(0);
+    refresh_screen();
+    memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.entry_cnt);
+    TEST_ASSERT_EQUAL(0, mon.used_size);
+
+    lv_draw_cache_set_size(CACHE_SIZE);
+    refresh_screen();
+    refresh_screen();
+
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.hit_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+void test_draw_cache_steady_state_no_miss(void)
+{
+    create_cards(18);
+    refresh_screen();
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(18, mon.entry_cnt);
+
+    /*Nothing is calculated again when the same screen is redrawn*/
+    lv_draw_cache_reset_stat();
+    refresh_screen();
+    refresh_screen();
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.miss_cnt);
+    TEST_ASSERT_EQUAL(0, mon.evict_cnt);
+    TEST_ASSERT_GREATER_THAN(0, mon.hit_cnt);
+}
+
+void test_draw_cache_size_limit(void)
+{
+    lv_draw_cache_set_size(1024);
+    create_cards(18);
+    refresh_screen();
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(1024, mon.total_size);
+    TEST_ASSERT_LESS_OR_EQUAL(mon.total_size, mon.used_size);
+    TEST_ASSERT_GREATER_THAN(0, mon.evict_cnt);
+    TEST_ASSERT_GREATER_THAN(0, mon.entry_cnt);
+
+    /*Shrinking drops the least recently used entries*/
+    lv_draw_cache_set_size(256);
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_LESS_OR_EQUAL(256, mon.used_size);
+}
+
+void test_draw_cache_heap_usage_constant(void)
+{
+    lv_draw_cache_set_size(1024);
+    create_cards(6);
+    refresh_screen();
+
+    /*Other gradients and radiuses replace the cached ones, the ones which don't fit are freed after drawing*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_clean(lv_scr_act());
+        create_cards(6 + i * 4);
+        uint32_t mem_before = lv_test_get_free_mem();
+        refresh_screen();
+        TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+    }
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(1024, mon.used_size);
+}
+
+void test_draw_cache_flush(void)
+{
+    create_cards(6);
+    refresh_screen();
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.entry_cnt);
+
+    lv_gradient_free_cache();
+    lv_draw_cache_monitor_t mon_no_grad;
+    lv_draw_cache_monitor(&mon_no_grad);
+    TEST_ASSERT_LESS_THAN(mon.entry_cnt, mon_no_grad.entry_cnt);
+
+    lv_draw_cache_flush();
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.entry_cnt);
+    TEST_ASSERT_EQUAL(0, mon.used_size);
+
+    /*Setting a theme drops the resources of the old theme too*/
+    refresh_screen();
+    lv_disp_set_theme(NULL, lv_disp_get_theme(NULL));
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.entry_cnt);
+}
+
+void test_draw_cache_benchmark(void)
+{
+    create_cards(24);
+
+    const uint32_t rounds = 20;
+    lv_draw_cache_set_size(0);
+    refresh_screen();
+    clock_t t_start = clock();
+    uint32_t i;
+    for(i = 0; i < rounds; i++) {
+        refresh_screen();
+    }
+    clock_t t_nocache = clock() - t_start;
+
+    lv_draw_cache_set_size(CACHE_SIZE);
+    refresh_screen();
+    lv_draw_cache_reset_stat();
+    t_start = clock();
+    for(i = 0; i < rounds; i++) {
+        refresh_screen();
+    }
+    clock_t t_cache = clock() - t_start;
+
+    lv_draw_cache_monitor_t mon;
+    lv_draw_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.miss_cnt);
+    TEST_PRINTF("draw cache: %d us per refresh without cache, %d us with %d bytes cache (%d entries, %d bytes used)",
+                (int)(t_nocache * 1000000 / CLOCKS_PER_SEC / rounds), (int)(t_cache * 1000000 / CLOCKS_PER_SEC / rounds),
+                (int)mon.total_size, (int)mon.entry_cnt, (int)mon.used_size);
+}
+
+#endif
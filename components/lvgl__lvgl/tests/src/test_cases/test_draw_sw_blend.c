@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw_blend_rgb565.h"
+
+#include "unity/unity.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define TEST_W  123
+#define TEST_H  17
+#define BENCH_W 800
+#define BENCH_H 48
+
+static uint16_t dest_ref[BENCH_W * BENCH_H];
+static uint16_t dest_test[BENCH_W * BENCH_H];
+static uint16_t src[BENCH_W * BENCH_H];
+static lv_opa_t mask[BENCH_W * BENCH_H];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    srand(1234);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/*The scalar RGB565 blending of `lv_draw_sw_blend_basic` (`lv_color_mix` with LV_COLOR_MIX_ROUND_OFS 0)*/
+static uint16_t ref_mix(uint16_t c1, uint16_t c2, uint32_t mix)
+{
+    mix = (mix + 4) >> 3;
+    uint32_t bg = ((uint32_t)c2 | ((uint32_t)c2 << 16)) & 0x7E0F81F;
+    uint32_t fg = ((uint32_t)c1 | ((uint32_t)c1 << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+    return (uint16_t)((result >> 16) | result);
+}
+
+static void ref_fill(uint16_t * dest, int32_t w, int32_t h, uint16_t color, lv_opa_t opa, const lv_opa_t * m)
+{
+    int32_t i;
+    for(i = 0; i < w * h; i++) {
+        if(m == NULL) {
+            /*Pre-multiplied*/
+            uint32_t o = LV_MIN(((opa + 4) >> 3) << 3, LV_OPA_COVER);
+            uint32_t o_inv = 255 - o;
+            uint32_t r = LV_UDIV255((color >> 11) * o + (dest[i] >> 11) * o_inv);
+            uint32_t g = LV_UDIV255(((color >> 5) & 0x3F) * o + ((dest[i] >> 5) & 0x3F) * o_inv);
+            uint32_t b = LV_UDIV255((color & 0x1F) * o + (dest[i] & 0x1F) * o_inv);
+            dest[i] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+        else if(m[i] == 0) continue;
+        else if(opa >= LV_OPA_MAX) dest[i] = m[i] == LV_OPA_COVER ? color : ref_mix(color, dest[i], m[i]);
+        else dest[i] = ref_mix(color, dest[i], m[i] == LV_OPA_COVER ? opa : (m[i] * opa) >> 8);
+    }
+}
+
+static void ref_map(uint16_t * dest, const uint16_t * s, int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * m)
+{
+    int32_t i;
+    for(i = 0; i < w * h; i++) {
+        if(m == NULL) dest[i] = ref_mix(s[i], dest[i], opa);
+        else if(m[i] == 0) continue;
+        else if(opa > LV_OPA_MAX) dest[i] = m[i] == LV_OPA_COVER ? s[i] : ref_mix(s[i], dest[i], m[i]);
+        else dest[i] = ref_mix(s[i], dest[i], m[i] >= LV_OPA_MAX ? opa : (opa * m[i]) >> 8);
+    }
+}
+
+static void fill_random(int32_t cnt)
+{
+    int32_t i;
+    for(i = 0; i < cnt; i++) {
+        dest_ref[i] = (uint16_t)rand();
+        dest_test[i] = dest_ref[i];
+        src[i] = (uint16_t)rand();
+        /*Typical anti-aliased masks: mostly transparent or covering*/
+        int r = rand() % 4;
+        mask[i] = r == 0 ? LV_OPA_TRANSP : r == 1 ? LV_OPA_COVER : (lv_opa_t)rand();
+    }
+}
+
+/*Offsets in pixels to test every alignment of the destination and source*/
+static void check_kernels_exact(const lv_draw_sw_blend_rgb565_kernels_t * k, int32_t dest_ofs, int32_t src_ofs)
+{
+    static const lv_opa_t opas[] = {0, 1, 7, 100, 128, 200, 252, 253, 254, 255};
+    uint16_t * d_ref = dest_ref + dest_ofs;
+    uint16_t * d_test = dest_test + dest_ofs;
+    uint16_t * s = src + src_ofs;
+    const int32_t cnt = TEST_W * TEST_H + 2;
+    uint32_t i;
+    for(i = 0; i < sizeof(opas); i++) {
+        lv_opa_t opa = opas[i];
+        uint16_t color = (uint16_t)rand();
+
+        /*Mask starting on an unaligned address to test the head and tail pixels too*/
+        fill_random(cnt);
+        ref_fill(d_ref, TEST_W, TEST_H, color, opa, mask + 1);
+        k->fill(d_test, TEST_W, TEST_W, TEST_H, color, opa, mask + 1, TEST_W);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+
+        fill_random(cnt);
+        ref_map(d_ref, s, TEST_W, TEST_H, opa, mask + 1);
+        k->map(d_test, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, mask + 1, TEST_W);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+
+        if(opa >= LV_OPA_MAX) continue;
+
+        /*Without mask: both the small and the look up table version*/
+        fill_random(cnt);
+        ref_fill(d_ref, TEST_W, TEST_H, color, opa, NULL);
+        k->fill(d_test, TEST_W, TEST_W, TEST_H, color, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+
+        fill_random(cnt);
+        ref_fill(d_ref, 5, 1, color, opa, NULL);
+        k->fill(d_test, 5, 5, 1, color, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+
+        fill_random(cnt);
+        ref_map(d_ref, s, TEST_W, TEST_H, opa, NULL);
+        k->map(d_test, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+    }
+}
+
+void test_draw_sw_blend_rgb565_kernels_are_exact(void)
+{
+    check_kernels_exact(lv_draw_sw_blend_rgb565_get_c_kernels(), 0, 0);
+}
+
+void test_draw_sw_blend_rgb565_packed_kernels_are_exact(void)
+{
+    const lv_draw_sw_blend_rgb565_kernels_t * k = lv_draw_sw_blend_rgb565_get_packed_kernels();
+    check_kernels_exact(k, 0, 0);
+    check_kernels_exact(k, 1, 1);
+    check_kernels_exact(k, 0, 1);
+    check_kernels_exact(k, 1, 0);
+}
+
+/*Blend the typical cases with the scalar reference and a kernel set. Return the time of the kernels in us.*/
+static int32_t benchmark_kernels(const lv_draw_sw_blend_rgb565_kernels_t * k, int32_t * t_ref_us)
+{
+    const int32_t rounds = 10;
+    const int32_t cnt = BENCH_W * BENCH_H;
+    int32_t r;
+
+    fill_random(cnt);
+    clock_t t_start = clock();
+    for(r = 0; r < rounds; r++) {
+        ref_fill(dest_ref, BENCH_W, BENCH_H, 0x1234, LV_OPA_50, NULL);
+        ref_fill(dest_ref, BENCH_W, BENCH_H, 0x1234, LV_OPA_COVER, mask);
+        ref_map(dest_ref, src, BENCH_W, BENCH_H, LV_OPA_50, NULL);
+        ref_map(dest_ref, src, BENCH_W, BENCH_H, LV_OPA_70, mask);
+    }
+    clock_t t_ref = clock() - t_start;
+
+    t_start = clock();
+    for(r = 0; r < rounds; r++) {
+        k->fill(dest_test, BENCH_W, BENCH_W, BENCH_H, 0x1234, LV_OPA_50, NULL, 0);
+        k->fill(dest_test, BENCH_W, BENCH_W, BENCH_H, 0x1234, LV_OPA_COVER, mask, BENCH_W);
+        k->map(dest_test, BENCH_W, src, BENCH_W, BENCH_W, BENCH_H, LV_OPA_50, NULL, 0);
+        k->map(dest_test, BENCH_W, src, BENCH_W, BENCH_W, BENCH_H, LV_OPA_70, mask, BENCH_W);
+    }
+    clock_t t_kernel = clock() - t_start;
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, cnt);
+    *t_ref_us = (int32_t)(t_ref * 1000000 / CLOCKS_PER_SEC);
+    return (int32_t)(t_kernel * 1000000 / CLOCKS_PER_SEC);
+}
+
+void test_draw_sw_blend_rgb565_kernels_benchmark(void)
+{
+    int32_t t_ref;
+    int32_t t_c = benchmark_kernels(lv_draw_sw_blend_rgb565_get_c_kernels(), &t_ref);
+    int32_t t_packed = benchmark_kernels(lv_draw_sw_blend_rgb565_get_packed_kernels(), &t_ref);
+    TEST_PRINTF("RGB565 blend of %d px: scalar %d us, C kernels %d us, packed kernels %d us",
+                (int)(4 * 10 * BENCH_W * BENCH_H), (int)t_ref, (int)t_c, (int)t_packed);
+}
+
+void test_draw_sw_blend_rgb565_set_kernels(void)
+{
+    static lv_draw_sw_blend_rgb565_kernels_t custom;
+    custom = *lv_draw_sw_blend_rgb565_get_c_kernels();
+
+    lv_draw_sw_blend_rgb565_set_kernels(&custom);
+    TEST_ASSERT_EQUAL_PTR(&custom, lv_draw_sw_blend_rgb565_get_kernels());
+
+    lv_draw_sw_blend_rgb565_set_kernels(NULL);
+    TEST_ASSERT_EQUAL_PTR(lv_draw_sw_blend_rgb565_get_c_kernels(), lv_draw_sw_blend_rgb565_get_kernels());
+}
+
+#endif
@@ -0,0 +1,184 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#define WORKER_CNT  3
+#define FB_PX       (800 * 480)
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+typedef struct {
+    pthread_t thread;
+    pthread_cond_t cond;
+    void (*job_cb)(void * param);
+    void * param;
+} worker_t;
+
+static worker_t worker_pool[WORKER_CNT];
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_done_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t pool_pending;
+static uint32_t pool_dispatch_cnt;
+static bool pool_quit;
+
+static lv_color_t fb_ref[FB_PX];
+
+static void * worker_thread(void * arg)
+{
+    worker_t * w = arg;
+    pthread_mutex_lock(&pool_mutex);
+    while(1) {
+        while(w->job_cb == NULL && !pool_quit) pthread_cond_wait(&w->cond, &pool_mutex);
+        if(pool_quit) break;
+
+        void (*job_cb)(void * param) = w->job_cb;
+        pthread_mutex_unlock(&pool_mutex);
+        job_cb(w->param);
+        pthread_mutex_lock(&pool_mutex);
+
+        w->job_cb = NULL;
+        pool_pending--;
+        if(pool_pending == 0) pthread_cond_signal(&pool_done_cond);
+    }
+    pthread_mutex_unlock(&pool_mutex);
+    return NULL;
+}
+
+static void pool_dispatch(uint32_t worker_id, void (*job_cb)(void * param), void * param)
+{
+    worker_t * w = &worker_pool[worker_id];
+    pthread_mutex_lock(&pool_mutex);
+    w->param = param;
+    w->job_cb = job_cb;
+    pool_pending++;
+    pool_dispatch_cnt++;
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+static void pool_join(void)
+{
+    pthread_mutex_lock(&pool_mutex);
+    while(pool_pending) pthread_cond_wait(&pool_done_cond, &pool_mutex);
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+static const lv_draw_sw_blend_workers_t pool_workers = {
+    .worker_cnt = WORKER_CNT,
+    .min_px = 4096,
+    .dispatch_cb = pool_dispatch,
+    .join_cb = pool_join,
+};
+
+void setUp(void)
+{
+    /* Function run before every test */
+    uint32_t i;
+    pool_quit = false;
+    for(i = 0; i < WORKER_CNT; i++) {
+        pthread_cond_init(&worker_pool[i].cond, NULL);
+        worker_pool[i].job_cb = NULL;
+        pthread_create(&worker_pool[i].thread, NULL, worker_thread, &worker_pool[i]);
+    }
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_draw_sw_blend_set_workers(NULL);
+    lv_obj_clean(lv_scr_act());
+
+    uint32_t i;
+    pthread_mutex_lock(&pool_mutex);
+    pool_quit = true;
+    for(i = 0; i < WORKER_CNT; i++) pthread_cond_signal(&worker_pool[i].cond);
+    pthread_mutex_unlock(&pool_mutex);
+
+    for(i = 0; i < WORKER_CNT; i++) {
+        pthread_join(worker_pool[i].thread, NULL);
+        pthread_cond_destroy(&worker_pool[i].cond);
+    }
+}
+
+static void create_scene(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_BLUE_GREY), 0);
+
+    /*Large semi transparent and masked areas which are worth splitting*/
+    static const lv_palette_t palettes[] = {LV_PALETTE_RED, LV_PALETTE_GREEN, LV_PALETTE_ORANGE, LV_PALETTE_CYAN};
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 40 + i * 60, 20 + i * 40);
+        lv_obj_set_size(obj, 500, 300);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_50 + i * 30, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(palettes[i]), 0);
+        lv_obj_set_style_radius(obj, i * 40, 0);
+        lv_obj_set_style_border_width(obj, 10, 0);
+        lv_obj_set_style_border_opa(obj, LV_OPA_70, 0);
+        if(i == 3) lv_obj_set_style_blend_mode(obj, LV_BLEND_MODE_ADDITIVE, 0);
+    }
+
+    lv_obj_t * label = lv_label_create(scr);
+    lv_label_set_text(label, "Stripes");
+    lv_obj_center(label);
+}
+
+static uint32_t refresh_screen_us(uint32_t rounds)
+{
+    struct timespec t_start;
+    struct timespec t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    uint32_t i;
+    for(i = 0; i < rounds; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    return (uint32_t)((t_end.tv_sec - t_start.tv_sec) * 1000000 + (t_end.tv_nsec - t_start.tv_nsec) / 1000);
+}
+
+void test_draw_sw_blend_workers_render_the_same(void)
+{
+    create_scene();
+
+    lv_draw_sw_blend_set_workers(NULL);
+    refresh_screen_us(1);
+    memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_blend_set_workers(&pool_workers);
+    memset(test_fb, 0, sizeof(fb_ref));
+    pool_dispatch_cnt = 0;
+    refresh_screen_us(1);
+
+    TEST_ASSERT_GREATER_THAN(0, pool_dispatch_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+void test_draw_sw_blend_workers_benchmark(void)
+{
+    const uint32_t rounds = 10;
+    create_scene();
+
+    lv_draw_sw_blend_set_workers(NULL);
+    uint32_t t_single = refresh_screen_us(rounds);
+
+    lv_draw_sw_blend_set_workers(&pool_workers);
+    uint32_t t_workers = refresh_screen_us(rounds);
+
+    TEST_PRINTF("%d full screen refreshes: 1 thread %d us, %d threads %d us", (int)rounds, (int)t_single,
+                WORKER_CNT + 1, (int)t_workers);
+}
+
+#endif
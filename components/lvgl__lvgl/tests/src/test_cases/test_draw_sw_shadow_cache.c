@@ -0,0 +1,158 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+#include <time.h>
+
+#define FB_PX       (800 * 480)
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_set_buf(NULL, LV_SHADOW_CACHE_MEM_SIZE);
+#endif
+    lv_draw_sw_shadow_cache_reset_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[FB_PX];
+
+static void create_cards(uint32_t cnt, lv_coord_t shadow_width)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 30 + (i % 4) * 190, 30 + (i / 4) * 150);
+        lv_obj_set_size(obj, 120 + i * 3, 90);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+        lv_obj_set_style_radius(obj, 4 + (i % 3) * 6, 0);
+        lv_obj_set_style_shadow_width(obj, shadow_width + (i % 2) * 10, 0);
+        lv_obj_set_style_shadow_spread(obj, 2, 0);
+        lv_obj_set_style_shadow_ofs_y(obj, 4, 0);
+        lv_obj_set_style_shadow_opa(obj, LV_OPA_60, 0);
+    }
+}
+
+static void refresh_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void test_draw_sw_shadow_cache_render_the_same(void)
+{
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    create_cards(12, 20);
+
+    lv_draw_sw_shadow_cache_set_buf(NULL, 0);
+    refresh_screen();
+    memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_shadow_cache_set_buf(NULL, LV_SHADOW_CACHE_MEM_SIZE);
+    refresh_screen();
+    refresh_screen();
+
+    lv_draw_sw_shadow_cache_monitor_t mon;
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.hit_cnt);
+    TEST_ASSERT_GREATER_THAN(0, mon.entry_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+#endif
+}
+
+void test_draw_sw_shadow_cache_drops_least_recently_used(void)
+{
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    /*Room for only a few corners of 20 + 10 + 4..16 px*/
+    static uint32_t cache_buf[1024];
+    lv_draw_sw_shadow_cache_set_buf(cache_buf, sizeof(cache_buf));
+    create_cards(12, 20);
+    refresh_screen();
+
+    lv_draw_sw_shadow_cache_monitor_t mon;
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(sizeof(cache_buf), mon.total_size);
+    TEST_ASSERT_LESS_OR_EQUAL(mon.total_size, mon.used_size);
+    TEST_ASSERT_GREATER_THAN(0, mon.entry_cnt);
+    TEST_ASSERT_LESS_THAN(6, mon.entry_cnt);
+
+    /*The most recently used shadow is still there*/
+    uint32_t miss_cnt = mon.miss_cnt;
+    lv_obj_t * last = lv_obj_get_child(lv_scr_act(), -1);
+    lv_obj_invalidate(last);
+    lv_refr_now(NULL);
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_EQUAL(miss_cnt, mon.miss_cnt);
+
+    lv_obj_clean(lv_scr_act());
+    lv_draw_sw_shadow_cache_set_buf(NULL, LV_SHADOW_CACHE_MEM_SIZE);
+#endif
+}
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE && LV_USE_DEMO_BENCHMARK
+/*Run the shadow scenes of the benchmark demo and return the time spent with them*/
+static uint32_t benchmark_shadow_scenes_us(void)
+{
+    /*"Shadow small", "Shadow small offset", "Shadow large", "Shadow large offset", each with and without opa*/
+    const int_fast16_t scene_first = 22;
+    const int_fast16_t scene_last = 29;
+    lv_disp_t * disp = lv_disp_get_default();
+
+    clock_t t_sum = 0;
+    int_fast16_t s;
+    for(s = scene_first; s <= scene_last; s++) {
+        lv_demo_benchmark_run_scene(s);
+        clock_t t_start = clock();
+        /*Simulate the 1 second of the scene*/
+        uint32_t i;
+        for(i = 0; i < 50; i++) {
+            lv_tick_inc(20);
+            lv_timer_handler();
+        }
+        t_sum += clock() - t_start;
+        lv_demo_benchmark_close();
+    }
+    disp->driver->monitor_cb = NULL;
+
+    return (uint32_t)(t_sum * 1000000 / CLOCKS_PER_SEC);
+}
+#endif
+
+void test_draw_sw_shadow_cache_benchmark(void)
+{
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE && LV_USE_DEMO_BENCHMARK
+    lv_draw_sw_shadow_cache_set_buf(NULL, 0);
+    uint32_t t_nocache = benchmark_shadow_scenes_us();
+
+    lv_draw_sw_shadow_cache_set_buf(NULL, LV_SHADOW_CACHE_MEM_SIZE);
+    lv_draw_sw_shadow_cache_reset_stat();
+    uint32_t t_cache = benchmark_shadow_scenes_us();
+
+    lv_draw_sw_shadow_cache_monitor_t mon;
+    lv_draw_sw_shadow_cache_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(mon.miss_cnt, mon.hit_cnt);
+    TEST_PRINTF("benchmark shadow scenes: %d us without cache, %d us with %d bytes cache (%d hits, %d misses, %d entries)",
+                (int)t_nocache, (int)t_cache, (int)mon.total_size, (int)mon.hit_cnt, (int)mon.miss_cnt, (int)mon.entry_cnt);
+#endif
+}
+
+#endif
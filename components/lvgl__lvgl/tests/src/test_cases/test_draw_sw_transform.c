@@ -0,0 +1,286 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+#include <time.h>
+
+#define FB_PX           (800 * 480)
+#define IMG_W           40
+#define IMG_H           28
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+#if LV_DRAW_COMPLEX
+    static lv_color_t fb_ref[FB_PX];
+#endif
+
+static uint8_t img_argb_map[IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_color_t img_rgb_map[IMG_W * IMG_H];
+static lv_color_t img_ckey_map[IMG_W * IMG_H];
+static lv_img_dsc_t img_argb;
+static lv_img_dsc_t img_rgb;
+static lv_img_dsc_t img_ckey;
+
+#if LV_COLOR_DEPTH == 16
+static uint8_t img_rgb565a8_map[IMG_W * IMG_H * 3];
+static lv_img_dsc_t img_rgb565a8;
+#endif
+
+static void img_dsc_init(lv_img_dsc_t * dsc, lv_img_cf_t cf, const void * data, uint32_t data_size)
+{
+    lv_memset_00(dsc, sizeof(lv_img_dsc_t));
+    dsc->header.cf = cf;
+    dsc->header.w = IMG_W;
+    dsc->header.h = IMG_H;
+    dsc->data = data;
+    dsc->data_size = data_size;
+}
+
+/*An icon-like pattern with different colors in every row and column and a soft, uneven alpha*/
+static void imgs_init(void)
+{
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            uint32_t i = y * IMG_W + x;
+            lv_color_t c = lv_color_make(x * 6, y * 9, (x * y) & 0xff);
+            lv_opa_t a = (x + y) % 5 == 0 ? LV_OPA_TRANSP : 255 - x * 3 - y;
+
+            uint8_t * px = &img_argb_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            lv_memcpy(px, &c, sizeof(lv_color_t));
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+
+            img_rgb_map[i] = c;
+            img_ckey_map[i] = (x + y) % 7 == 0 ? LV_COLOR_CHROMA_KEY : c;
+
+#if LV_COLOR_DEPTH == 16
+            ((lv_color_t *)img_rgb565a8_map)[i] = c;
+            img_rgb565a8_map[IMG_W * IMG_H * sizeof(lv_color_t) + i] = a;
+#endif
+        }
+    }
+
+    img_dsc_init(&img_argb, LV_IMG_CF_TRUE_COLOR_ALPHA, img_argb_map, sizeof(img_argb_map));
+    img_dsc_init(&img_rgb, LV_IMG_CF_TRUE_COLOR, img_rgb_map, sizeof(img_rgb_map));
+    img_dsc_init(&img_ckey, LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED, img_ckey_map, sizeof(img_ckey_map));
+#if LV_COLOR_DEPTH == 16
+    img_dsc_init(&img_rgb565a8, LV_IMG_CF_RGB565A8, img_rgb565a8_map, sizeof(img_rgb565a8_map));
+#endif
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    imgs_init();
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x464653), 0);
+#if LV_DRAW_COMPLEX
+    lv_draw_sw_transform_set_fast_paths(true);
+    lv_draw_sw_transform_reset_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+#if LV_DRAW_COMPLEX
+    lv_draw_sw_transform_set_fast_paths(true);
+#endif
+}
+
+#if LV_DRAW_COMPLEX
+
+static lv_obj_t * img_create(const lv_img_dsc_t * src, lv_coord_t x, lv_coord_t y, int16_t angle, uint16_t zoom,
+                             bool aa)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, x, y);
+    lv_img_set_angle(img, angle);
+    lv_img_set_zoom(img, zoom);
+    lv_img_set_antialias(img, aa);
+    return img;
+}
+
+/*A row of images with all kinds of transformations for every color format*/
+static void imgs_create(void)
+{
+    static const struct {
+        int16_t angle;
+        uint16_t zoom;
+    } transforms[] = {
+        {900, 256}, {1800, 256}, {2700, 256},       /*Right angles*/
+        {0, 128}, {0, 64}, {900, 128}, {1800, 64},  /*Integer downscale, also rotated*/
+        {0, 512}, {0, 768}, {0, 200}, {0, 300},     /*Integer and fractional zoom*/
+        {450, 256}, {1800, 512},                    /*Not applicable: generic path*/
+    };
+
+    const lv_img_dsc_t * srcs[] = {
+        &img_argb, &img_rgb, &img_ckey,
+#if LV_COLOR_DEPTH == 16
+        &img_rgb565a8,
+#endif
+    };
+
+    uint32_t s;
+    uint32_t t;
+    uint32_t aa;
+    for(s = 0; s < sizeof(srcs) / sizeof(srcs[0]); s++) {
+        for(aa = 0; aa < 2; aa++) {
+            lv_coord_t y = 20 + (s * 2 + aa) * 60;
+            for(t = 0; t < sizeof(transforms) / sizeof(transforms[0]); t++) {
+                /*The first image is partially out of the screen*/
+                lv_coord_t x = t == 0 ? -15 : 10 + (lv_coord_t)t * 62;
+                img_create(srcs[s], x, y, transforms[t].angle, transforms[t].zoom, aa);
+            }
+
+            /*Upscaled and clipped on the left*/
+            img_create(srcs[s], -30, y + 10, 0, 512, aa);
+        }
+    }
+}
+
+static void refresh_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#endif
+
+void test_draw_sw_transform_fast_paths_render_the_same(void)
+{
+#if LV_DRAW_COMPLEX
+    imgs_create();
+
+    lv_draw_sw_transform_set_fast_paths(false);
+    refresh_screen();
+    memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_transform_stat_t stat;
+    lv_draw_sw_transform_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN(0, stat.generic_cnt);
+    TEST_ASSERT_EQUAL(0, stat.exact_cnt + stat.lut_cnt + stat.repeat_cnt + stat.zoom_aa_cnt);
+
+    lv_draw_sw_transform_reset_stat();
+    lv_draw_sw_transform_set_fast_paths(true);
+    refresh_screen();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_transform_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN(0, stat.generic_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.exact_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.lut_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.repeat_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.zoom_aa_cnt);
+#endif
+}
+
+void test_draw_sw_transform_right_angle_keeps_size(void)
+{
+#if LV_DRAW_COMPLEX
+    /*An opaque image rotated by 270 degree covers exactly the rotated area*/
+    lv_obj_t * img = img_create(&img_rgb, 100, 100, 2700, 256, false);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_black(), 0);
+    refresh_screen();
+
+    lv_area_t a;
+    lv_obj_get_coords(img, &a);
+    lv_coord_t cx = (a.x1 + a.x2 + 1) / 2;
+    lv_coord_t cy = (a.y1 + a.y2 + 1) / 2;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    uint32_t px_cnt = 0;
+    for(y = cy - IMG_W; y < cy + IMG_W; y++) {
+        for(x = cx - IMG_W; x < cx + IMG_W; x++) {
+            if(lv_color_to32(test_fb[y * 800 + x]) != lv_color_to32(lv_color_black())) px_cnt++;
+        }
+    }
+
+    /*A few pixels of the image are black*/
+    TEST_ASSERT_UINT32_WITHIN(IMG_W, IMG_W * IMG_H, px_cnt);
+
+    lv_draw_sw_transform_stat_t stat;
+    lv_draw_sw_transform_get_stat(&stat);
+    TEST_ASSERT_EQUAL(0, stat.generic_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.exact_cnt);
+#endif
+}
+
+void test_draw_sw_transform_benchmark(void)
+{
+#if LV_DRAW_COMPLEX
+    /*Like the rotated and zoomed `img_*` scenes of the benchmark demo*/
+    static const struct {
+        const char * name;
+        const lv_img_dsc_t * src;
+        int16_t angle;
+        uint16_t zoom;
+    } scenes[] = {
+        {"img_argb rotate 90", &img_argb, 900, 256},
+        {"img_rgb rotate 180", &img_rgb, 1800, 256},
+        {"img_argb zoom 2x", &img_argb, 0, 512},
+        {"img_rgb zoom 0.5x", &img_rgb, 0, 128},
+        {"img_argb zoom 1.5x", &img_argb, 0, 384},
+    };
+
+    /*Time only the transformation as the blending of the images is the same with both*/
+    static lv_color_t cbuf[2][IMG_W * IMG_H * 6];
+    static lv_opa_t abuf[2][IMG_W * IMG_H * 6];
+    const uint32_t rounds = 200;
+
+    _lv_refr_set_disp_refreshing(lv_disp_get_default());
+
+    uint32_t s;
+    for(s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        uint32_t aa;
+        for(aa = 0; aa < 2; aa++) {
+            lv_draw_img_dsc_t dsc;
+            lv_draw_img_dsc_init(&dsc);
+            dsc.angle = scenes[s].angle;
+            dsc.zoom = scenes[s].zoom;
+            dsc.pivot.x = IMG_W / 2;
+            dsc.pivot.y = IMG_H / 2;
+            dsc.antialias = aa;
+
+            lv_area_t area;
+            _lv_img_buf_get_transformed_area(&area, IMG_W, IMG_H, dsc.angle, dsc.zoom, &dsc.pivot);
+            TEST_ASSERT_LESS_OR_EQUAL(IMG_W * IMG_H * 6, lv_area_get_size(&area));
+
+            clock_t t_mode[2];
+            uint32_t fast;
+            for(fast = 0; fast < 2; fast++) {
+                lv_draw_sw_transform_set_fast_paths(fast);
+                clock_t t_start = clock();
+                uint32_t i;
+                for(i = 0; i < rounds; i++) {
+                    lv_draw_sw_transform(NULL, &area, scenes[s].src->data, IMG_W, IMG_H, IMG_W, &dsc, scenes[s].src->header.cf,
+                                         cbuf[fast], abuf[fast]);
+                }
+                t_mode[fast] = clock() - t_start;
+            }
+
+            uint32_t px_cnt = lv_area_get_size(&area);
+            TEST_ASSERT_EQUAL_MEMORY(abuf[0], abuf[1], px_cnt);
+            uint32_t i;
+            for(i = 0; i < px_cnt; i++) {
+                if(abuf[0][i] == LV_OPA_TRANSP) continue;
+                TEST_ASSERT_EQUAL_HEX32(lv_color_to32(cbuf[0][i]) & 0xFFFFFF, lv_color_to32(cbuf[1][i]) & 0xFFFFFF);
+            }
+
+            TEST_PRINTF("%s%s: %d us generic, %d us fast paths for %d transformations", scenes[s].name, aa ? " aa" : "",
+                        (int)(t_mode[0] * 1000000 / CLOCKS_PER_SEC), (int)(t_mode[1] * 1000000 / CLOCKS_PER_SEC), (int)rounds);
+        }
+    }
+
+    _lv_refr_set_disp_refreshing(NULL);
+#endif
+}
+
+#endif
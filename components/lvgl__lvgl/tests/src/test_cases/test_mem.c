@@ -11,6 +11,7 @@ void setUp(void)
 void tearDown(void)
 {
     /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
 }
 
 /* #3324 */
@@ -23,4 +24,69 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+void test_mem_buf_arena_in_refresh(void)
+{
+#if LV_MEM_BUF_ARENA_MAX
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_set_style_radius(obj, 30, 0);
+    lv_obj_set_style_shadow_width(obj, 20, 0);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Arena");
+
+    /*The first refresh sizes the arena*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_mem_buf_frame_monitor_t mon;
+    lv_mem_buf_frame_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.arena_size);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_MEM_BUF_ARENA_MAX, mon.arena_size);
+
+    /*The same scene fits into the arena next time*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_mem_buf_frame_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.arena_cnt);
+    TEST_ASSERT_EQUAL(0, mon.pool_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(mon.arena_size, mon.arena_max_used);
+#endif
+}
+
+void test_mem_buf_arena_reuse(void)
+{
+#if LV_MEM_BUF_ARENA_MAX
+    /*Make sure the arena is allocated*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    _lv_mem_buf_frame_begin();
+    uint8_t * a = lv_mem_buf_get(100);
+    uint8_t * b = lv_mem_buf_get(10);
+    TEST_ASSERT_TRUE(b > a);
+
+    /*The released top buffer is reused*/
+    lv_mem_buf_release(b);
+    uint8_t * c = lv_mem_buf_get(20);
+    TEST_ASSERT_EQUAL_PTR(b, c);
+
+    /*Not released in reverse order: the space is reused when the top is released too*/
+    lv_mem_buf_release(a);
+    uint8_t * d = lv_mem_buf_get(30);
+    TEST_ASSERT_TRUE(d > c);
+    lv_mem_buf_release(d);
+    lv_mem_buf_release(c);
+    uint8_t * e = lv_mem_buf_get(50);
+    TEST_ASSERT_EQUAL_PTR(a, e);
+    lv_mem_buf_release(e);
+    _lv_mem_buf_frame_end();
+
+    /*Out of refresh the pool is used*/
+    uint8_t * f = lv_mem_buf_get(100);
+    TEST_ASSERT_NOT_EQUAL(a, f);
+    lv_mem_buf_release(f);
+#endif
+}
+
 #endif
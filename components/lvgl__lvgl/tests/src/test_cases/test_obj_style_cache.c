@@ -0,0 +1,189 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define BENCH_ROW_CNT   12
+
+static lv_style_t style_shared;
+static lv_style_t style_pressed;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_style_init(&style_shared);
+    lv_style_init(&style_pressed);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_anim_del_all();
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style_shared);
+    lv_style_reset(&style_pressed);
+}
+
+void test_obj_style_cache_shared_style_change(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_style_set_bg_color(&style_shared, lv_color_hex(0xff0000));
+    lv_obj_add_style(obj, &style_shared, 0);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_bg_color(obj, 0).full);
+
+    lv_style_set_bg_color(&style_shared, lv_color_hex(0x00ff00));
+    lv_obj_report_style_change(&style_shared);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x00ff00).full, lv_obj_get_style_bg_color(obj, 0).full);
+
+    lv_obj_remove_style(obj, &style_shared, 0);
+    TEST_ASSERT_NOT_EQUAL(lv_color_hex(0x00ff00).full, lv_obj_get_style_bg_color(obj, 0).full);
+#endif
+}
+
+void test_obj_style_cache_local_style_and_parts(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_obj_t * obj = lv_slider_create(lv_scr_act());
+    lv_coord_t radius_knob = lv_obj_get_style_radius(obj, LV_PART_KNOB);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_pad_left(obj, LV_PART_INDICATOR));
+
+    lv_obj_set_style_pad_left(obj, 7, LV_PART_INDICATOR);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_pad_left(obj, LV_PART_INDICATOR));
+    TEST_ASSERT_EQUAL(radius_knob, lv_obj_get_style_radius(obj, LV_PART_KNOB));
+
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_PAD_LEFT, LV_PART_INDICATOR);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_pad_left(obj, LV_PART_INDICATOR));
+#endif
+}
+
+void test_obj_style_cache_state_change(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_style_set_border_width(&style_shared, 2);
+    lv_style_set_border_width(&style_pressed, 5);
+    lv_obj_add_style(obj, &style_shared, 0);
+    lv_obj_add_style(obj, &style_pressed, LV_STATE_PRESSED);
+
+    TEST_ASSERT_EQUAL(2, lv_obj_get_style_border_width(obj, 0));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_border_width(obj, 0));
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(2, lv_obj_get_style_border_width(obj, 0));
+#endif
+}
+
+void test_obj_style_cache_transition(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static const lv_style_prop_t props[] = {LV_STYLE_BORDER_WIDTH, 0};
+    static lv_style_transition_dsc_t tr;
+    lv_style_transition_dsc_init(&tr, props, lv_anim_path_linear, 100, 0, NULL);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_style_set_border_width(&style_shared, 0);
+    lv_style_set_border_width(&style_pressed, 100);
+    lv_style_set_transition(&style_pressed, &tr);
+    lv_obj_add_style(obj, &style_shared, 0);
+    lv_obj_add_style(obj, &style_pressed, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, 0));
+
+    /*The value of the transition style is seen instead of the target*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, 0));
+
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_coord_t w_mid = lv_obj_get_style_border_width(obj, 0);
+    TEST_ASSERT_GREATER_THAN(0, w_mid);
+    TEST_ASSERT_LESS_THAN(100, w_mid);
+
+    /*The transition style is removed at the end*/
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(100, lv_obj_get_style_border_width(obj, 0));
+#endif
+}
+
+void test_obj_style_cache_deleted_obj(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*A new object might be allocated at the address of the deleted one. It can't see the old values.*/
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        TEST_ASSERT_EQUAL(0, lv_obj_get_style_outline_width(obj, 0));
+        lv_obj_set_style_outline_width(obj, 3 + i, 0);
+        TEST_ASSERT_EQUAL(3 + i, lv_obj_get_style_outline_width(obj, 0));
+        lv_obj_del(obj);
+    }
+#endif
+}
+
+/*Read the style properties the objects are drawn with, like a refresh of the screen does*/
+static void init_draw_dscs(lv_obj_t * obj)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &rect_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        init_draw_dscs(lv_obj_get_child(obj, i));
+    }
+}
+
+void test_obj_style_cache_benchmark(void)
+{
+    /*A typical screen: rows of a container with labels, a bar and a button with the default theme*/
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < BENCH_ROW_CNT; i++) {
+        lv_obj_t * cont = lv_obj_create(scr);
+        lv_obj_set_size(cont, 380, 70);
+        lv_obj_set_pos(cont, (i % 2) * 400, (i / 2) * 80);
+        lv_obj_t * label = lv_label_create(cont);
+        lv_label_set_text_fmt(label, "Sensor %d", (int)i);
+        label = lv_label_create(cont);
+        lv_label_set_text(label, "21.5 C");
+        lv_obj_align(label, LV_ALIGN_TOP_RIGHT, 0, 0);
+        lv_obj_t * bar = lv_bar_create(cont);
+        lv_obj_set_size(bar, 200, 10);
+        lv_obj_align(bar, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        lv_bar_set_value(bar, i * 8, LV_ANIM_OFF);
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    }
+    lv_refr_now(NULL);
+
+    const uint32_t rounds = 1000;
+    clock_t t_start = clock();
+    for(i = 0; i < rounds; i++) {
+        init_draw_dscs(scr);
+    }
+    clock_t t_lookup = clock() - t_start;
+
+    const uint32_t refr_rounds = 20;
+    t_start = clock();
+    for(i = 0; i < refr_rounds; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+    }
+    clock_t t_refr = clock() - t_start;
+
+    TEST_PRINTF("%d style cache entries: %d ns style lookups per screen, %d us per full screen refresh",
+                LV_OBJ_STYLE_CACHE_SIZE, (int)(t_lookup * 1000000000 / CLOCKS_PER_SEC / rounds),
+                (int)(t_refr * 1000000 / CLOCKS_PER_SEC / refr_rounds));
+}
+
+#endif
@@ -0,0 +1,271 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define HOR_RES     800
+#define VER_RES     480
+#define BG_COLOR    0x464653
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+typedef struct {
+    const char * name;
+    const lv_area_t * areas;
+    uint32_t cnt;
+} trace_t;
+
+/*Invalidations of a frame on the Main screen while the clock and sensor labels change*/
+static const lv_area_t trace_labels[] = {
+    {300, 23, 379, 50}, {616, 59, 688, 80}, {696, 59, 768, 80}, {689, 59, 695, 80},
+    {111, 28, 269, 50}, {112, 62, 199, 80}, {300, 23, 387, 50}, {636, 18, 748, 40},
+};
+
+/*Refreshing the 6 day forecast: an image and 4 labels per day*/
+static lv_area_t trace_forecast[6 * 5];
+
+/*Scrolling a list of 24 rows in 3 steps*/
+static lv_area_t trace_scroll[24 * 3];
+
+/*A chart with 50 new points along a wave*/
+static lv_area_t trace_chart[50];
+
+static const trace_t traces[] = {
+    {"labels", trace_labels, sizeof(trace_labels) / sizeof(trace_labels[0])},
+    {"forecast", trace_forecast, sizeof(trace_forecast) / sizeof(trace_forecast[0])},
+    {"scroll", trace_scroll, sizeof(trace_scroll) / sizeof(trace_scroll[0])},
+    {"chart", trace_chart, sizeof(trace_chart) / sizeof(trace_chart[0])},
+};
+
+static void traces_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_coord_t x = 28 + i * 114;
+        lv_area_set(&trace_forecast[i * 5 + 0], x, 140, x + 63, 203);
+        lv_area_set(&trace_forecast[i * 5 + 1], x, 123, x + 71, 139);
+        lv_area_set(&trace_forecast[i * 5 + 2], x, 214, x + 71, 230);
+        lv_area_set(&trace_forecast[i * 5 + 3], x, 275, x + 71, 291);
+        lv_area_set(&trace_forecast[i * 5 + 4], x, 370, x + 71, 386);
+    }
+
+    for(i = 0; i < 24 * 3; i++) {
+        lv_coord_t y = 111 + (i % 24) * 13 + (i / 24) * 4;
+        lv_area_set(&trace_scroll[i], 20, y, 779, y + 11);
+    }
+
+    for(i = 0; i < 50; i++) {
+        lv_coord_t x = 30 + i * 15;
+        lv_coord_t y = 300 + lv_trigo_sin(i * 20) / 512;
+        lv_area_set(&trace_chart[i], x - 3, y - 3, x + 3, y + 3);
+    }
+}
+
+/*The invalidation and joining before the cost model: joining only overlapping areas which get smaller
+ *and redrawing the whole screen if the invalid area buffer is full*/
+static void legacy_refresh(const trace_t * trace, uint32_t * area_cnt, uint32_t * px_cnt)
+{
+    lv_area_t areas[LV_INV_BUF_SIZE];
+    uint8_t joined[LV_INV_BUF_SIZE] = {0};
+    uint32_t cnt = 0;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < trace->cnt; i++) {
+        bool is_in = false;
+        for(j = 0; j < cnt; j++) {
+            if(_lv_area_is_in(&trace->areas[i], &areas[j], 0)) is_in = true;
+        }
+        if(is_in) continue;
+
+        if(cnt < LV_INV_BUF_SIZE) {
+            areas[cnt] = trace->areas[i];
+        }
+        else {
+            cnt = 0;
+            lv_area_set(&areas[0], 0, 0, HOR_RES - 1, VER_RES - 1);
+        }
+        cnt++;
+    }
+
+    for(i = 0; i < cnt; i++) {
+        if(joined[i]) continue;
+        for(j = 0; j < cnt; j++) {
+            if(joined[j] || i == j) continue;
+            if(!_lv_area_is_on(&areas[i], &areas[j])) continue;
+            lv_area_t joined_area;
+            _lv_area_join(&joined_area, &areas[i], &areas[j]);
+            if(lv_area_get_size(&joined_area) < lv_area_get_size(&areas[i]) + lv_area_get_size(&areas[j])) {
+                areas[i] = joined_area;
+                joined[j] = 1;
+            }
+        }
+    }
+
+    *area_cnt = 0;
+    *px_cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        if(joined[i]) continue;
+        (*area_cnt)++;
+        *px_cnt += lv_area_get_size(&areas[i]);
+    }
+}
+
+static void (*flush_cb_ori)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+/*Copy the flushed areas to their place in the frame buffer*/
+static void area_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&test_fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void replay(const trace_t * trace)
+{
+    uint32_t i;
+    for(i = 0; i < trace->cnt; i++) {
+        _lv_inv_area(NULL, &trace->areas[i]);
+    }
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    traces_init();
+    flush_cb_ori = lv_disp_get_default()->driver->flush_cb;
+    lv_disp_get_default()->driver->flush_cb = area_flush_cb;
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(BG_COLOR), 0);
+    lv_refr_now(NULL);
+    lv_refr_reset_inv_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_disp_get_default()->driver->flush_cb = flush_cb_ori;
+}
+
+void test_refr_inv_area_all_invalidated_redrawn(void)
+{
+    uint32_t t;
+    for(t = 0; t < sizeof(traces) / sizeof(traces[0]); t++) {
+        uint32_t i;
+        for(i = 0; i < HOR_RES * VER_RES; i++) test_fb[i] = lv_color_black();
+
+        replay(&traces[t]);
+
+        for(i = 0; i < traces[t].cnt; i++) {
+            const lv_area_t * a = &traces[t].areas[i];
+            lv_coord_t x;
+            lv_coord_t y;
+            for(y = a->y1; y <= a->y2; y++) {
+                for(x = a->x1; x <= a->x2; x++) {
+                    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_color_hex(BG_COLOR)), lv_color_to32(test_fb[y * HOR_RES + x]));
+                }
+            }
+        }
+    }
+}
+
+void test_refr_inv_area_overflow_not_full_screen(void)
+{
+    /*More small areas than LV_INV_BUF_SIZE*/
+    replay(&traces[3]);
+
+    lv_refr_inv_stat_t stat;
+    lv_refr_get_inv_stat(&stat);
+    TEST_ASSERT_EQUAL(50, stat.inv_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.overflow_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.area_cnt);
+    TEST_ASSERT_LESS_THAN(HOR_RES * VER_RES / 4, stat.px_cnt);
+}
+
+void test_refr_inv_area_covered_areas_dropped(void)
+{
+    lv_area_t small = {10, 10, 19, 19};
+    lv_area_t large = {0, 0, 99, 99};
+    _lv_inv_area(NULL, &small);
+    _lv_inv_area(NULL, &large);
+    _lv_inv_area(NULL, &small);
+    TEST_ASSERT_EQUAL(1, lv_disp_get_default()->inv_p);
+
+    lv_refr_now(NULL);
+    lv_refr_inv_stat_t stat;
+    lv_refr_get_inv_stat(&stat);
+    TEST_ASSERT_EQUAL(1, stat.area_cnt);
+    TEST_ASSERT_EQUAL(100 * 100, stat.px_cnt);
+}
+
+void test_refr_inv_area_near_areas_joined(void)
+{
+    /*Joining costs fewer extra pixels than the overhead of a new area*/
+    lv_area_t a1 = {100, 100, 139, 119};
+    lv_area_t a2 = {142, 100, 181, 119};
+    _lv_inv_area(NULL, &a1);
+    _lv_inv_area(NULL, &a2);
+
+    /*Far from the others*/
+    lv_area_t a3 = {600, 400, 639, 419};
+    _lv_inv_area(NULL, &a3);
+
+    lv_refr_now(NULL);
+    lv_refr_inv_stat_t stat;
+    lv_refr_get_inv_stat(&stat);
+    TEST_ASSERT_EQUAL(1, stat.join_cnt);
+    TEST_ASSERT_EQUAL(2, stat.area_cnt);
+    TEST_ASSERT_EQUAL(82 * 20 + 40 * 20, stat.px_cnt);
+}
+
+void test_refr_inv_area_benchmark(void)
+{
+    const uint32_t rounds = 20;
+    uint32_t t;
+    for(t = 0; t < sizeof(traces) / sizeof(traces[0]); t++) {
+        uint32_t legacy_area_cnt;
+        uint32_t legacy_px_cnt;
+        legacy_refresh(&traces[t], &legacy_area_cnt, &legacy_px_cnt);
+
+        lv_refr_reset_inv_stat();
+        clock_t t_start = clock();
+        uint32_t i;
+        for(i = 0; i < rounds; i++) {
+            replay(&traces[t]);
+        }
+        clock_t t_replay = clock() - t_start;
+
+        lv_refr_inv_stat_t stat;
+        lv_refr_get_inv_stat(&stat);
+        uint32_t area_cnt = stat.area_cnt / rounds;
+        uint32_t px_cnt = stat.px_cnt / rounds;
+
+        /*Not more expensive than the legacy merging according to the cost model*/
+        TEST_ASSERT_LESS_OR_EQUAL(legacy_px_cnt + legacy_area_cnt * LV_INV_AREA_OVERHEAD,
+                                  px_cnt + area_cnt * LV_INV_AREA_OVERHEAD);
+
+        TEST_PRINTF("inv area trace %s (%d areas): legacy %d areas %d px, now %d areas %d px in %d us",
+                    traces[t].name, (int)traces[t].cnt, (int)legacy_area_cnt, (int)legacy_px_cnt,
+                    (int)area_cnt, (int)px_cnt, (int)(t_replay * 1000000 / CLOCKS_PER_SEC / rounds));
+    }
+
+    /*What the overflowing traces cost before*/
+    clock_t t_start = clock();
+    uint32_t i;
+    for(i = 0; i < rounds; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    TEST_PRINTF("inv area full screen refresh: %d us",
+                (int)((clock() - t_start) * 1000000 / CLOCKS_PER_SEC / rounds));
+}
+
+#endif
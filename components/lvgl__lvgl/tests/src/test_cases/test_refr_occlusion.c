@@ -0,0 +1,279 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define FB_PX           (800 * 480)
+
+/*The frame buffer the test display flushes to*/
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[FB_PX];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_refr_set_occlusion_culling(true);
+    lv_refr_reset_occlusion_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_obj_clean(lv_layer_top());
+    lv_refr_set_occlusion_culling(true);
+}
+
+#if LV_REFR_OCCLUDER_MAX
+
+static lv_obj_t * card_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x262635), 0);
+    return obj;
+}
+
+static void label_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, const char * txt)
+{
+    lv_obj_t * label = lv_label_create(parent);
+    lv_obj_set_pos(label, x, y);
+    lv_label_set_text(label, txt);
+}
+
+/*The same structure as the Main screen: two large cards with the labels over them as siblings*/
+static void main_screen_create(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x464653), 0);
+
+    card_create(scr, 8, 8, 784, 95);
+    label_create(scr, 111, 28, "Weather station");
+    label_create(scr, 300, 23, "12:34");
+    label_create(scr, 636, 18, "Indoor");
+    label_create(scr, 616, 59, "21.5");
+
+    card_create(scr, 8, 111, 784, 310);
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        label_create(scr, 28 + i * 114, 123, "Mon");
+        label_create(scr, 28 + i * 114, 214, "18/9");
+        label_create(scr, 28 + i * 114, 275, "Tue");
+        label_create(scr, 28 + i * 114, 370, "3 mm");
+    }
+}
+
+/*The same structure as the PC screen: cards, a status bar, buttons and a switch*/
+static void pc_screen_create(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x464653), 0);
+
+    card_create(scr, 8, 111, 784, 310);
+    card_create(scr, 8, 8, 784, 95);
+    lv_switch_create(scr);
+    label_create(scr, 112, 62, "CPU");
+    label_create(scr, 636, 18, "GPU");
+    card_create(scr, 10, 431, 784, 40);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * btn = lv_btn_create(scr);
+        lv_obj_set_pos(btn, 512 + i * 58, 36);
+        lv_obj_set_size(btn, 40, 40);
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0xd0d3d6), 0);
+        label_create(btn, 0, 0, LV_SYMBOL_POWER);
+    }
+}
+
+static void refresh_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw the screen without and with occlusion culling and compare the result*/
+static void check_render_the_same(lv_refr_occlusion_stat_t * stat)
+{
+    lv_refr_set_occlusion_culling(false);
+    lv_refr_reset_occlusion_stat();
+    refresh_screen();
+    memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_refr_get_occlusion_stat(stat);
+    TEST_ASSERT_EQUAL(0, stat->occluder_cnt);
+    TEST_ASSERT_EQUAL(0, stat->skip_obj_cnt + stat->skip_main_cnt + stat->trim_main_cnt);
+
+    lv_refr_set_occlusion_culling(true);
+    refresh_screen();
+    lv_refr_get_occlusion_stat(stat);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+#endif
+
+void test_refr_occlusion_main_screen(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    main_screen_create();
+
+    lv_refr_occlusion_stat_t stat;
+    check_render_the_same(&stat);
+
+    TEST_ASSERT_GREATER_THAN(0, stat.occluder_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.skip_main_cnt + stat.trim_main_cnt);
+    TEST_PRINTF("Main screen: %d occluders, %d widgets skipped, %d main draws skipped, %d trimmed",
+                (int)stat.occluder_cnt, (int)stat.skip_obj_cnt, (int)stat.skip_main_cnt, (int)stat.trim_main_cnt);
+#endif
+}
+
+void test_refr_occlusion_pc_screen(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    pc_screen_create();
+
+    lv_refr_occlusion_stat_t stat;
+    check_render_the_same(&stat);
+
+    TEST_ASSERT_GREATER_THAN(0, stat.occluder_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stat.skip_main_cnt + stat.trim_main_cnt);
+    TEST_PRINTF("PC screen: %d occluders, %d widgets skipped, %d main draws skipped, %d trimmed",
+                (int)stat.occluder_cnt, (int)stat.skip_obj_cnt, (int)stat.skip_main_cnt, (int)stat.trim_main_cnt);
+#endif
+}
+
+void test_refr_occlusion_hidden_panels(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    /*Panels with children fully hidden by an opaque card loaded over them*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * panel = card_create(lv_scr_act(), 20 + i * 190, 20, 170, 200);
+        label_create(panel, 0, 0, "Hidden");
+        lv_slider_create(panel);
+    }
+
+    lv_obj_t * cover = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cover);
+    lv_obj_set_pos(cover, 0, 0);
+    lv_obj_set_size(cover, 800, 300);
+    lv_obj_set_style_bg_opa(cover, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(cover, lv_color_hex(0x102030), 0);
+    label_create(cover, 10, 10, "Front");
+
+    lv_refr_occlusion_stat_t stat;
+    check_render_the_same(&stat);
+    TEST_ASSERT_GREATER_THAN(0, stat.skip_obj_cnt);
+#endif
+}
+
+void test_refr_occlusion_not_opaque_covers(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * obj;
+
+    /*Widgets below the others which can't hide them*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        obj = card_create(scr, 20 + i * 190, 20, 170, 420);
+        label_create(obj, 0, 0, "Below");
+    }
+
+    /*Semi transparent*/
+    obj = card_create(scr, 10, 10, 190, 150);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+
+    /*Additive blending*/
+    obj = card_create(scr, 200, 10, 190, 150);
+    lv_obj_set_style_blend_mode(obj, LV_BLEND_MODE_ADDITIVE, 0);
+
+    /*Large radius*/
+    obj = card_create(scr, 400, 10, 190, 150);
+    lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+
+    /*Clip corner with a child out of the rounded corners*/
+    obj = card_create(scr, 600, 10, 190, 150);
+    lv_obj_set_style_radius(obj, 30, 0);
+    lv_obj_set_style_clip_corner(obj, true, 0);
+    lv_obj_set_style_pad_all(obj, 0, 0);
+    lv_obj_t * child = card_create(obj, 0, 0, 190, 150);
+    lv_obj_set_style_radius(child, 0, 0);
+    lv_obj_set_style_bg_color(child, lv_color_hex(0x80a0ff), 0);
+
+    /*Overflow visible with a child out of its parent*/
+    obj = card_create(scr, 10, 200, 190, 150);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    child = card_create(obj, 150, 100, 100, 100);
+    lv_obj_set_style_radius(child, 0, 0);
+
+    /*Opaque card on the top layer*/
+    obj = card_create(lv_layer_top(), 600, 200, 190, 150);
+    lv_obj_set_style_radius(obj, 0, 0);
+
+    lv_refr_occlusion_stat_t stat;
+    check_render_the_same(&stat);
+    TEST_ASSERT_GREATER_THAN(0, stat.occluder_cnt);
+#endif
+}
+
+#if LV_REFR_OCCLUDER_MAX
+static void draw_main_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+#endif
+
+void test_refr_occlusion_draw_events_sent_once(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    lv_obj_t * scr = lv_scr_act();
+
+    /*A card with a draw handler and an other one without it, both covered in the middle*/
+    uint32_t draw_cnt = 0;
+    lv_obj_t * obj = card_create(scr, 10, 10, 380, 300);
+    lv_obj_add_event_cb(obj, draw_main_event_cb, LV_EVENT_DRAW_MAIN, &draw_cnt);
+    card_create(scr, 410, 10, 380, 300);
+    obj = card_create(scr, 100, 100, 200, 100);
+    lv_obj_set_style_radius(obj, 0, 0);
+    obj = card_create(scr, 500, 100, 200, 100);
+    lv_obj_set_style_radius(obj, 0, 0);
+
+    lv_refr_set_occlusion_culling(false);
+    refresh_screen();
+    uint32_t draw_cnt_ref = draw_cnt;
+
+    /*Drawn without and with occlusion culling: the same number of events each time*/
+    draw_cnt = 0;
+    lv_refr_occlusion_stat_t stat;
+    check_render_the_same(&stat);
+    TEST_ASSERT_EQUAL(2 * draw_cnt_ref, draw_cnt);
+    /*The card without handler is still drawn around the covered part*/
+    TEST_ASSERT_GREATER_THAN(0, stat.trim_main_cnt);
+#endif
+}
+
+void test_refr_occlusion_disabled(void)
+{
+#if LV_REFR_OCCLUDER_MAX
+    main_screen_create();
+    lv_refr_set_occlusion_culling(false);
+    refresh_screen();
+
+    lv_refr_occlusion_stat_t stat;
+    lv_refr_get_occlusion_stat(&stat);
+    TEST_ASSERT_EQUAL(0, stat.occluder_cnt);
+    TEST_ASSERT_EQUAL(0, stat.skip_obj_cnt);
+    TEST_ASSERT_EQUAL(0, stat.skip_main_cnt);
+    TEST_ASSERT_EQUAL(0, stat.trim_main_cnt);
+#endif
+}
+
+#endif
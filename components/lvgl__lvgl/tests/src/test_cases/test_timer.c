@@ -0,0 +1,170 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+#define BENCH_TIMER_CNT 500
+#define OTHER_TIMER_MAX 16
+
+static uint32_t cb_cnt;
+static lv_timer_t * other_timers[OTHER_TIMER_MAX];
+static uint32_t other_timer_cnt;
+
+static void count_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    cb_cnt++;
+}
+
+static void self_del_cb(lv_timer_t * timer)
+{
+    cb_cnt++;
+    lv_timer_del(timer);
+}
+
+static bool timer_exists(lv_timer_t * timer)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        if(t == timer) return true;
+        t = lv_timer_get_next(t);
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    cb_cnt = 0;
+
+    /*Pause the display, input device, etc timers to see only the timers of the test*/
+    other_timer_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t && other_timer_cnt < OTHER_TIMER_MAX) {
+        if(!t->paused) {
+            other_timers[other_timer_cnt] = t;
+            other_timer_cnt++;
+            lv_timer_pause(t);
+        }
+        t = lv_timer_get_next(t);
+    }
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    uint32_t i;
+    for(i = 0; i < other_timer_cnt; i++) {
+        lv_timer_resume(other_timers[i]);
+    }
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(timer, 3);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_timer_handler();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(3, cb_cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer));
+}
+
+void test_timer_zero_repeat_count_deletes_the_timer(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 100000, NULL);
+    lv_timer_set_repeat_count(timer, 0);
+
+    /*Deleted without calling the callback and no other timers remain*/
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(0, cb_cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer));
+}
+
+void test_timer_pause_resume(void)
+{
+    lv_timer_t * timer = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_pause(timer);
+
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(0, cb_cnt);
+
+    lv_timer_resume(timer);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, cb_cnt);
+
+    lv_timer_del(timer);
+}
+
+void test_timer_ready_and_next_deadline(void)
+{
+    lv_timer_t * timer_long = lv_timer_create(count_cb, 100000, NULL);
+    lv_timer_t * timer_short = lv_timer_create(count_cb, 500, NULL);
+
+    /*The earliest deadline is reported*/
+    uint32_t time_till_next = lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, cb_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(500, time_till_next);
+    TEST_ASSERT_GREATER_THAN_UINT32(400, time_till_next);
+
+    lv_timer_ready(timer_long);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, cb_cnt);
+
+    /*The period of the long timer started again so the short one is the next*/
+    lv_timer_set_period(timer_short, 300);
+    time_till_next = lv_timer_handler();
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(300, time_till_next);
+    TEST_ASSERT_GREATER_THAN_UINT32(200, time_till_next);
+
+    lv_timer_del(timer_short);
+    time_till_next = lv_timer_handler();
+    TEST_ASSERT_GREATER_THAN_UINT32(90000, time_till_next);
+
+    lv_timer_del(timer_long);
+}
+
+void test_timer_delete_itself(void)
+{
+    lv_timer_t * timer1 = lv_timer_create(self_del_cb, 0, NULL);
+    lv_timer_t * timer2 = lv_timer_create(self_del_cb, 0, NULL);
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(2, cb_cnt);
+    TEST_ASSERT_FALSE(timer_exists(timer1));
+    TEST_ASSERT_FALSE(timer_exists(timer2));
+}
+
+void test_timer_benchmark(void)
+{
+    static lv_timer_t * timers[BENCH_TIMER_CNT];
+    uint32_t i;
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(count_cb, 20 + (i * 37) % 1000, NULL);
+    }
+
+    /*Simulate 2 seconds calling the handler in every millisecond*/
+    const uint32_t handler_cnt = 2000;
+    clock_t t_start = clock();
+    for(i = 0; i < handler_cnt; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    clock_t t_handler = clock() - t_start;
+
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        lv_timer_del(timers[i]);
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, cb_cnt);
+    TEST_PRINTF("%d timers: %d handler calls, %d callbacks, %d ns per call", BENCH_TIMER_CNT, (int)handler_cnt,
+                (int)cb_cnt, (int)(t_handler * 1000000000 / CLOCKS_PER_SEC / handler_cnt));
+}
+
+#endif
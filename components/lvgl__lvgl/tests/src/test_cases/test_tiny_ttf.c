@@ -3,6 +3,9 @@
 
 #include "unity/unity.h"
 
+#include <string.h>
+#include <time.h>
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -46,4 +49,123 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+void test_tiny_ttf_atlas_matches_rasterizer(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 30, 64 * 1024);
+
+    TEST_ASSERT_EQUAL(10, lv_tiny_ttf_prewarm(font, "0123456789"));
+    TEST_ASSERT_EQUAL(0, lv_tiny_ttf_prewarm(font, "9876543210"));
+
+    lv_tiny_ttf_cache_stats_t stats;
+    lv_tiny_ttf_get_cache_stats(font, &stats);
+    TEST_ASSERT_EQUAL(10, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL(0, stats.miss);
+
+    /*A glyph from the atlas must be the same as a freshly rasterized one*/
+    static uint8_t ref[64 * 64];
+    const char * txt = "0123456789AbgQ@";
+    uint32_t i;
+    for(i = 0; txt[i] != '\0'; i++) {
+        lv_font_glyph_dsc_t g;
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, txt[i], 0));
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref), g.box_w * g.box_h);
+
+        lv_tiny_ttf_flush_cache(font);
+        const uint8_t * bmp = lv_font_get_glyph_bitmap(font, txt[i]);
+        TEST_ASSERT_NOT_NULL(bmp);
+        lv_memcpy(ref, bmp, g.box_w * g.box_h);
+
+        lv_tiny_ttf_prewarm(font, "0123456789");
+        bmp = lv_font_get_glyph_bitmap(font, txt[i]);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, bmp, g.box_w * g.box_h);
+    }
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_atlas_sizes_and_eviction(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    /*Room for about 2 pages*/
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 20, 2 * 64 * 64 + 2048);
+    lv_font_t * font_big = lv_tiny_ttf_create_size(font, 40);
+    TEST_ASSERT_NOT_NULL(font_big);
+    TEST_ASSERT_GREATER_THAN(font->line_height, font_big->line_height);
+
+    /*The sizes are cached separately in the shared atlas*/
+    lv_tiny_ttf_prewarm(font, "0");
+    lv_tiny_ttf_prewarm(font_big, "0");
+    lv_tiny_ttf_cache_stats_t stats;
+    lv_tiny_ttf_get_cache_stats(font, &stats);
+    TEST_ASSERT_EQUAL(2, stats.glyph_cnt);
+
+    /*Many big glyphs don't fit into the budget so the least recently used pages are dropped*/
+    lv_tiny_ttf_prewarm(font_big, "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    lv_tiny_ttf_get_cache_stats(font, &stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.evict);
+    TEST_ASSERT_LESS_OR_EQUAL(2, stats.page_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * 64 * 64 + 2048, stats.used_size);
+
+    /*The fonts can be destroyed in any order*/
+    lv_tiny_ttf_destroy(font);
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font_big, 'Z'));
+    lv_tiny_ttf_destroy(font_big);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_atlas_benchmark(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 40, 128 * 1024);
+    const char * txt = "The quick brown fox jumps over the lazy dog 0123456789";
+    const uint32_t rounds = 20;
+    uint32_t r;
+    uint32_t i;
+
+    /*Rasterize every glyph every time*/
+    clock_t t_start = clock();
+    for(r = 0; r < rounds; r++) {
+        for(i = 0; txt[i] != '\0'; i++) {
+            lv_tiny_ttf_flush_cache(font);
+            lv_font_get_glyph_bitmap(font, txt[i]);
+        }
+    }
+    clock_t t_raster = clock() - t_start;
+
+    /*Get the glyphs from the atlas*/
+    lv_tiny_ttf_prewarm(font, txt);
+    t_start = clock();
+    for(r = 0; r < rounds; r++) {
+        for(i = 0; txt[i] != '\0'; i++) {
+            lv_font_get_glyph_bitmap(font, txt[i]);
+        }
+    }
+    clock_t t_atlas = clock() - t_start;
+
+    lv_tiny_ttf_cache_stats_t stats;
+    lv_tiny_ttf_get_cache_stats(font, &stats);
+    TEST_ASSERT_EQUAL(rounds * strlen(txt), stats.hit);
+
+    TEST_PRINTF("tiny_ttf glyph bitmaps: rasterized %d us, from atlas %d us (%d glyphs)",
+                (int)(t_raster * 1000000 / CLOCKS_PER_SEC), (int)(t_atlas * 1000000 / CLOCKS_PER_SEC),
+                (int)(rounds * strlen(txt)));
+
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
@@ -204,4 +204,86 @@ void test_txt_next_line_should_handle_empty_string(void)
     TEST_ASSERT_EQUAL_UINT32(0, next_line);
 }
 
+void test_txt_layout_cache_should_save_measurement_of_same_text(void)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    const char * txt = "Hello World";
+    lv_txt_layout_cache_stats_t stats_before;
+    lv_txt_layout_cache_stats_t stats_after;
+    lv_point_t size_1;
+    lv_point_t size_2;
+
+    lv_txt_layout_cache_invalidate_font(NULL);
+    lv_txt_layout_cache_get_stats(&stats_before);
+
+    lv_txt_get_size(&size_1, txt, &lv_font_montserrat_14, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&size_2, txt, &lv_font_montserrat_14, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+
+    lv_txt_layout_cache_get_stats(&stats_after);
+
+    TEST_ASSERT_EQUAL_UINT32(stats_before.miss + 1, stats_after.miss);
+    TEST_ASSERT_EQUAL_UINT32(stats_before.hit + 1, stats_after.hit);
+    TEST_ASSERT_EQUAL_INT32(size_1.x, size_2.x);
+    TEST_ASSERT_EQUAL_INT32(size_1.y, size_2.y);
+#endif
+}
+
+void test_txt_layout_cache_should_match_line_breaks(void)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    const char * txt = "The quick brown fox\njumps over the lazy dog";
+    const lv_font_t * font = &lv_font_montserrat_14;
+    lv_coord_t max_width = 60;
+
+    lv_txt_layout_cache_invalidate_font(NULL);
+    const lv_txt_layout_t * layout = _lv_txt_get_layout(txt, font, 0, 0, max_width, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_NULL(layout);
+    TEST_ASSERT_GREATER_THAN_UINT16(2, layout->line_cnt);
+
+    uint32_t line_start = 0;
+    uint16_t i;
+    for(i = 0; i < layout->line_cnt; i++) {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, 0, max_width, NULL,
+                                                               LV_TEXT_FLAG_NONE);
+        lv_coord_t line_w = lv_txt_get_width(&txt[line_start], line_end - line_start, font, 0, LV_TEXT_FLAG_NONE);
+
+        TEST_ASSERT_EQUAL_UINT32(line_start, layout->line_start[i]);
+        TEST_ASSERT_EQUAL_INT32(line_w, layout->line_w[i]);
+        line_start = line_end;
+    }
+    TEST_ASSERT_EQUAL_UINT32(strlen(txt), layout->line_start[layout->line_cnt]);
+#endif
+}
+
+void test_txt_layout_cache_should_drop_entries_of_invalidated_font(void)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    const char * txt = "12:34";
+    lv_txt_layout_cache_stats_t stats_before;
+    lv_txt_layout_cache_stats_t stats_after;
+    lv_point_t size;
+
+    lv_txt_get_size(&size, txt, &lv_font_montserrat_14, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_layout_cache_invalidate_font(&lv_font_montserrat_14);
+
+    lv_txt_layout_cache_get_stats(&stats_before);
+    lv_txt_get_size(&size, txt, &lv_font_montserrat_14, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_layout_cache_get_stats(&stats_after);
+
+    TEST_ASSERT_EQUAL_UINT32(stats_before.miss + 1, stats_after.miss);
+    TEST_ASSERT_EQUAL_UINT32(stats_before.hit, stats_after.hit);
+#endif
+}
+
+void test_txt_layout_cache_should_skip_long_texts(void)
+{
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    char txt[LV_TXT_LAYOUT_CACHE_TEXT_MAX + 2];
+    lv_memset(txt, 'a', sizeof(txt) - 1);
+    txt[sizeof(txt) - 1] = '\0';
+
+    TEST_ASSERT_NULL(_lv_txt_get_layout(txt, &lv_font_montserrat_14, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE));
+#endif
+}
+
 #endif
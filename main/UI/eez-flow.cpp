@@ -51,7 +51,7 @@ void initAllocHeap(uint8_t *heap, size_t heapSize) {
     EEZ_UNUSED(heap);
     EEZ_UNUSED(heapSize);
 }
-void *alloc(size_t size, uint32_t id) {
+static void *heapAlloc(size_t size, uint32_t id) {
     EEZ_UNUSED(id);
 #if LVGL_VERSION_MAJOR >= 9
     return lv_malloc(size);
@@ -59,22 +59,14 @@ void *alloc(size_t size, uint32_t id) {
     return lv_mem_alloc(size);
 #endif
 }
-void free(void *ptr) {
+static void heapFree(void *ptr) {
 #if LVGL_VERSION_MAJOR >= 9
     lv_free(ptr);
 #else
     lv_mem_free(ptr);
 #endif
 }
-template<typename T> void freeObject(T *ptr) {
-	ptr->~T();
-#if LVGL_VERSION_MAJOR >= 9
-    lv_free(ptr);
-#else
-	lv_mem_free(ptr);
-#endif
-}
-void getAllocInfo(uint32_t &free, uint32_t &alloc) {
+static void getHeapInfo(uint32_t &free, uint32_t &alloc) {
     lv_mem_monitor_t mon;
     lv_mem_monitor(&mon);
 	free = mon.free_size;
@@ -84,17 +76,13 @@ void getAllocInfo(uint32_t &free, uint32_t &alloc) {
 #include <emscripten/heap.h>
 void initAllocHeap(uint8_t *heap, size_t heapSize) {
 }
-void *alloc(size_t size, uint32_t id) {
+static void *heapAlloc(size_t size, uint32_t id) {
     return ::malloc(size);
 }
-void free(void *ptr) {
+static void heapFree(void *ptr) {
     ::free(ptr);
 }
-template<typename T> void freeObject(T *ptr) {
-	ptr->~T();
-	::free(ptr);
-}
-void getAllocInfo(uint32_t &free, uint32_t &alloc) {
+static void getHeapInfo(uint32_t &free, uint32_t &alloc) {
 	free = emscripten_get_heap_max() - emscripten_get_heap_size();
 	alloc = emscripten_get_heap_size();
 }
@@ -124,7 +112,7 @@ void initAllocHeap(uint8_t *heap, size_t heapSize) {
 	first->size = heapSize - sizeof(AllocBlock);
 	EEZ_MUTEX_CREATE(alloc);
 }
-void *alloc(size_t size, uint32_t id) {
+static void *heapAlloc(size_t size, uint32_t id) {
 	if (size == 0) {
 		return nullptr;
 	}
@@ -158,7 +146,7 @@ void *alloc(size_t size, uint32_t id) {
 	}
 	return nullptr;
 }
-void free(void *ptr) {
+static void heapFree(void *ptr) {
 	if (ptr == 0) {
 		return;
 	}
@@ -195,12 +183,8 @@ void free(void *ptr) {
 		EEZ_MUTEX_RELEASE(alloc);
 	}
 }
-template<typename T> void freeObject(T *ptr) {
-	ptr->~T();
-	free(ptr);
-}
 #if OPTION_SCPI
-void dumpAlloc(scpi_t *context) {
+static void dumpHeap(scpi_t *context) {
 	AllocBlock *first = (AllocBlock *)g_heap;
 	AllocBlock *block = first;
 	while (block) {
@@ -215,7 +199,7 @@ void dumpAlloc(scpi_t *context) {
 	}
 }
 #endif
-void getAllocInfo(uint32_t &free, uint32_t &alloc) {
+static void getHeapInfo(uint32_t &free, uint32_t &alloc) {
 	free = 0;
 	alloc = 0;
 	if (EEZ_MUTEX_WAIT(alloc, osWaitForever)) {
@@ -233,6 +217,226 @@ void getAllocInfo(uint32_t &free, uint32_t &alloc) {
 	}
 }
 #endif
+#if defined(EEZ_FOR_LVGL) || defined(EEZ_DASHBOARD_API)
+#define POOLS_LOCK() true
+#define POOLS_UNLOCK()
+#else
+#define POOLS_LOCK() EEZ_MUTEX_WAIT(alloc, osWaitForever)
+#define POOLS_UNLOCK() EEZ_MUTEX_RELEASE(alloc)
+#endif
+#if !defined(EEZ_FLOW_ALLOC_POOLS_SIZE)
+#define EEZ_FLOW_ALLOC_POOLS_SIZE (16 * 1024)
+#endif
+static const uint32_t POOL_BLOCK_SIZES[NUM_ALLOC_POOLS] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+static const size_t POOL_SLAB_SIZE = 1024;
+static const uint16_t POOL_NONE = NUM_ALLOC_POOLS;
+struct PoolBlockHeader {
+    uint16_t pool;
+    uint16_t blockIndex;
+    uint32_t id;
+};
+struct PoolFreeBlock {
+    PoolFreeBlock *next;
+};
+struct PoolSlab {
+    PoolSlab *prev;
+    PoolSlab *next;
+    PoolFreeBlock *firstFree;
+    uint16_t numBlocks;
+    uint16_t numUsed;
+};
+static const size_t POOL_SLAB_HEADER_SIZE = (sizeof(PoolSlab) + 7) & ~7;
+struct Pool {
+    PoolSlab *firstSlab;
+    AllocPoolInfo info;
+};
+static Pool g_pools[NUM_ALLOC_POOLS];
+static uint8_t g_poolIndexes[256 / 16 + 1];
+static bool g_poolsInitialized;
+static uint8_t *g_poolsArena;
+static uint8_t *g_poolsArenaEnd;
+static PoolSlab *g_firstFreeSlab;
+static uint32_t g_numFreeSlabs;
+static void initPools() {
+    for (uint32_t i = 0, pool = 0; i < sizeof(g_poolIndexes); i++) {
+        while (POOL_BLOCK_SIZES[pool] < i * 16) {
+            pool++;
+        }
+        g_poolIndexes[i] = pool;
+    }
+    for (uint32_t pool = 0; pool < NUM_ALLOC_POOLS; pool++) {
+        g_pools[pool].info.blockSize = POOL_BLOCK_SIZES[pool];
+    }
+    // the slabs are kept together, apart from the objects of the heap which live longer
+    auto numSlabs = EEZ_FLOW_ALLOC_POOLS_SIZE / POOL_SLAB_SIZE;
+    g_poolsArena = numSlabs > 0 ? (uint8_t *)heapAlloc(numSlabs * POOL_SLAB_SIZE, 0x3d7fa4c0) : nullptr;
+    if (g_poolsArena) {
+        g_poolsArenaEnd = g_poolsArena + numSlabs * POOL_SLAB_SIZE;
+        for (size_t i = numSlabs; i-- > 0;) {
+            auto slab = (PoolSlab *)(g_poolsArena + i * POOL_SLAB_SIZE);
+            slab->next = g_firstFreeSlab;
+            g_firstFreeSlab = slab;
+        }
+        g_numFreeSlabs = numSlabs;
+    }
+    g_poolsInitialized = true;
+}
+static inline size_t getPoolBlockStride(const Pool &pool) {
+    return sizeof(PoolBlockHeader) + pool.info.blockSize;
+}
+static void linkSlab(Pool &pool, PoolSlab *slab) {
+    slab->prev = nullptr;
+    slab->next = pool.firstSlab;
+    if (pool.firstSlab) {
+        pool.firstSlab->prev = slab;
+    }
+    pool.firstSlab = slab;
+}
+static void unlinkSlab(Pool &pool, PoolSlab *slab) {
+    if (slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        pool.firstSlab = slab->next;
+    }
+    if (slab->next) {
+        slab->next->prev = slab->prev;
+    }
+}
+static PoolSlab *allocSlab(Pool &pool, uint16_t poolIndex) {
+    PoolSlab *slab;
+    if (g_firstFreeSlab) {
+        slab = g_firstFreeSlab;
+        g_firstFreeSlab = slab->next;
+        g_numFreeSlabs--;
+    } else {
+        slab = (PoolSlab *)heapAlloc(POOL_SLAB_SIZE, 0x3d7fa4c1 + poolIndex);
+        if (!slab) {
+            return nullptr;
+        }
+    }
+    auto stride = getPoolBlockStride(pool);
+    auto numBlocks = (POOL_SLAB_SIZE - POOL_SLAB_HEADER_SIZE) / stride;
+    slab->firstFree = nullptr;
+    slab->numBlocks = numBlocks;
+    slab->numUsed = 0;
+    for (size_t i = numBlocks; i-- > 0;) {
+        auto header = (PoolBlockHeader *)((uint8_t *)slab + POOL_SLAB_HEADER_SIZE + i * stride);
+        header->pool = poolIndex;
+        header->blockIndex = i;
+        auto freeBlock = (PoolFreeBlock *)(header + 1);
+        freeBlock->next = slab->firstFree;
+        slab->firstFree = freeBlock;
+    }
+    linkSlab(pool, slab);
+    pool.info.numBlocks += numBlocks;
+    return slab;
+}
+static void freeSlab(Pool &pool, PoolSlab *slab) {
+    unlinkSlab(pool, slab);
+    pool.info.numBlocks -= slab->numBlocks;
+    if ((uint8_t *)slab >= g_poolsArena && (uint8_t *)slab < g_poolsArenaEnd) {
+        slab->next = g_firstFreeSlab;
+        g_firstFreeSlab = slab;
+        g_numFreeSlabs++;
+    } else {
+        heapFree(slab);
+    }
+}
+void *alloc(size_t size, uint32_t id) {
+#if EEZ_OPTION_FLOW_PROFILER
+    flow::g_profilerAllocBytes += size;
+#endif
+    if (size <= POOL_BLOCK_SIZES[NUM_ALLOC_POOLS - 1] && POOLS_LOCK()) {
+        if (!g_poolsInitialized) {
+            initPools();
+        }
+        auto poolIndex = g_poolIndexes[(size + 15) / 16];
+        auto &pool = g_pools[poolIndex];
+        auto slab = pool.firstSlab ? pool.firstSlab : allocSlab(pool, poolIndex);
+        if (slab) {
+            auto freeBlock = slab->firstFree;
+            slab->firstFree = freeBlock->next;
+            if (++slab->numUsed == slab->numBlocks) {
+                unlinkSlab(pool, slab);
+            }
+            if (++pool.info.numUsed > pool.info.maxUsed) {
+                pool.info.maxUsed = pool.info.numUsed;
+            }
+            POOLS_UNLOCK();
+            auto header = (PoolBlockHeader *)freeBlock - 1;
+            header->id = id;
+            return freeBlock;
+        }
+        POOLS_UNLOCK();
+    }
+    auto header = (PoolBlockHeader *)heapAlloc(sizeof(PoolBlockHeader) + size, id);
+    if (!header) {
+        return nullptr;
+    }
+    header->pool = POOL_NONE;
+    header->id = id;
+    return header + 1;
+}
+void free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto header = (PoolBlockHeader *)ptr - 1;
+    if (header->pool == POOL_NONE) {
+        heapFree(header);
+        return;
+    }
+    if (POOLS_LOCK()) {
+        auto &pool = g_pools[header->pool];
+        auto slab = (PoolSlab *)((uint8_t *)header - header->blockIndex * getPoolBlockStride(pool) - POOL_SLAB_HEADER_SIZE);
+        auto freeBlock = (PoolFreeBlock *)ptr;
+        if (slab->numUsed-- == slab->numBlocks) {
+            linkSlab(pool, slab);
+        }
+        freeBlock->next = slab->firstFree;
+        slab->firstFree = freeBlock;
+        pool.info.numUsed--;
+        // keep the last slab with free blocks of the pool, so it doesn't have to be set up again
+        if (slab->numUsed == 0 && (slab->prev || slab->next)) {
+            freeSlab(pool, slab);
+        }
+        POOLS_UNLOCK();
+    }
+}
+template<typename T> void freeObject(T *ptr) {
+	ptr->~T();
+	free(ptr);
+}
+void getAllocPoolInfo(AllocPoolInfo *pools) {
+    for (uint32_t pool = 0; pool < NUM_ALLOC_POOLS; pool++) {
+        pools[pool] = g_pools[pool].info;
+        pools[pool].blockSize = POOL_BLOCK_SIZES[pool];
+    }
+}
+#if OPTION_SCPI
+void dumpAlloc(scpi_t *context) {
+#if !defined(EEZ_FOR_LVGL) && !defined(EEZ_DASHBOARD_API)
+    dumpHeap(context);
+#endif
+    AllocPoolInfo pools[NUM_ALLOC_POOLS];
+    getAllocPoolInfo(pools);
+    for (uint32_t pool = 0; pool < NUM_ALLOC_POOLS; pool++) {
+        char buffer[100];
+        snprintf(buffer, sizeof(buffer), "POOL %d: %d/%d used, max %d", (int)pools[pool].blockSize,
+            (int)pools[pool].numUsed, (int)pools[pool].numBlocks, (int)pools[pool].maxUsed);
+        SCPI_ResultText(context, buffer);
+    }
+}
+#endif
+void getAllocInfo(uint32_t &free, uint32_t &alloc) {
+    getHeapInfo(free, alloc);
+    uint32_t poolsFree = g_numFreeSlabs * POOL_SLAB_SIZE;
+    for (uint32_t pool = 0; pool < NUM_ALLOC_POOLS; pool++) {
+        poolsFree += (g_pools[pool].info.numBlocks - g_pools[pool].info.numUsed) * POOL_BLOCK_SIZES[pool];
+    }
+    free += poolsFree;
+    alloc -= poolsFree;
+}
 } 
 // -----------------------------------------------------------------------------
 // core/assets.cpp
@@ -606,7 +810,7 @@ uint8_t *allocBuffer(uint32_t size) {
 #if defined(EEZ_PLATFORM_STM32)
 #include <main.h>
 #endif
-#if defined(EEZ_PLATFORM_ESP32)
+#if defined(EEZ_PLATFORM_ESP32) || defined(ESP_PLATFORM)
 #include <esp_timer.h>
 #endif
 #if defined(EEZ_PLATFORM_PICO)
@@ -640,6 +844,17 @@ uint32_t millis() {
     #error "Missing millis implementation";
 #endif
 }
+uint32_t micros() {
+#if defined(EEZ_PLATFORM_ESP32) || defined(ESP_PLATFORM)
+	return (uint32_t)esp_timer_get_time();
+#elif defined(__EMSCRIPTEN__)
+	return (uint32_t)(emscripten_get_now() * 1000);
+#elif defined(EEZ_PLATFORM_PICO)
+    return to_us_since_boot(get_absolute_time());
+#else
+    return millis() * 1000;
+#endif
+}
 } 
 // -----------------------------------------------------------------------------
 // core/unit.cpp
@@ -1957,10 +2172,10 @@ static bool compare_STRING_value(const Value &a, const Value &b) {
     }
     const char *astr = a.getString();
     const char *bstr = b.getString();
-    if (!astr && !bstr) {
+    if (astr == bstr) {
         return true;
     }
-    if ((!astr && bstr) || (astr && !bstr)) {
+    if (!astr || !bstr) {
         return false;
     }
     return strcmp(astr, bstr) == 0;
@@ -2033,6 +2248,16 @@ static const char *STRING_REF_value_type_name(const Value &value) {
     EEZ_UNUSED(value);
     return "string";
 }
+static bool compare_STRING_SMALL_value(const Value &a, const Value &b) {
+	return compare_STRING_value(a, b);
+}
+static void STRING_SMALL_value_to_text(const Value &value, char *text, int count) {
+	STRING_value_to_text(value, text, count);
+}
+static const char *STRING_SMALL_value_type_name(const Value &value) {
+    EEZ_UNUSED(value);
+    return "string";
+}
 static bool compare_BLOB_REF_value(const Value &a, const Value &b) {
     return a.type == b.type && a.refValue == b.refValue;
 }
@@ -2406,6 +2631,12 @@ Value MakeEnumDefinitionValue(uint8_t enumValue, uint8_t enumDefinition) {
     return value;
 }
 const char *Value::getString() const {
+    if (type == VALUE_TYPE_STRING_SMALL) {
+        return (const char *)this + offsetof(Value, dstValueType);
+    }
+    if (type == VALUE_TYPE_VALUE_PTR) {
+        return pValueValue->getString();
+    }
     auto value = getValue(); 
 	if (value.type == VALUE_TYPE_STRING_REF) {
 		return ((StringRef *)value.refValue)->str;
@@ -2413,6 +2644,17 @@ const char *Value::getString() const {
 	if (value.type == VALUE_TYPE_STRING) {
 		return value.strValue;
 	}
+    if (value.type == VALUE_TYPE_STRING_SMALL) {
+        if (type == VALUE_TYPE_ARRAY_ELEMENT_VALUE) {
+            auto arrayElementValue = (ArrayElementValue *)refValue;
+            auto &elementValue = arrayElementValue->arrayValue.getArray()->values[arrayElementValue->elementIndex];
+            if (elementValue.type == VALUE_TYPE_STRING_SMALL) {
+                return elementValue.getString();
+            }
+        }
+        // the string is stored in a temporary (native variable, property) which is gone on return
+        return internSmallString(value.getString());
+    }
 	return nullptr;
 }
 const ArrayValue *Value::getArray() const {
@@ -2765,14 +3007,115 @@ Value Value::toString(uint32_t id) const {
 #endif
 	return makeStringRef(tempStr, strlen(tempStr), id);
 }
+static_assert(offsetof(Value, int64Value) == offsetof(Value, dstValueType) + sizeof(uint32_t), "small string doesn't fit");
+static Value makeSmallString(const char *str, size_t len) {
+    Value value;
+    value.type = VALUE_TYPE_STRING_SMALL;
+    stringCopyLength((char *)&value + offsetof(Value, dstValueType), SMALL_STRING_SIZE - 1, str, len);
+    return value;
+}
+static const size_t INTERNED_STRINGS_SIZE = 128;
+static const char *g_internedStrings[INTERNED_STRINGS_SIZE];
+static size_t g_numInternedStrings;
+static uint32_t hashString(const char *str, size_t len, size_t &strLen) {
+    uint32_t hash = 2166136261u;
+    for (strLen = 0; strLen < len && str[strLen]; strLen++) {
+        hash = (hash ^ (uint8_t)str[strLen]) * 16777619u;
+    }
+    return hash;
+}
+static const char *findInternedString(const char *str, size_t len) {
+    size_t strLen;
+    auto i = hashString(str, len, strLen) % INTERNED_STRINGS_SIZE;
+    if (strLen != len) {
+        return nullptr;
+    }
+    for (; g_internedStrings[i]; i = (i + 1) % INTERNED_STRINGS_SIZE) {
+        if (memcmp(g_internedStrings[i], str, len) == 0 && g_internedStrings[i][len] == 0) {
+            return g_internedStrings[i];
+        }
+    }
+    return nullptr;
+}
+void internString(const char *str) {
+    auto len = strlen(str);
+    if (len < SMALL_STRING_SIZE || g_numInternedStrings >= INTERNED_STRINGS_SIZE * 3 / 4 || findInternedString(str, len)) {
+        return;
+    }
+    size_t strLen;
+    auto i = hashString(str, len, strLen) % INTERNED_STRINGS_SIZE;
+    while (g_internedStrings[i]) {
+        i = (i + 1) % INTERNED_STRINGS_SIZE;
+    }
+    g_internedStrings[i] = str;
+    g_numInternedStrings++;
+}
+void resetInternedStrings() {
+    memset(g_internedStrings, 0, sizeof(g_internedStrings));
+    g_numInternedStrings = 0;
+}
+// Small strings of temporaries returned by Value::getString(). They are kept until the end of the flow tick
+// at least: the table is emptied at the start of a tick only when it is nearly full.
+static const size_t SMALL_STRINGS_SIZE = 64;
+static char g_smallStrings[SMALL_STRINGS_SIZE][SMALL_STRING_SIZE];
+static size_t g_numSmallStrings;
+// The strings which didn't fit into the table during the tick
+struct SmallStringCopy {
+    SmallStringCopy *next;
+    char str[SMALL_STRING_SIZE];
+};
+static SmallStringCopy *g_smallStringCopies;
+const char *internSmallString(const char *str) {
+    if (!*str) {
+        return "";
+    }
+    size_t strLen;
+    auto i = hashString(str, SMALL_STRING_SIZE - 1, strLen) % SMALL_STRINGS_SIZE;
+    for (; g_smallStrings[i][0]; i = (i + 1) % SMALL_STRINGS_SIZE) {
+        if (strcmp(g_smallStrings[i], str) == 0) {
+            return g_smallStrings[i];
+        }
+    }
+    if (g_numSmallStrings < SMALL_STRINGS_SIZE * 3 / 4) {
+        stringCopy(g_smallStrings[i], SMALL_STRING_SIZE, str);
+        g_numSmallStrings++;
+        return g_smallStrings[i];
+    }
+    auto copy = (SmallStringCopy *)alloc(sizeof(SmallStringCopy), 0x5d0c62a7);
+    if (!copy) {
+        return "";
+    }
+    stringCopy(copy->str, SMALL_STRING_SIZE, str);
+    copy->next = g_smallStringCopies;
+    g_smallStringCopies = copy;
+    return copy->str;
+}
+void releaseSmallStrings(bool all) {
+    while (g_smallStringCopies) {
+        auto next = g_smallStringCopies->next;
+        free(g_smallStringCopies);
+        g_smallStringCopies = next;
+    }
+    if (all || g_numSmallStrings >= SMALL_STRINGS_SIZE * 3 / 4) {
+        memset(g_smallStrings, 0, sizeof(g_smallStrings));
+        g_numSmallStrings = 0;
+    }
+}
 Value Value::makeStringRef(const char *str, int len, uint32_t id) {
+	if (len == -1) {
+		len = strlen(str);
+	}
+    if (len < (int)SMALL_STRING_SIZE) {
+        return makeSmallString(str, len);
+    }
+    auto internedStr = findInternedString(str, len);
+    if (internedStr) {
+        return Value(internedStr, VALUE_TYPE_STRING);
+    }
     auto stringRef = ObjectAllocator<StringRef>::allocate(id);
 	if (stringRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
-	if (len == -1) {
-		len = strlen(str);
-	}
     stringRef->str = (char *)alloc(len + 1, id + 1);
     if (stringRef->str == nullptr) {
         ObjectAllocator<StringRef>::deallocate(stringRef);
@@ -2788,11 +3131,16 @@ Value Value::makeStringRef(const char *str, int len, uint32_t id) {
 	return value;
 }
 Value Value::concatenateString(const Value &str1, const Value &str2) {
+    auto newStrLen = strlen(str1.getString()) + strlen(str2.getString()) + 1;
+    if (newStrLen <= SMALL_STRING_SIZE) {
+        auto value = makeSmallString(str1.getString(), SMALL_STRING_SIZE);
+        stringAppendString((char *)value.getString(), SMALL_STRING_SIZE, str2.getString());
+        return value;
+    }
     auto stringRef = ObjectAllocator<StringRef>::allocate(0xbab14c6a);;
 	if (stringRef == nullptr) {
 		return Value(0, VALUE_TYPE_NULL);
 	}
-    auto newStrLen = strlen(str1.getString()) + strlen(str2.getString()) + 1;
     stringRef->str = (char *)alloc(newStrLen, 0xb5320162);
     if (stringRef->str == nullptr) {
         ObjectAllocator<StringRef>::deallocate(stringRef);
@@ -2958,8 +3306,10 @@ Value Value::clone() {
 }
 #if defined(EEZ_OPTION_GUI)
 #if !EEZ_OPTION_GUI
+// The native variables of the generated UI, unless the app registers its own
+native_var_t *g_nativeVars = native_vars;
 Value getVar(int16_t id) {
-    auto native_var = native_vars[id];
+    auto native_var = g_nativeVars[id];
     if (native_var.type == NATIVE_VAR_TYPE_INTEGER) {
         auto get = (int32_t (*)())native_var.get;
         return Value((int)get(), VALUE_TYPE_INT32);
@@ -2980,10 +3330,16 @@ Value getVar(int16_t id) {
         auto get = (const char *(*)())native_var.get;
         return Value(get(), VALUE_TYPE_STRING);
     }
+    if (native_var.type == NATIVE_VAR_TYPE_VALUE) {
+        auto get = (void (*)(void *))native_var.get;
+        Value value;
+        get(&value);
+        return value;
+    }
     return Value();
 }
 void setVar(int16_t id, const Value& value) {
-    auto native_var = native_vars[id];
+    auto native_var = g_nativeVars[id];
     if (native_var.type == NATIVE_VAR_TYPE_INTEGER) {
         auto set = (void (*)(int32_t))native_var.set;
         set(value.toInt32(nullptr));
@@ -3004,6 +3360,10 @@ void setVar(int16_t id, const Value& value) {
         auto set = (void (*)(const char *))native_var.set;
         set(value.getString());
     }
+    if (native_var.type == NATIVE_VAR_TYPE_VALUE && native_var.set) {
+        auto set = (void (*)(const void *))native_var.set;
+        set(&value);
+    }
 }
 #endif 
 #endif 
@@ -3135,6 +3495,9 @@ void registerComponent(ComponentTypes componentType, ExecuteComponentFunctionTyp
 	}
 }
 void executeComponent(FlowState *flowState, unsigned componentIndex) {
+#if EEZ_OPTION_FLOW_PROFILER
+    ProfilerScope profilerScope(flowState, componentIndex, PROFILER_COUNTER_EXECUTE);
+#endif
 	auto component = flowState->flow->components[componentIndex];
 	if (component->type >= defs_v3::FIRST_DASHBOARD_ACTION_COMPONENT_TYPE) {
 #if defined(EEZ_DASHBOARD_API)
@@ -3962,7 +4325,8 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
                     return;
                 }
                 if (specific->property == IMAGE_IMAGE || specific->property == LABEL_TEXT) {
-                    const char *strValue = value.toString(0xe42b3ca2).getString();
+                    value = value.toString(0xe42b3ca2);
+                    const char *strValue = value.getString();
                     if (specific->property == IMAGE_IMAGE) {
                         const void *src = getLvglImageByNameHook(strValue);
                         if (src) {
@@ -4212,7 +4576,8 @@ void executeLVGLComponent(FlowState *flowState, unsigned componentIndex) {
         return; \
     }\
     propIndex++; \
-    const char *NAME = NAME##Value.toString(0xe42b3ca2).getString();
+    NAME##Value = NAME##Value.toString(0xe42b3ca2); \
+    const char *NAME = NAME##Value.getString();
 #define SCREEN_PROP(NAME) \
     Value NAME##Value; \
     if (!evalExpression(flowState, componentIndex, properties[propIndex]->evalInstructions, NAME##Value, FlowError::PropertyInAction(#NAME, actionName, actionIndex))) { \
@@ -6048,7 +6413,9 @@ enum MessagesToDebugger {
     MESSAGE_TO_DEBUGGER_LOG, 
 	MESSAGE_TO_DEBUGGER_PAGE_CHANGED, 
     MESSAGE_TO_DEBUGGER_COMPONENT_EXECUTION_STATE_CHANGED, 
-    MESSAGE_TO_DEBUGGER_COMPONENT_ASYNC_STATE_CHANGED 
+    MESSAGE_TO_DEBUGGER_COMPONENT_ASYNC_STATE_CHANGED, 
+    MESSAGE_TO_DEBUGGER_SCHEDULER_STATS, 
+    MESSAGE_TO_DEBUGGER_PROFILE 
 };
 enum MessagesFromDebugger {
     MESSAGE_FROM_DEBUGGER_RESUME, 
@@ -6058,7 +6425,9 @@ enum MessagesFromDebugger {
     MESSAGE_FROM_DEBUGGER_REMOVE_BREAKPOINT, 
     MESSAGE_FROM_DEBUGGER_ENABLE_BREAKPOINT, 
     MESSAGE_FROM_DEBUGGER_DISABLE_BREAKPOINT, 
-    MESSAGE_FROM_DEBUGGER_MODE 
+    MESSAGE_FROM_DEBUGGER_MODE, 
+    MESSAGE_FROM_DEBUGGER_GET_SCHEDULER_STATS, 
+    MESSAGE_FROM_DEBUGGER_GET_PROFILE 
 };
 enum LogItemType {
 	LOG_ITEM_TYPE_FATAL,
@@ -6114,9 +6483,54 @@ void onDebuggerClientDisconnected() {
     g_debuggerIsConnected = false;
     setDebuggerState(DEBUGGER_STATE_RESUMED);
 }
+static void onSchedulerStatsRequested() {
+    if (isSubscribedTo(MESSAGE_TO_DEBUGGER_SCHEDULER_STATS)) {
+        TaskPriorityStats stats[NUM_TASK_PRIORITIES];
+        getTaskPriorityStats(stats);
+        for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+            auto numLatencies = stats[priority].numExecuted > 0 ? stats[priority].numExecuted : 1;
+            char buffer[256];
+            snprintf(buffer, sizeof(buffer), "%d\t%d\t%d\t%d\t%d\t%d\t%" PRIu64 "\t%d\t%d\n",
+                MESSAGE_TO_DEBUGGER_SCHEDULER_STATS,
+                (int)priority,
+                (int)stats[priority].size,
+                (int)stats[priority].maxSize,
+                (int)stats[priority].numExecuted,
+                (int)stats[priority].numAged,
+                stats[priority].executionTime,
+                (int)(stats[priority].totalLatency / numLatencies),
+                (int)stats[priority].maxLatency
+            );
+            writeDebuggerBufferHook(buffer, strlen(buffer));
+        }
+    }
+}
+#if EEZ_OPTION_FLOW_PROFILER
+static void writeProfileRowToDebugger(void *param, const char *row, size_t rowLength) {
+    EEZ_UNUSED(param);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%d\t", MESSAGE_TO_DEBUGGER_PROFILE);
+    writeDebuggerBufferHook(buffer, strlen(buffer));
+    writeDebuggerBufferHook(row, rowLength);
+}
+static void onProfileRequested(const char *params) {
+    char *p;
+    auto sortColumn = (ProfilerSortColumn)strtol(params, &p, 10);
+    auto reset = *p == '\t' && strtol(p + 1, nullptr, 10) != 0;
+    if (isSubscribedTo(MESSAGE_TO_DEBUGGER_PROFILE)) {
+        writeProfile(sortColumn, writeProfileRowToDebugger, nullptr);
+    }
+    if (reset) {
+        profilerReset();
+    }
+}
+#endif
 void processDebuggerInput(char *buffer, uint32_t length) {
 	for (uint32_t i = 0; i < length; i++) {
 		if (buffer[i] == '\n') {
+            if (g_inputFromDebuggerPosition < sizeof(g_inputFromDebugger)) {
+                g_inputFromDebugger[g_inputFromDebuggerPosition] = 0;
+            }
 			int messageFromDebugger = g_inputFromDebugger[0] - '0';
 			if (messageFromDebugger == MESSAGE_FROM_DEBUGGER_RESUME) {
 				setDebuggerState(DEBUGGER_STATE_RESUMED);
@@ -6150,7 +6564,14 @@ void processDebuggerInput(char *buffer, uint32_t length) {
 #if EEZ_OPTION_GUI
                 gui::refreshScreen();
 #endif
+            } else if (messageFromDebugger == MESSAGE_FROM_DEBUGGER_GET_SCHEDULER_STATS) {
+                onSchedulerStatsRequested();
             }
+#if EEZ_OPTION_FLOW_PROFILER
+            else if (messageFromDebugger == MESSAGE_FROM_DEBUGGER_GET_PROFILE) {
+                onProfileRequested(g_inputFromDebuggerPosition > 2 ? g_inputFromDebugger + 2 : "0");
+            }
+#endif
 			g_inputFromDebuggerPosition = 0;
 		} else {
 			if (g_inputFromDebuggerPosition < sizeof(g_inputFromDebugger)) {
@@ -6338,6 +6759,7 @@ static void writeValue(const Value &value) {
 	case VALUE_TYPE_STRING:
     case VALUE_TYPE_STRING_ASSET:
 	case VALUE_TYPE_STRING_REF:
+    case VALUE_TYPE_STRING_SMALL:
 		writeString(value.getString());
 		return;
 	case VALUE_TYPE_ARRAY:
@@ -6826,6 +7248,9 @@ static void evalExpression(FlowState *flowState, const uint8_t *instructions, in
 bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const FlowError &errorMessage, int *numInstructionBytes, const int32_t *iterators, DataOperationEnum operation) {
 #else
 bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const FlowError &errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+#endif
+#if EEZ_OPTION_FLOW_PROFILER
+    ProfilerScope profilerScope(flowState, componentIndex, PROFILER_COUNTER_EVAL);
 #endif
     size_t savedSp = g_stack.sp;
     FlowState *savedFlowState = g_stack.flowState;
@@ -6891,6 +7316,9 @@ bool evalExpression(FlowState *flowState, int componentIndex, const uint8_t *ins
 	return false;
 }
 bool evalAssignableExpression(FlowState *flowState, int componentIndex, const uint8_t *instructions, Value &result, const FlowError &errorMessage, int *numInstructionBytes, const int32_t *iterators) {
+#if EEZ_OPTION_FLOW_PROFILER
+    ProfilerScope profilerScope(flowState, componentIndex, PROFILER_COUNTER_EVAL);
+#endif
     FlowState *savedFlowState = g_stack.flowState;
 	int savedComponentIndex = g_stack.componentIndex;
 	const int32_t *savedIterators = g_stack.iterators;
@@ -7025,6 +7453,21 @@ FlowState *g_lastFlowState;
 static bool g_isStopping = false;
 static bool g_isStopped = true;
 static void doStop();
+static void internConstants(FlowDefinition *flowDefinition) {
+    resetInternedStrings();
+    for (uint32_t i = 0; i < flowDefinition->constants.count; i++) {
+        Value value = *flowDefinition->constants[i];
+        if (value.type == VALUE_TYPE_STRING) {
+            internString(value.getString());
+        }
+    }
+    for (uint32_t i = 0; i < flowDefinition->globalVariables.count; i++) {
+        Value value = *flowDefinition->globalVariables[i];
+        if (value.type == VALUE_TYPE_STRING) {
+            internString(value.getString());
+        }
+    }
+}
 unsigned start(Assets *assets) {
 	auto flowDefinition = static_cast<FlowDefinition *>(assets->flowDefinition);
 	if (flowDefinition->flows.count == 0) {
@@ -7032,9 +7475,14 @@ unsigned start(Assets *assets) {
 	}
     g_isStopped = false;
     g_isStopping = false;
+    internConstants(flowDefinition);
+#if EEZ_OPTION_FLOW_PROFILER
+    profilerReset();
+#endif
     initGlobalVariables(assets);
 	queueReset();
     watchListReset();
+    dependenciesReset();
 	scpiComponentInitHook();
 	onStarted(assets);
 	return 1;
@@ -7048,7 +7496,10 @@ void tick() {
         return;
     }
 	uint32_t startTickCount = millis();
+    releaseSmallStrings(false);
+    checkNativeVariableVersions();
     visitWatchList();
+    queueStartTick();
     auto queueSizeAtTickStart = getQueueSize();
     for (size_t i = 0; i < queueSizeAtTickStart || g_numNonContinuousTaskInQueue > 0; i++) {
 		FlowState *flowState;
@@ -7079,6 +7530,7 @@ void tick() {
                 executeComponent(flowState, componentIndex);
             }
         }
+        onTaskExecuted();
         if (isFlowStopped() || g_isStopping) {
             break;
         }
@@ -7113,6 +7565,9 @@ void doStop() {
     g_isStopped = true;
 	queueReset();
     watchListReset();
+    dependenciesReset();
+    resetInternedStrings();
+    releaseSmallStrings(true);
 }
 bool isFlowStopped() {
     return g_isStopped;
@@ -7204,8 +7659,10 @@ void setGlobalVariable(Assets *assets, uint32_t globalVariableIndex, const Value
     if (globalVariableIndex < assets->flowDefinition->globalVariables.count) {
         if (g_globalVariables) {
             g_globalVariables->values[globalVariableIndex] = value;
+            onVariableAssigned(nullptr, g_globalVariables->values + globalVariableIndex);
         } else {
             *assets->flowDefinition->globalVariables[globalVariableIndex] = value;
+            onVariableAssigned(nullptr, assets->flowDefinition->globalVariables[globalVariableIndex]);
         }
     }
 }
@@ -7617,6 +8074,9 @@ static void (*g_changeColorTheme)(uint32_t themeIndex);
 static uint32_t g_selectedThemeIndex;
 static void (*g_createScreenFunc)(int screenIndex);
 static void (*g_deleteScreenFunc)(int screenIndex);
+static void (*g_screenCreatedFunc)(int screenIndex);
+static size_t g_minFreeMemory;
+static size_t (*g_getFreeMemoryFunc)();
 static lv_obj_t *getLvglObjectFromIndex(int32_t index) {
     if (index >= 0 && (uint32_t)index < g_numObjects) {
         return g_objects[index];
@@ -7680,12 +8140,22 @@ void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*chan
     g_numThemes = numThemes;
     g_changeColorTheme = changeColorTheme;
 }
+void eez_flow_init_native_vars(native_var_t *nativeVars) {
+    eez::g_nativeVars = nativeVars;
+}
 void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex)) {
     g_createScreenFunc = createScreenFunc;
 }
 void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex)) {
     g_deleteScreenFunc = deleteScreenFunc;
 }
+void eez_flow_set_screen_created_func(void (*screenCreatedFunc)(int screenIndex)) {
+    g_screenCreatedFunc = screenCreatedFunc;
+}
+void eez_flow_set_screen_memory_policy(size_t minFreeMemory, size_t (*getFreeMemoryFunc)()) {
+    g_minFreeMemory = minFreeMemory;
+    g_getFreeMemoryFunc = getFreeMemoryFunc;
+}
 static void lvglSetColorTheme(const char *themeName) {
     for (uint32_t i = 0; i < g_numThemes; i++) {
         if (strcmp(themeName, g_themeNames[i]) == 0) {
@@ -7708,14 +8178,51 @@ extern "C" int16_t eez_flow_get_current_screen() {
 static bool isScreenCreated(int screenIndex) {
     return eez::flow::getLvglObjectFromIndexHook(screenIndex) != 0;
 }
+static bool isMemoryLow() {
+    return g_getFreeMemoryFunc && g_getFreeMemoryFunc() < g_minFreeMemory;
+}
+static void deleteScreen(int screenIndex) {
+    if (g_deleteScreenFunc && isScreenCreated(screenIndex)) {
+        g_deleteScreenFunc(screenIndex);
+    }
+}
+// The screen is loaded, being loaded or unloaded by a screen load animation
+static bool isScreenShown(int screenIndex) {
+    lv_obj_t *screen = eez::flow::getLvglObjectFromIndexHook(screenIndex);
+    if (!screen) {
+        return false;
+    }
+    lv_disp_t *disp = lv_obj_get_disp(screen);
+    return screen == disp->act_scr || screen == disp->scr_to_load || screen == disp->prev_scr;
+}
+static void deleteInactiveScreens() {
+    for (size_t i = 0; i < g_numScreens; i++) {
+        if ((int16_t)i != g_currentScreen && !isScreenShown(i)) {
+            deleteScreen(i);
+        }
+    }
+}
 static void createScreen(int screenIndex) {
     if (g_createScreenFunc && !isScreenCreated(screenIndex)) {
+        if (isMemoryLow()) {
+            deleteInactiveScreens();
+        }
         g_createScreenFunc(screenIndex);
+        if (g_screenCreatedFunc && isScreenCreated(screenIndex)) {
+            g_screenCreatedFunc(screenIndex);
+        }
     }
 }
-static void deleteScreen(int screenIndex) {
-    if (g_deleteScreenFunc && isScreenCreated(screenIndex)) {
-        g_deleteScreenFunc(screenIndex);
+static void deleteUnloadedScreen(void *userData) {
+    int16_t screenIndex = (int16_t)(lv_uintptr_t)userData;
+    if (screenIndex != g_currentScreen && !isScreenShown(screenIndex) && isMemoryLow()) {
+        deleteScreen(screenIndex);
+    }
+}
+static void on_screen_unloaded_low_memory(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_SCREEN_UNLOADED) {
+        // lv_scr_load_anim() still uses the unloaded screen when it interrupts a screen load animation
+        lv_async_call(deleteUnloadedScreen, lv_event_get_user_data(e));
     }
 }
 extern "C" void eez_flow_set_screen(int16_t screenId, lv_scr_load_anim_t animType, uint32_t speed, uint32_t delay) {
@@ -7833,6 +8340,10 @@ void replacePageHook(int16_t pageId, uint32_t animType, uint32_t speed, uint32_t
     }
     eez::flow::onPageChanged(g_currentScreen + 1, pageId);
     g_currentScreen = screenIndex;
+    if (g_getFreeMemoryFunc && g_deleteScreenFunc) {
+        lv_obj_remove_event_cb(screen, on_screen_unloaded_low_memory);
+        lv_obj_add_event_cb(screen, on_screen_unloaded_low_memory, LV_EVENT_SCREEN_UNLOADED, (void*)(lv_uintptr_t)(screenIndex));
+    }
     lv_scr_load_anim(screen, (lv_scr_load_anim_t)animType, speed, delay, false);
 }
 extern "C" void flowOnPageLoaded(unsigned pageIndex) {
@@ -7886,12 +8397,15 @@ extern "C" void flowPropagateValueLVGLEvent(void *flowState, unsigned componentI
         rotaryDiff = lv_event_get_rotary_diff(event);
     }
 #endif
+    auto taskPriority = eez::flow::g_currentTaskPriority;
+    eez::flow::g_currentTaskPriority = eez::flow::TASK_PRIORITY_INPUT;
     eez::flow::propagateValue(
         (eez::flow::FlowState *)flowState, componentIndex, outputIndex,
         eez::Value::makeLVGLEventRef(
             code, currentTarget, target, userData, key, gestureDir, rotaryDiff, 0xe7f23624
         )
     );
+    eez::flow::g_currentTaskPriority = taskPriority;
     g_lastLVGLEvent = *event;
     if (event->user_data) {
         g_lastLVGLEvent.user_data = &g_lastLVGLEventUserDataBuffer;
@@ -8005,6 +8519,26 @@ extern "C" void _assignBooleanProperty(void *flowState, unsigned componentIndex,
     eez::Value srcValue(value, eez::VALUE_TYPE_BOOLEAN);
     eez::flow::assignValue((eez::flow::FlowState *)flowState, componentIndex, dstValue, srcValue);
 }
+extern "C" void flowResetPropertyBindings(FlowPropertyBinding *bindings, size_t numBindings) {
+    for (size_t i = 0; i < numBindings; i++) {
+        bindings[i].flowState = nullptr;
+    }
+}
+extern "C" void flowUpdatePropertyBindings(void *flowState, FlowPropertyBinding *bindings, size_t numBindings) {
+    auto pFlowState = (eez::flow::FlowState *)flowState;
+    for (size_t i = 0; i < numBindings; i++) {
+        auto binding = bindings + i;
+        if (binding->flowState != flowState) {
+            auto component = pFlowState->flow->components[binding->componentIndex];
+            eez::flow::scanDependencies(pFlowState, component->properties[binding->propertyIndex]->evalInstructions, binding->globalVariablesMask, binding->localVariablesMask, binding->poll);
+            binding->flowState = flowState;
+            binding->stamp = eez::flow::getVariablesStamp();
+            binding->update(flowState);
+        } else if (eez::flow::dependenciesChanged(pFlowState, binding->globalVariablesMask, binding->localVariablesMask, binding->stamp) || binding->poll) {
+            binding->update(flowState);
+        }
+    }
+}
 extern "C" float getTimelinePosition(void *flowState) {
     return ((eez::flow::FlowState *)flowState)->timelinePosition;
 }
@@ -8041,6 +8575,123 @@ extern "C" bool compareRollerOptions(lv_roller_t *roller, const char *new_val, c
 uint32_t eez_flow_get_selected_theme_index() {
     return g_selectedThemeIndex;
 }
+static inline uint32_t getChartSeriesSlot(const FlowChartSeries *series, uint32_t index) {
+    auto slot = series->next + series->capacity - series->count + index;
+    return slot >= series->capacity ? slot - series->capacity : slot;
+}
+// index of the first sample with time > time, or >= time if !after
+static uint32_t findChartSeriesTime(const FlowChartSeries *series, uint32_t time, bool after) {
+    uint32_t lo = 0;
+    uint32_t hi = series->count;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        auto midTime = series->times[getChartSeriesSlot(series, mid)];
+        if (midTime < time || (after && midTime == time)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+static void onChartSeriesChartDeleted(lv_event_t *e) {
+    auto series = (FlowChartSeries *)lv_event_get_user_data(e);
+    series->chart = nullptr;
+    series->series = nullptr;
+}
+extern "C" bool eez_flow_chart_series_init(FlowChartSeries *series, uint32_t capacity) {
+    memset(series, 0, sizeof(FlowChartSeries));
+    // the number of points of lv_chart is 16 bit
+    if (capacity == 0 || capacity > UINT16_MAX) {
+        return false;
+    }
+    series->times = (uint32_t *)eez::alloc(capacity * (sizeof(uint32_t) + sizeof(lv_coord_t)), 0x5a3c91d7);
+    if (!series->times) {
+        return false;
+    }
+    series->values = (lv_coord_t *)(series->times + capacity);
+    series->capacity = capacity;
+    eez_flow_chart_series_clear(series);
+    return true;
+}
+extern "C" void eez_flow_chart_series_free(FlowChartSeries *series) {
+    eez_flow_chart_series_detach(series);
+    eez::free(series->times);
+    memset(series, 0, sizeof(FlowChartSeries));
+}
+extern "C" void eez_flow_chart_series_attach(FlowChartSeries *series, lv_obj_t *chart, lv_chart_series_t *chartSeries) {
+    eez_flow_chart_series_detach(series);
+    // in the shift mode the chart draws from the oldest sample and lv_chart_set_next_value doesn't move the points
+    lv_chart_set_point_count(chart, series->capacity);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_ext_y_array(chart, chartSeries, series->values);
+    lv_chart_set_x_start_point(chart, chartSeries, series->next);
+    lv_obj_add_event_cb(chart, onChartSeriesChartDeleted, LV_EVENT_DELETE, series);
+    series->chart = chart;
+    series->series = chartSeries;
+}
+extern "C" void eez_flow_chart_series_detach(FlowChartSeries *series) {
+    if (!series->chart) {
+        return;
+    }
+    lv_obj_remove_event_cb_with_user_data(series->chart, onChartSeriesChartDeleted, series);
+    // the chart keeps a copy of the points, the buffer can be freed
+    auto points = (lv_coord_t *)lv_mem_alloc(series->capacity * sizeof(lv_coord_t));
+    if (points) {
+        memcpy(points, series->values, series->capacity * sizeof(lv_coord_t));
+        lv_chart_set_ext_y_array(series->chart, series->series, points);
+        series->series->y_ext_buf_assigned = false;
+    } else {
+        lv_chart_remove_series(series->chart, series->series);
+    }
+    series->chart = nullptr;
+    series->series = nullptr;
+}
+extern "C" bool eez_flow_chart_series_append(FlowChartSeries *series, uint32_t time, lv_coord_t value) {
+    if (series->count > 0 && time < series->times[getChartSeriesSlot(series, series->count - 1)]) {
+        return false;
+    }
+    series->times[series->next] = time;
+    if (series->chart) {
+        // writes the value to the buffer and invalidates only the new point
+        lv_chart_set_next_value(series->chart, series->series, value);
+    } else {
+        series->values[series->next] = value;
+    }
+    if (++series->next == series->capacity) {
+        series->next = 0;
+    }
+    if (series->count < series->capacity) {
+        series->count++;
+    }
+    return true;
+}
+extern "C" void eez_flow_chart_series_clear(FlowChartSeries *series) {
+    for (uint32_t i = 0; i < series->capacity; i++) {
+        series->values[i] = LV_CHART_POINT_NONE;
+    }
+    series->count = 0;
+    series->next = 0;
+    if (series->chart) {
+        lv_chart_set_x_start_point(series->chart, series->series, 0);
+        lv_chart_refresh(series->chart);
+    }
+}
+extern "C" uint32_t eez_flow_chart_series_find(const FlowChartSeries *series, uint32_t fromTime, uint32_t toTime, uint32_t *firstIndex) {
+    auto first = findChartSeriesTime(series, fromTime, false);
+    auto last = findChartSeriesTime(series, toTime, true);
+    *firstIndex = first;
+    return last > first ? last - first : 0;
+}
+extern "C" void eez_flow_chart_series_get(const FlowChartSeries *series, uint32_t index, uint32_t *time, lv_coord_t *value) {
+    auto slot = getChartSeriesSlot(series, index);
+    if (time) {
+        *time = series->times[slot];
+    }
+    if (value) {
+        *value = series->values[slot];
+    }
+}
 #endif 
 // -----------------------------------------------------------------------------
 // flow/operations.cpp
@@ -10404,6 +11055,7 @@ void initGlobalVariables(Assets *assets) {
         (numVars > 0 ? numVars - 1 : 0) * sizeof(Value),
         0xcc34ca8e
     );
+    g_globalVariables->count = numVars;
     for (uint32_t i = 0; i < numVars; i++) {
 		new (g_globalVariables->values + i) Value();
         g_globalVariables->values[i] = flowDefinition->globalVariables[i]->clone();
@@ -10475,6 +11127,8 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 			sizeof(FlowState) +
 			nValues * sizeof(Value) +
 			flow->components.count * sizeof(ComponenentExecutionState *) +
+			flow->localVariables.count * sizeof(uint32_t) +
+			flow->components.count * sizeof(uint16_t) +
 			flow->components.count * sizeof(bool),
 			0x4c3b6ef5
 		)
@@ -10524,7 +11178,11 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
     flowState->nextSibling = nullptr;
 	flowState->values = (Value *)(flowState + 1);
 	flowState->componenentExecutionStates = (ComponenentExecutionState **)(flowState->values + nValues);
-    flowState->componenentAsyncStates = (bool *)(flowState->componenentExecutionStates + flow->components.count);
+    flowState->localVariableStamps = (uint32_t *)(flowState->componenentExecutionStates + flow->components.count);
+    flowState->componentQueueCounters = (uint16_t *)(flowState->localVariableStamps + flow->localVariables.count);
+    flowState->componenentAsyncStates = (bool *)(flowState->componentQueueCounters + flow->components.count);
+    flowState->firstQueueTask = QUEUE_NO_TASK;
+    flowState->lastQueueTask = QUEUE_NO_TASK;
 	for (unsigned i = 0; i < nValues; i++) {
 		new (flowState->values + i) Value();
 	}
@@ -10535,9 +11193,11 @@ static FlowState *initFlowState(Assets *assets, int flowIndex, FlowState *parent
 	for (unsigned i = 0; i < flow->localVariables.count; i++) {
 		auto value = flow->localVariables[i];
 		flowState->values[flow->componentInputs.count + i] = *value;
+		flowState->localVariableStamps[i] = 0;
 	}
 	for (unsigned i = 0; i < flow->components.count; i++) {
 		flowState->componenentExecutionStates[i] = nullptr;
+		flowState->componentQueueCounters[i] = 0;
 		flowState->componenentAsyncStates[i] = false;
 	}
 	onFlowStateCreated(flowState);
@@ -10755,6 +11415,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
                     throwError(flowState, componentIndex, FlowError::Plain(errorMessage));
                 } else {
                     blobRef->blob[arrayElementValue->elementIndex] = elementValue;
+                    onVariableAssigned(flowState, nullptr);
                 }
                 return;
             } else {
@@ -10773,6 +11434,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
             if (err) {
                 throwError(flowState, componentIndex, FlowError::Plain("Can not assign to JSON member"));
             }
+            onVariableAssigned(flowState, nullptr);
             return;
         }
 #endif
@@ -10813,6 +11475,7 @@ void assignValue(FlowState *flowState, int componentIndex, Value &dstValue, cons
         }
         if (assignValue(*pDstValue, srcValue, dstValueType)) {
             onValueChanged(pDstValue);
+            onVariableAssigned(flowState, pDstValue);
         } else {
             char errorMessage[100];
             snprintf(errorMessage, sizeof(errorMessage), "Can not assign %s to %s\n",
@@ -11056,53 +11719,160 @@ namespace flow {
 #if !defined(EEZ_FLOW_QUEUE_SIZE)
 #define EEZ_FLOW_QUEUE_SIZE 1000
 #endif
+#if !defined(EEZ_FLOW_TASK_AGING_MS)
+#define EEZ_FLOW_TASK_AGING_MS 20
+#endif
 static const unsigned QUEUE_SIZE = EEZ_FLOW_QUEUE_SIZE;
+static_assert(QUEUE_SIZE < QUEUE_NO_TASK, "EEZ_FLOW_QUEUE_SIZE is too large");
+static const uint32_t TASK_AGING_US = EEZ_FLOW_TASK_AGING_MS * 1000;
 static struct {
 	FlowState *flowState;
-	unsigned componentIndex;
+	uint16_t componentIndex;
     bool continuousTask;
+    uint8_t priority;
+    uint16_t nextTask;
+    uint16_t previousFlowStateTask;
+    uint16_t nextFlowStateTask;
+    uint16_t addedInTick;
+    uint32_t addedAt;
 } g_queue[QUEUE_SIZE];
-static unsigned g_queueHead;
-static unsigned g_queueTail;
+// Every priority has its own FIFO list of tasks in g_queue, the unused entries are in the free list
+static struct {
+    uint16_t firstTask;
+    uint16_t lastTask;
+    uint32_t lastExecutedAt;
+    unsigned numContinuousInTick;
+    TaskPriorityStats stats;
+} g_priorities[NUM_TASK_PRIORITIES];
+static uint16_t g_firstFreeTask;
+static uint16_t g_queueTick;
+static unsigned g_queueSize;
 static unsigned g_queueMax;
-static bool g_queueIsFull = false;
+static unsigned g_nextTaskPriority;
+static bool g_nextTaskAged;
+static uint32_t g_taskStartTime;
+static QueueStats g_queueStats;
 unsigned g_numNonContinuousTaskInQueue;
+TaskPriority g_currentTaskPriority = NUM_TASK_PRIORITIES;
 void queueReset() {
-	g_queueHead = 0;
-	g_queueTail = 0;
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+        g_queue[i].nextTask = i + 1 < QUEUE_SIZE ? i + 1 : QUEUE_NO_TASK;
+    }
+    g_firstFreeTask = 0;
+    for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+        g_priorities[priority].firstTask = QUEUE_NO_TASK;
+        g_priorities[priority].lastTask = QUEUE_NO_TASK;
+        g_priorities[priority].numContinuousInTick = 0;
+        g_priorities[priority].stats.size = 0;
+    }
+	g_queueSize = 0;
 	g_queueMax  = 0;
-	g_queueIsFull = false;
     g_numNonContinuousTaskInQueue = 0;
+    g_currentTaskPriority = NUM_TASK_PRIORITIES;
+    resetQueueStats();
+}
+void queueStartTick() {
+    g_queueTick++;
+    for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+        g_priorities[priority].numContinuousInTick = 0;
+    }
 }
 size_t getQueueSize() {
-	if (g_queueHead == g_queueTail) {
-		if (g_queueIsFull) {
-			return QUEUE_SIZE;
-		}
-		return 0;
-	}
-	if (g_queueHead < g_queueTail) {
-		return g_queueTail - g_queueHead;
-	}
-	return QUEUE_SIZE - g_queueHead + g_queueTail;
+	return g_queueSize;
 }
 size_t getMaxQueueSize() {
 	return g_queueMax;
 }
+void getQueueStats(QueueStats &stats) {
+    stats = g_queueStats;
+    stats.size = getQueueSize();
+    stats.maxSize = g_queueMax;
+}
+void resetQueueStats() {
+    g_queueMax = getQueueSize();
+    g_queueStats.numAdded = 0;
+    g_queueStats.numOverflows = 0;
+    g_queueStats.numRemovedForFlowState = 0;
+    for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+        auto &stats = g_priorities[priority].stats;
+        auto size = stats.size;
+        memset(&stats, 0, sizeof(stats));
+        stats.size = size;
+        stats.maxSize = size;
+    }
+}
+void getTaskPriorityStats(TaskPriorityStats *stats) {
+    for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+        stats[priority] = g_priorities[priority].stats;
+    }
+}
+static TaskPriority getComponentTaskPriority(FlowState *flowState, unsigned componentIndex, bool continuousTask) {
+    auto componentType = flowState->flow->components[componentIndex]->type;
+    switch (componentType) {
+    case defs_v3::COMPONENT_TYPE_ON_EVENT_ACTION:
+        return TASK_PRIORITY_INPUT;
+    case defs_v3::COMPONENT_TYPE_YT_GRAPH_WIDGET:
+    case defs_v3::COMPONENT_TYPE_LIST_GRAPH_WIDGET:
+    case defs_v3::COMPONENT_TYPE_LINE_CHART_EMBEDDED_WIDGET:
+    case defs_v3::COMPONENT_TYPE_MQTT_INIT_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_CONNECT_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_DISCONNECT_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_EVENT_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_SUBSCRIBE_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_UNSUBSCRIBE_ACTION:
+    case defs_v3::COMPONENT_TYPE_MQTT_PUBLISH_ACTION:
+        return TASK_PRIORITY_BACKGROUND;
+    default:
+        // The rest of the flow started by an LVGL event is executed before the UI updates
+        if (!continuousTask && g_currentTaskPriority == TASK_PRIORITY_INPUT) {
+            return TASK_PRIORITY_INPUT;
+        }
+        return TASK_PRIORITY_UI_UPDATE;
+    }
+}
 bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex, bool continuousTask) {
-	if (g_queueIsFull) {
+	if (g_firstFreeTask == QUEUE_NO_TASK) {
+        g_queueStats.numOverflows++;
         throwError(flowState, componentIndex, "Execution queue is full\n");
 		return false;
 	}
-	g_queue[g_queueTail].flowState = flowState;
-	g_queue[g_queueTail].componentIndex = componentIndex;
-    g_queue[g_queueTail].continuousTask = continuousTask;
-	g_queueTail = (g_queueTail + 1) % QUEUE_SIZE;
-	if (g_queueHead == g_queueTail) {
-		g_queueIsFull = true;
-	}
-	size_t queueSize = getQueueSize();
-	g_queueMax = g_queueMax < queueSize ? queueSize : g_queueMax;
+    auto priority = getComponentTaskPriority(flowState, componentIndex, continuousTask);
+    auto task = g_firstFreeTask;
+    g_firstFreeTask = g_queue[task].nextTask;
+	g_queue[task].flowState = flowState;
+	g_queue[task].componentIndex = componentIndex;
+    g_queue[task].continuousTask = continuousTask;
+    g_queue[task].priority = priority;
+    g_queue[task].nextTask = QUEUE_NO_TASK;
+    g_queue[task].addedInTick = g_queueTick;
+    g_queue[task].addedAt = micros();
+    auto &queuePriority = g_priorities[priority];
+    if (continuousTask) {
+        queuePriority.numContinuousInTick++;
+    }
+    if (queuePriority.lastTask != QUEUE_NO_TASK) {
+        g_queue[queuePriority.lastTask].nextTask = task;
+    } else {
+        queuePriority.firstTask = task;
+        queuePriority.lastExecutedAt = g_queue[task].addedAt;
+    }
+    queuePriority.lastTask = task;
+    // The tasks of a flow state are linked, so isInQueue and removeTasksFromQueueForFlowState don't scan the queue
+    g_queue[task].previousFlowStateTask = flowState->lastQueueTask;
+    g_queue[task].nextFlowStateTask = QUEUE_NO_TASK;
+    if (flowState->lastQueueTask != QUEUE_NO_TASK) {
+        g_queue[flowState->lastQueueTask].nextFlowStateTask = task;
+    } else {
+        flowState->firstQueueTask = task;
+    }
+    flowState->lastQueueTask = task;
+    flowState->componentQueueCounters[componentIndex]++;
+    g_queueSize++;
+	g_queueMax = g_queueMax < g_queueSize ? g_queueSize : g_queueMax;
+    auto &stats = queuePriority.stats;
+    stats.size++;
+    stats.maxSize = stats.maxSize < stats.size ? stats.size : stats.maxSize;
+    g_queueStats.numAdded++;
     if (!continuousTask) {
         ++g_numNonContinuousTaskInQueue;
 	    onAddToQueue(flowState, sourceComponentIndex, sourceOutputIndex, componentIndex, targetInputIndex);
@@ -11110,56 +11880,486 @@ bool addToQueue(FlowState *flowState, unsigned componentIndex, int sourceCompone
     incRefCounterForFlowState(flowState);
 	return true;
 }
+static bool isContinuousTaskOfTick(uint16_t task) {
+    return g_queue[task].continuousTask && g_queue[task].addedInTick == g_queueTick;
+}
+// A continuous task (Delay, Animate, LVGL, ...) adds itself again when it is executed. It is executed
+// once per tick, so the continuous tasks added in this tick are moved behind the other tasks of their
+// priority. Returns false if the priority has no other tasks.
+static bool skipContinuousTasksOfTick(unsigned priority) {
+    auto &queuePriority = g_priorities[priority];
+    if (queuePriority.stats.size == queuePriority.numContinuousInTick) {
+        return false;
+    }
+    for (size_t i = 0; i < queuePriority.stats.size && isContinuousTaskOfTick(queuePriority.firstTask); i++) {
+        auto task = queuePriority.firstTask;
+        queuePriority.firstTask = g_queue[task].nextTask;
+        g_queue[queuePriority.lastTask].nextTask = task;
+        g_queue[task].nextTask = QUEUE_NO_TASK;
+        queuePriority.lastTask = task;
+    }
+    return true;
+}
 bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool &continuousTask) {
-	if (g_queueHead == g_queueTail && !g_queueIsFull) {
+    // The first task with the highest priority is executed, unless a task with a lower priority is
+    // waiting for longer than EEZ_FLOW_TASK_AGING_MS since the last one of its priority was executed
+    g_nextTaskPriority = NUM_TASK_PRIORITIES;
+    g_nextTaskAged = false;
+    uint32_t now = 0;
+    for (unsigned priority = 0; priority < NUM_TASK_PRIORITIES; priority++) {
+        auto &queuePriority = g_priorities[priority];
+        if (!skipContinuousTasksOfTick(priority)) {
+            continue;
+        }
+        if (g_nextTaskPriority == NUM_TASK_PRIORITIES) {
+            g_nextTaskPriority = priority;
+            now = micros();
+        } else if (now - queuePriority.lastExecutedAt >= TASK_AGING_US) {
+            g_nextTaskPriority = priority;
+            g_nextTaskAged = true;
+            break;
+        }
+    }
+    if (g_nextTaskPriority == NUM_TASK_PRIORITIES) {
 		return false;
 	}
-	flowState = g_queue[g_queueHead].flowState;
-	componentIndex = g_queue[g_queueHead].componentIndex;
-    continuousTask = g_queue[g_queueHead].continuousTask;
+    auto task = g_priorities[g_nextTaskPriority].firstTask;
+	flowState = g_queue[task].flowState;
+	componentIndex = g_queue[task].componentIndex;
+    continuousTask = g_queue[task].continuousTask;
 	return true;
 }
 void removeNextTaskFromQueue() {
-	auto flowState = g_queue[g_queueHead].flowState;
-    decRefCounterForFlowState(flowState);
-    auto continuousTask = g_queue[g_queueHead].continuousTask;
-	g_queueHead = (g_queueHead + 1) % QUEUE_SIZE;
-	g_queueIsFull = false;
+    auto &queuePriority = g_priorities[g_nextTaskPriority];
+    auto task = queuePriority.firstTask;
+	auto flowState = g_queue[task].flowState;
+    if (flowState) {
+        auto previousTask = g_queue[task].previousFlowStateTask;
+        auto nextTask = g_queue[task].nextFlowStateTask;
+        if (previousTask != QUEUE_NO_TASK) {
+            g_queue[previousTask].nextFlowStateTask = nextTask;
+        } else {
+            flowState->firstQueueTask = nextTask;
+        }
+        if (nextTask != QUEUE_NO_TASK) {
+            g_queue[nextTask].previousFlowStateTask = previousTask;
+        } else {
+            flowState->lastQueueTask = previousTask;
+        }
+        flowState->componentQueueCounters[g_queue[task].componentIndex]--;
+        decRefCounterForFlowState(flowState);
+        g_currentTaskPriority = (TaskPriority)g_nextTaskPriority;
+    }
+    auto now = micros();
+    if (flowState) {
+        auto latency = now - g_queue[task].addedAt;
+        queuePriority.stats.totalLatency += latency;
+        queuePriority.stats.maxLatency = queuePriority.stats.maxLatency < latency ? latency : queuePriority.stats.maxLatency;
+    }
+    auto continuousTask = g_queue[task].continuousTask;
+    if (g_nextTaskAged) {
+        queuePriority.stats.numAged++;
+    }
+    queuePriority.lastExecutedAt = now;
+    g_taskStartTime = now;
+    queuePriority.stats.size--;
+    queuePriority.firstTask = g_queue[task].nextTask;
+    if (queuePriority.firstTask == QUEUE_NO_TASK) {
+        queuePriority.lastTask = QUEUE_NO_TASK;
+    }
+    g_queue[task].nextTask = g_firstFreeTask;
+    g_firstFreeTask = task;
+    g_queueSize--;
     if (!continuousTask) {
         --g_numNonContinuousTaskInQueue;
 	    onRemoveFromQueue();
     }
 }
+void onTaskExecuted() {
+    if (g_currentTaskPriority < NUM_TASK_PRIORITIES) {
+        auto &stats = g_priorities[g_currentTaskPriority].stats;
+        stats.numExecuted++;
+        stats.executionTime += micros() - g_taskStartTime;
+    }
+    g_currentTaskPriority = NUM_TASK_PRIORITIES;
+}
 bool isInQueue(FlowState *flowState, unsigned componentIndex) {
-	if (g_queueHead == g_queueTail && !g_queueIsFull) {
-		return false;
-	}
-    unsigned int it = g_queueHead;
-    while (true) {
-		if (g_queue[it].flowState == flowState && g_queue[it].componentIndex == componentIndex) {
+    return flowState->componentQueueCounters[componentIndex] != 0;
+}
+void removeTasksFromQueueForFlowState(FlowState *flowState) {
+    // The tasks stay in the queue without a flow state until they are removed by the tick
+    for (auto it = flowState->firstQueueTask; it != QUEUE_NO_TASK; it = g_queue[it].nextFlowStateTask) {
+        g_queue[it].flowState = nullptr;
+        flowState->componentQueueCounters[g_queue[it].componentIndex]--;
+        decRefCounterForFlowState(flowState);
+        g_queueStats.numRemovedForFlowState++;
+    }
+    flowState->firstQueueTask = QUEUE_NO_TASK;
+    flowState->lastQueueTask = QUEUE_NO_TASK;
+}
+} 
+} 
+// -----------------------------------------------------------------------------
+// flow/profiler.cpp
+// -----------------------------------------------------------------------------
+#if EEZ_OPTION_FLOW_PROFILER
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#if defined(ESP_PLATFORM)
+#include <esp_cpu.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+namespace eez {
+namespace flow {
+uint64_t g_profilerAllocBytes;
+static FlowDefinition *g_profilerFlowDefinition;
+static ComponentProfile **g_flowProfiles;
+static ProfilerSortColumn g_profilerSortColumn;
+struct ProfilerRow {
+    int flowIndex;
+    int componentIndex;
+    ComponentProfile profile;
+};
+uint32_t getProfilerCycles() {
+#if defined(ESP_PLATFORM)
+    return esp_cpu_get_cycle_count();
+#elif defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    return micros();
+#endif
+}
+// The memory of the profiler doesn't count in the allocation bytes of the profiled component
+static void *profilerAlloc(size_t size, uint32_t id) {
+    auto allocBytes = g_profilerAllocBytes;
+    auto ptr = alloc(size, id);
+    g_profilerAllocBytes = allocBytes;
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+ProfilerStats *getProfilerStats(FlowState *flowState, int componentIndex, ProfilerCounter counter) {
+    if (!flowState || componentIndex < 0 || (uint32_t)componentIndex >= flowState->flow->components.count) {
+        return nullptr;
+    }
+    if (!g_flowProfiles) {
+        g_profilerFlowDefinition = flowState->flowDefinition;
+        g_flowProfiles = (ComponentProfile **)profilerAlloc(g_profilerFlowDefinition->flows.count * sizeof(ComponentProfile *), 0x3a6e2f10);
+        if (!g_flowProfiles) {
+            return nullptr;
+        }
+    }
+    if (flowState->flowDefinition != g_profilerFlowDefinition || flowState->flowIndex >= g_profilerFlowDefinition->flows.count) {
+        return nullptr;
+    }
+    auto &profiles = g_flowProfiles[flowState->flowIndex];
+    if (!profiles) {
+        profiles = (ComponentProfile *)profilerAlloc(flowState->flow->components.count * sizeof(ComponentProfile), 0x5c81d4a7);
+        if (!profiles) {
+            return nullptr;
+        }
+    }
+    return &profiles[componentIndex].counters[counter];
+}
+void profilerReset() {
+    if (g_flowProfiles) {
+        for (uint32_t flowIndex = 0; flowIndex < g_profilerFlowDefinition->flows.count; flowIndex++) {
+            free(g_flowProfiles[flowIndex]);
+        }
+        free(g_flowProfiles);
+        g_flowProfiles = nullptr;
+    }
+    g_profilerFlowDefinition = nullptr;
+}
+static void addProfilerStats(ProfilerStats &total, const ProfilerStats &stats) {
+    total.numCalls += stats.numCalls;
+    total.totalCycles += stats.totalCycles;
+    total.maxCycles = total.maxCycles < stats.maxCycles ? stats.maxCycles : total.maxCycles;
+    total.allocBytes += stats.allocBytes;
+}
+static uint64_t getSortKey(const ProfilerRow *row) {
+    auto &stats = row->profile.counters[g_profilerSortColumn < PROFILER_SORT_BY_EVAL_CALLS ? PROFILER_COUNTER_EXECUTE : PROFILER_COUNTER_EVAL];
+    switch (g_profilerSortColumn % 4) {
+    case PROFILER_SORT_BY_CALLS:
+        return stats.numCalls;
+    case PROFILER_SORT_BY_TOTAL_CYCLES:
+        return stats.totalCycles;
+    case PROFILER_SORT_BY_MAX_CYCLES:
+        return stats.maxCycles;
+    default:
+        return stats.allocBytes;
+    }
+}
+static int compareProfilerRows(const void *a, const void *b) {
+    auto aKey = getSortKey((const ProfilerRow *)a);
+    auto bKey = getSortKey((const ProfilerRow *)b);
+    return aKey > bKey ? -1 : aKey < bKey ? 1 : 0;
+}
+void writeProfile(ProfilerSortColumn sortColumn, ProfilerWriteRowFunc writeRow, void *param) {
+    if (!g_flowProfiles) {
+        return;
+    }
+    auto flowDefinition = g_profilerFlowDefinition;
+    uint32_t numRows = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        if (g_flowProfiles[flowIndex]) {
+            numRows += 1 + flowDefinition->flows[flowIndex]->components.count;
+        }
+    }
+    auto rows = (ProfilerRow *)profilerAlloc(numRows * sizeof(ProfilerRow), 0x91d0b3e5);
+    if (!rows) {
+        return;
+    }
+    // The components which were profiled and a row with the totals of every flow, with -1 as the component index
+    numRows = 0;
+    for (uint32_t flowIndex = 0; flowIndex < flowDefinition->flows.count; flowIndex++) {
+        auto profiles = g_flowProfiles[flowIndex];
+        if (!profiles) {
+            continue;
+        }
+        auto &total = rows[numRows++];
+        memset(&total, 0, sizeof(total));
+        total.flowIndex = flowIndex;
+        total.componentIndex = -1;
+        for (uint32_t componentIndex = 0; componentIndex < flowDefinition->flows[flowIndex]->components.count; componentIndex++) {
+            auto &profile = profiles[componentIndex];
+            if (profile.counters[PROFILER_COUNTER_EXECUTE].numCalls == 0 && profile.counters[PROFILER_COUNTER_EVAL].numCalls == 0) {
+                continue;
+            }
+            addProfilerStats(total.profile.counters[PROFILER_COUNTER_EXECUTE], profile.counters[PROFILER_COUNTER_EXECUTE]);
+            addProfilerStats(total.profile.counters[PROFILER_COUNTER_EVAL], profile.counters[PROFILER_COUNTER_EVAL]);
+            auto &row = rows[numRows++];
+            row.flowIndex = flowIndex;
+            row.componentIndex = componentIndex;
+            row.profile = profile;
+        }
+    }
+    g_profilerSortColumn = sortColumn;
+    qsort(rows, numRows, sizeof(ProfilerRow), compareProfilerRows);
+    for (uint32_t i = 0; i < numRows; i++) {
+        auto &row = rows[i];
+        auto &execute = row.profile.counters[PROFILER_COUNTER_EXECUTE];
+        auto &eval = row.profile.counters[PROFILER_COUNTER_EVAL];
+        int componentType = row.componentIndex == -1 ? 0 : flowDefinition->flows[row.flowIndex]->components[row.componentIndex]->type;
+        char buffer[256];
+        int length = snprintf(buffer, sizeof(buffer),
+            "%d\t%d\t%d\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu32 "\t%" PRIu64 "\n",
+            row.flowIndex, row.componentIndex, componentType,
+            execute.numCalls, execute.totalCycles, execute.maxCycles, execute.allocBytes,
+            eval.numCalls, eval.totalCycles, eval.maxCycles, eval.allocBytes
+        );
+        writeRow(param, buffer, length);
+    }
+    free(rows);
+}
+#if !defined(ESP_PLATFORM)
+static void writeProfileRowToFile(void *param, const char *row, size_t rowLength) {
+    fwrite(row, 1, rowLength, (FILE *)param);
+}
+bool dumpProfile(const char *filePath, ProfilerSortColumn sortColumn) {
+    auto file = fopen(filePath, "w");
+    if (!file) {
+        return false;
+    }
+    fputs("flow\tcomponent\ttype\tcalls\tcycles\tmax_cycles\talloc_bytes\teval_calls\teval_cycles\teval_max_cycles\teval_alloc_bytes\n", file);
+    writeProfile(sortColumn, writeProfileRowToFile, file);
+    return fclose(file) == 0;
+}
+#endif
+} 
+} 
+#endif
+// -----------------------------------------------------------------------------
+// flow/dependencies.cpp
+// -----------------------------------------------------------------------------
+namespace eez {
+namespace flow {
+static uint32_t g_variablesStamp;
+static uint32_t g_allVariablesStamp;
+static uint32_t g_globalVariableStamps[32];
+#if !defined(EEZ_FLOW_MAX_VERSIONED_NATIVE_VARIABLES)
+#define EEZ_FLOW_MAX_VERSIONED_NATIVE_VARIABLES 8
+#endif
+#if !EEZ_OPTION_GUI
+static struct {
+    uint32_t globalVariableIndex;
+    const uint32_t *version;
+    uint32_t seenVersion;
+} g_versionedNativeVariables[EEZ_FLOW_MAX_VERSIONED_NATIVE_VARIABLES];
+static unsigned g_numVersionedNativeVariables;
+#endif
+static uint32_t variableBit(uint32_t variableIndex) {
+    return 1u << (variableIndex & 31);
+}
+static bool isStampNewer(uint32_t stamp, uint32_t sinceStamp) {
+    return (int32_t)(stamp - sinceStamp) > 0;
+}
+static uint32_t nextVariablesStamp() {
+    if (++g_variablesStamp == 0) {
+        ++g_variablesStamp;
+    }
+    return g_variablesStamp;
+}
+#if !EEZ_OPTION_GUI
+// Native variables with a version counter are tracked like the global variables, the others are polled
+static bool trackNativeVariable(uint32_t globalVariableIndex, int nativeVariableId) {
+    auto version = g_nativeVars[nativeVariableId].version;
+    if (!version) {
+        return false;
+    }
+    for (unsigned i = 0; i < g_numVersionedNativeVariables; i++) {
+        if (g_versionedNativeVariables[i].globalVariableIndex == globalVariableIndex) {
             return true;
-		}
-        it = (it + 1) % QUEUE_SIZE;
-        if (it == g_queueTail) {
+        }
+    }
+    if (g_numVersionedNativeVariables == EEZ_FLOW_MAX_VERSIONED_NATIVE_VARIABLES) {
+        return false;
+    }
+    auto &versionedNativeVariable = g_versionedNativeVariables[g_numVersionedNativeVariables++];
+    versionedNativeVariable.globalVariableIndex = globalVariableIndex;
+    versionedNativeVariable.version = version;
+    versionedNativeVariable.seenVersion = *version;
+    return true;
+}
+#endif
+static bool isVolatileOperation(uint16_t operation) {
+    switch (operation) {
+    case defs_v3::OPERATION_TYPE_SYSTEM_GET_TICK:
+    case defs_v3::OPERATION_TYPE_FLOW_INDEX:
+    case defs_v3::OPERATION_TYPE_FLOW_IS_PAGE_ACTIVE:
+    case defs_v3::OPERATION_TYPE_FLOW_PAGE_TIMELINE_POSITION:
+    case defs_v3::OPERATION_TYPE_FLOW_LANGUAGES:
+    case defs_v3::OPERATION_TYPE_FLOW_TRANSLATE:
+    case defs_v3::OPERATION_TYPE_FLOW_THEMES:
+    case defs_v3::OPERATION_TYPE_DATE_NOW:
+    case defs_v3::OPERATION_TYPE_LVGL_METER_TICK_INDEX:
+    case defs_v3::OPERATION_TYPE_JSON_GET:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_CODE:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_CURRENT_TARGET:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_TARGET:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_USER_DATA:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_KEY:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_GESTURE_DIR:
+    case defs_v3::OPERATION_TYPE_EVENT_GET_ROTARY_DIFF:
+        return true;
+    default:
+        return false;
+    }
+}
+void scanDependencies(FlowState *flowState, const uint8_t *instructions, uint32_t &globalVariablesMask, uint32_t &localVariablesMask, bool &poll) {
+    auto flow = flowState->flow;
+    globalVariablesMask = 0;
+    localVariablesMask = 0;
+    poll = false;
+    for (int i = 0; ; i += 2) {
+		uint16_t instruction = instructions[i] + (instructions[i + 1] << 8);
+		auto instructionType = instruction & EXPR_EVAL_INSTRUCTION_TYPE_MASK;
+		auto instructionArg = instruction & EXPR_EVAL_INSTRUCTION_PARAM_MASK;
+        if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_END) {
             break;
         }
-	}
+        if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_LOCAL_VAR) {
+            auto valueType = flowState->values[flow->componentInputs.count + instructionArg].getType();
+            if (valueType == VALUE_TYPE_PROPERTY_REF || valueType == VALUE_TYPE_VALUE_PTR) {
+                poll = true;
+            } else {
+                localVariablesMask |= variableBit(instructionArg);
+            }
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR) {
+            if ((uint32_t)instructionArg < flowState->flowDefinition->globalVariables.count) {
+                globalVariablesMask |= variableBit(instructionArg);
+#if !EEZ_OPTION_GUI
+            } else if (trackNativeVariable(instructionArg, instructionArg - flowState->flowDefinition->globalVariables.count + 1)) {
+                globalVariablesMask |= variableBit(instructionArg);
+#endif
+            } else {
+                poll = true;
+            }
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_INPUT || instructionType == EXPR_EVAL_INSTRUCTION_TYPE_PUSH_OUTPUT) {
+            poll = true;
+        } else if (instructionType == EXPR_EVAL_INSTRUCTION_TYPE_OPERATION) {
+            if (isVolatileOperation(instructionArg)) {
+                poll = true;
+            }
+        }
+    }
+}
+bool dependenciesChanged(FlowState *flowState, uint32_t globalVariablesMask, uint32_t localVariablesMask, uint32_t &stamp) {
+    auto sinceStamp = stamp;
+    stamp = g_variablesStamp;
+    if (!isStampNewer(g_variablesStamp, sinceStamp)) {
+        return false;
+    }
+    if (isStampNewer(g_allVariablesStamp, sinceStamp)) {
+        return true;
+    }
+    for (uint32_t i = 0; globalVariablesMask; i++, globalVariablesMask >>= 1) {
+        if ((globalVariablesMask & 1) && isStampNewer(g_globalVariableStamps[i], sinceStamp)) {
+            return true;
+        }
+    }
+    if (localVariablesMask) {
+        auto flow = flowState->flow;
+        for (uint32_t i = 0; i < flow->localVariables.count; i++) {
+            if ((localVariablesMask & variableBit(i)) && isStampNewer(flowState->localVariableStamps[i], sinceStamp)) {
+                return true;
+            }
+        }
+    }
     return false;
 }
-void removeTasksFromQueueForFlowState(FlowState *flowState) {
-	if (g_queueHead == g_queueTail && !g_queueIsFull) {
-		return;
-	}
-    unsigned int it = g_queueHead;
-    while (true) {
-		if (g_queue[it].flowState == flowState) {
-            g_queue[it].flowState = 0;
-		}
-        it = (it + 1) % QUEUE_SIZE;
-        if (it == g_queueTail) {
-            break;
+void onVariableAssigned(FlowState *flowState, const Value *pValue) {
+    nextVariablesStamp();
+    if (!pValue) {
+        g_allVariablesStamp = g_variablesStamp;
+        return;
+    }
+    if (g_globalVariables) {
+        if (pValue >= g_globalVariables->values && pValue < g_globalVariables->values + g_globalVariables->count) {
+            g_globalVariableStamps[(pValue - g_globalVariables->values) & 31] = g_variablesStamp;
+            return;
         }
-	}
+    } else if (g_mainAssets) {
+        auto &globalVariables = g_mainAssets->flowDefinition->globalVariables;
+        for (uint32_t i = 0; i < globalVariables.count; i++) {
+            if (globalVariables[i] == pValue) {
+                g_globalVariableStamps[i & 31] = g_variablesStamp;
+                return;
+            }
+        }
+    }
+    if (flowState) {
+        auto localVariables = flowState->values + flowState->flow->componentInputs.count;
+        if (pValue >= localVariables && pValue < localVariables + flowState->flow->localVariables.count) {
+            flowState->localVariableStamps[pValue - localVariables] = g_variablesStamp;
+            return;
+        }
+    }
+    g_allVariablesStamp = g_variablesStamp;
+}
+void checkNativeVariableVersions() {
+#if !EEZ_OPTION_GUI
+    for (unsigned i = 0; i < g_numVersionedNativeVariables; i++) {
+        auto &versionedNativeVariable = g_versionedNativeVariables[i];
+        auto version = *versionedNativeVariable.version;
+        if (version != versionedNativeVariable.seenVersion) {
+            versionedNativeVariable.seenVersion = version;
+            g_globalVariableStamps[versionedNativeVariable.globalVariableIndex & 31] = nextVariablesStamp();
+        }
+    }
+#endif
+}
+void dependenciesReset() {
+#if !EEZ_OPTION_GUI
+    // The global variable indexes are the ones of the stopped flow, so they are tracked again when read
+    g_numVersionedNativeVariables = 0;
+#endif
+}
+uint32_t getVariablesStamp() {
+    return g_variablesStamp;
 }
 } 
 } 
@@ -11172,6 +12372,11 @@ void executeWatchVariableComponent(FlowState *flowState, unsigned componentIndex
 struct WatchListNode {
     FlowState *flowState;
     unsigned componentIndex;
+    uint32_t globalVariablesMask;
+    uint32_t localVariablesMask;
+    uint32_t stamp;
+    bool poll;
+    bool dirty;
     WatchListNode *prev;
     WatchListNode *next;
 };
@@ -11194,6 +12399,14 @@ WatchListNode *watchListAdd(FlowState *flowState, unsigned componentIndex) {
     node->next = 0;
     node->flowState = flowState;
     node->componentIndex = componentIndex;
+    auto component = flowState->flow->components[componentIndex];
+    if (component->properties.count > defs_v3::WATCH_VARIABLE_ACTION_COMPONENT_PROPERTY_VARIABLE) {
+        scanDependencies(flowState, component->properties[defs_v3::WATCH_VARIABLE_ACTION_COMPONENT_PROPERTY_VARIABLE]->evalInstructions, node->globalVariablesMask, node->localVariablesMask, node->poll);
+    } else {
+        node->poll = true;
+    }
+    node->stamp = getVariablesStamp();
+    node->dirty = false;
     incRefCounterForFlowState(flowState);
     (g_watchList.size)++;
     return node;
@@ -11215,7 +12428,11 @@ void watchListRemove(WatchListNode *node) {
 void visitWatchList() {
     for (auto node = g_watchList.first; node; ) {
         auto nextNode = node->next;
-        if (canExecuteStep(node->flowState, node->componentIndex)) {
+        if (dependenciesChanged(node->flowState, node->globalVariablesMask, node->localVariablesMask, node->stamp)) {
+            node->dirty = true;
+        }
+        if ((node->poll || node->dirty) && canExecuteStep(node->flowState, node->componentIndex)) {
+            node->dirty = false;
             executeWatchVariableComponent(node->flowState, node->componentIndex);
         }
         decRefCounterForFlowState(node->flowState);
@@ -82,6 +82,9 @@
 #ifndef EEZ_FOR_LVGL_SHA256_OPTION
 #define EEZ_FOR_LVGL_SHA256_OPTION 1
 #endif
+#ifndef EEZ_OPTION_FLOW_PROFILER
+#define EEZ_OPTION_FLOW_PROFILER 0
+#endif
 #define EEZ_UNUSED(x) (void)(x)
 #ifdef __cplusplus
 
@@ -190,6 +193,7 @@ Unit getSmallestUnit(Unit unit, float min, float precision);
     VALUE_TYPE(JSON_MEMBER_VALUE)                   \
     VALUE_TYPE(EVENT)                               \
     VALUE_TYPE(PROPERTY_REF)                        \
+    VALUE_TYPE(STRING_SMALL)                        \
     CUSTOM_VALUE_TYPES
 namespace eez {
 #define VALUE_TYPE(NAME) VALUE_TYPE_##NAME,
@@ -221,10 +225,18 @@ template<class T> struct ObjectAllocator {
 		free(ptr);
 	}
 };
+static const size_t NUM_ALLOC_POOLS = 8;
+struct AllocPoolInfo {
+    uint32_t blockSize;
+    uint32_t numBlocks;
+    uint32_t numUsed;
+    uint32_t maxUsed;
+};
 #if OPTION_SCPI
 void dumpAlloc(scpi_t *context);
 #endif
 void getAllocInfo(uint32_t &free, uint32_t &alloc);
+void getAllocPoolInfo(AllocPoolInfo *pools);
 } 
 // -----------------------------------------------------------------------------
 // flow/flow_defs_v3.h
@@ -904,6 +916,7 @@ typedef void (*CopyValueFunction)(Value &a, const Value &b);
 extern CompareValueFunction g_valueTypeCompareFunctions[];
 extern ValueToTextFunction g_valueTypeToTextFunctions[];
 extern ValueTypeNameFunction g_valueTypeNames[];
+static const size_t SMALL_STRING_SIZE = 12;
 struct PairOfUint8Value {
     uint8_t first;
     uint8_t second;
@@ -1144,7 +1157,7 @@ struct Value {
 		return type == VALUE_TYPE_BOOLEAN;
 	}
 	bool isString() const {
-        return type == VALUE_TYPE_STRING || type == VALUE_TYPE_STRING_ASSET || type == VALUE_TYPE_STRING_REF;
+        return type == VALUE_TYPE_STRING || type == VALUE_TYPE_STRING_ASSET || type == VALUE_TYPE_STRING_REF || type == VALUE_TYPE_STRING_SMALL;
     }
     bool isArray() const {
         return type == VALUE_TYPE_ARRAY || type == VALUE_TYPE_ARRAY_ASSET || type == VALUE_TYPE_ARRAY_REF;
@@ -1197,6 +1210,8 @@ struct Value {
 	double getDouble() const {
 		return doubleValue;
 	}
+	// Points into this value or into what it references. The small string of a native variable or of a property
+	// is a copy kept until the end of the flow tick at least.
 	const char *getString() const;
     const ArrayValue *getArray() const;
     ArrayValue *getArray();
@@ -1439,6 +1454,10 @@ inline Value FloatValue(float value) { return Value(value, VALUE_TYPE_FLOAT); }
 inline Value DoubleValue(double value) { return Value(value, VALUE_TYPE_DOUBLE); }
 inline Value BooleanValue(bool value) { return Value(value, VALUE_TYPE_BOOLEAN); }
 inline Value StringValue(const char *value) { return Value::makeStringRef(value, -1, 0); }
+void internString(const char *str);
+void resetInternedStrings();
+const char *internSmallString(const char *str);
+void releaseSmallStrings(bool all);
 template<class T, uint32_t ARRAY_TYPE>
 struct ArrayOf {
     Value value;
@@ -2022,6 +2041,7 @@ enum TestResult {
 	TEST_WARNING
 };
 uint32_t millis();
+uint32_t micros();
 extern bool g_shutdown;
 void shutdown();
 } 
@@ -2326,7 +2346,11 @@ struct FlowState {
     Value inputValue;
     Value *values;
 	ComponenentExecutionState **componenentExecutionStates;
+    uint16_t *componentQueueCounters;
     bool *componenentAsyncStates;
+    uint16_t firstQueueTask;
+    uint16_t lastQueueTask;
+    uint32_t *localVariableStamps;
     unsigned executingComponentIndex;
     float timelinePosition;
 #if defined(EEZ_FOR_LVGL)
@@ -2725,20 +2749,121 @@ Value op_great_eq(const Value& a1, const Value& b1);
 // -----------------------------------------------------------------------------
 namespace eez {
 namespace flow {
+static const uint16_t QUEUE_NO_TASK = 0xFFFF;
+struct QueueStats {
+    size_t size;
+    size_t maxSize;
+    uint32_t numAdded;
+    uint32_t numOverflows;
+    uint32_t numRemovedForFlowState;
+};
+enum TaskPriority {
+    TASK_PRIORITY_INPUT,
+    TASK_PRIORITY_UI_UPDATE,
+    TASK_PRIORITY_BACKGROUND,
+    NUM_TASK_PRIORITIES
+};
+struct TaskPriorityStats {
+    size_t size;
+    size_t maxSize;
+    uint32_t numExecuted;
+    uint32_t numAged;
+    uint64_t executionTime;
+    uint64_t totalLatency;
+    uint32_t maxLatency;
+};
 void queueReset();
+void queueStartTick();
 size_t getQueueSize();
 size_t getMaxQueueSize();
+void getQueueStats(QueueStats &stats);
+void resetQueueStats();
+void getTaskPriorityStats(TaskPriorityStats *stats);
 extern unsigned g_numNonContinuousTaskInQueue;
+extern TaskPriority g_currentTaskPriority;
 bool addToQueue(FlowState *flowState, unsigned componentIndex,
     int sourceComponentIndex, int sourceOutputIndex, int targetInputIndex,
     bool continuousTask);
 bool peekNextTaskFromQueue(FlowState *&flowState, unsigned &componentIndex, bool &continuousTask);
 void removeNextTaskFromQueue();
+void onTaskExecuted();
 bool isInQueue(FlowState *flowState, unsigned componentIndex);
 void removeTasksFromQueueForFlowState(FlowState *flowState);
 } 
 } 
 // -----------------------------------------------------------------------------
+// flow/profiler.h
+// -----------------------------------------------------------------------------
+#if EEZ_OPTION_FLOW_PROFILER
+namespace eez {
+namespace flow {
+enum ProfilerCounter {
+    PROFILER_COUNTER_EXECUTE,
+    PROFILER_COUNTER_EVAL
+};
+enum ProfilerSortColumn {
+    PROFILER_SORT_BY_CALLS,
+    PROFILER_SORT_BY_TOTAL_CYCLES,
+    PROFILER_SORT_BY_MAX_CYCLES,
+    PROFILER_SORT_BY_ALLOC_BYTES,
+    PROFILER_SORT_BY_EVAL_CALLS,
+    PROFILER_SORT_BY_EVAL_TOTAL_CYCLES,
+    PROFILER_SORT_BY_EVAL_MAX_CYCLES,
+    PROFILER_SORT_BY_EVAL_ALLOC_BYTES
+};
+struct ProfilerStats {
+    uint32_t numCalls;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint64_t allocBytes;
+};
+struct ComponentProfile {
+    ProfilerStats counters[2];
+};
+extern uint64_t g_profilerAllocBytes;
+uint32_t getProfilerCycles();
+ProfilerStats *getProfilerStats(FlowState *flowState, int componentIndex, ProfilerCounter counter);
+struct ProfilerScope {
+    ProfilerScope(FlowState *flowState, int componentIndex, ProfilerCounter counter)
+        : stats(getProfilerStats(flowState, componentIndex, counter)), allocBytes(g_profilerAllocBytes), startCycles(getProfilerCycles())
+    {
+    }
+    ~ProfilerScope() {
+        if (stats) {
+            uint32_t cycles = getProfilerCycles() - startCycles;
+            stats->numCalls++;
+            stats->totalCycles += cycles;
+            stats->maxCycles = stats->maxCycles < cycles ? cycles : stats->maxCycles;
+            stats->allocBytes += g_profilerAllocBytes - allocBytes;
+        }
+    }
+    ProfilerStats *stats;
+    uint64_t allocBytes;
+    uint32_t startCycles;
+};
+typedef void (*ProfilerWriteRowFunc)(void *param, const char *row, size_t rowLength);
+void profilerReset();
+void writeProfile(ProfilerSortColumn sortColumn, ProfilerWriteRowFunc writeRow, void *param);
+#if !defined(ESP_PLATFORM)
+bool dumpProfile(const char *filePath, ProfilerSortColumn sortColumn);
+#endif
+} 
+} 
+#endif
+// -----------------------------------------------------------------------------
+// flow/dependencies.h
+// -----------------------------------------------------------------------------
+namespace eez {
+namespace flow {
+void scanDependencies(FlowState *flowState, const uint8_t *instructions, uint32_t &globalVariablesMask, uint32_t &localVariablesMask, bool &poll);
+bool dependenciesChanged(FlowState *flowState, uint32_t globalVariablesMask, uint32_t localVariablesMask, uint32_t &stamp);
+void onVariableAssigned(FlowState *flowState, const Value *pValue);
+void checkNativeVariableVersions();
+void dependenciesReset();
+uint32_t getVariablesStamp();
+} 
+} 
+// -----------------------------------------------------------------------------
 // flow/watch_list.h
 // -----------------------------------------------------------------------------
 namespace eez {
@@ -2992,11 +3117,13 @@ typedef enum {
     NATIVE_VAR_TYPE_FLOAT,
     NATIVE_VAR_TYPE_DOUBLE,
     NATIVE_VAR_TYPE_STRING,
+    NATIVE_VAR_TYPE_VALUE,
 } NativeVarType;
 typedef struct _native_var_t {
     NativeVarType type;
     void *get;
     void *set;
+    const uint32_t *version;
 } native_var_t;
 #ifdef __cplusplus
 extern "C" {
@@ -3038,8 +3165,11 @@ void eez_flow_init_object_names(const char **objectNames, size_t numObjects);
 void eez_flow_init_group_names(const char **groupNames, size_t numGroups);
 void eez_flow_init_style_names(const char **styleNames, size_t numStyles);
 void eez_flow_init_themes(const char **themeNames, size_t numThemes, void (*changeColorTheme)(uint32_t themeIndex));
+void eez_flow_init_native_vars(native_var_t *nativeVars);
 void eez_flow_set_create_screen_func(void (*createScreenFunc)(int screenIndex));
 void eez_flow_set_delete_screen_func(void (*deleteScreenFunc)(int screenIndex));
+void eez_flow_set_screen_created_func(void (*screenCreatedFunc)(int screenIndex));
+void eez_flow_set_screen_memory_policy(size_t minFreeMemory, size_t (*getFreeMemoryFunc)());
 void eez_flow_tick();
 bool eez_flow_is_stopped();
 extern int16_t g_currentScreen;
@@ -3074,6 +3204,37 @@ const char *_evalStringArrayPropertyAndJoin(void *flowState, unsigned componentI
 void _assignStringProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, const char *value, const char *errorMessage, const char *file, int line);
 void _assignIntegerProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, int32_t value, const char *errorMessage, const char *file, int line);
 void _assignBooleanProperty(void *flowState, unsigned componentIndex, unsigned propertyIndex, bool value, const char *errorMessage, const char *file, int line);
+typedef struct {
+    uint16_t componentIndex;
+    uint16_t propertyIndex;
+    void (*update)(void *flowState);
+    void *flowState;
+    uint32_t globalVariablesMask;
+    uint32_t localVariablesMask;
+    uint32_t stamp;
+    bool poll;
+} FlowPropertyBinding;
+void flowResetPropertyBindings(FlowPropertyBinding *bindings, size_t numBindings);
+void flowUpdatePropertyBindings(void *flowState, FlowPropertyBinding *bindings, size_t numBindings);
+// Fixed capacity history of a line chart series, the oldest samples are overwritten when it is full.
+// Values are in chart units, times must not decrease. An attached chart draws from the buffer directly.
+typedef struct {
+    uint32_t *times;
+    lv_coord_t *values;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t next;
+    lv_obj_t *chart;
+    lv_chart_series_t *series;
+} FlowChartSeries;
+bool eez_flow_chart_series_init(FlowChartSeries *series, uint32_t capacity);
+void eez_flow_chart_series_free(FlowChartSeries *series);
+void eez_flow_chart_series_attach(FlowChartSeries *series, lv_obj_t *chart, lv_chart_series_t *chartSeries);
+void eez_flow_chart_series_detach(FlowChartSeries *series);
+bool eez_flow_chart_series_append(FlowChartSeries *series, uint32_t time, lv_coord_t value);
+void eez_flow_chart_series_clear(FlowChartSeries *series);
+uint32_t eez_flow_chart_series_find(const FlowChartSeries *series, uint32_t fromTime, uint32_t toTime, uint32_t *firstIndex);
+void eez_flow_chart_series_get(const FlowChartSeries *series, uint32_t index, uint32_t *time, lv_coord_t *value);
 float eez_linear(float x);
 float eez_easeInQuad(float x);
 float eez_easeOutQuad(float x);
@@ -927,11 +927,98 @@ void create_screen_main() {
     tick_screen_main();
 }
 
+void delete_screen_main() {
+    lv_obj_del(objects.main);
+    objects.main = 0;
+    objects.obj5 = 0;
+    objects.label_city = 0;
+    objects.label_time = 0;
+    objects.label_date = 0;
+    objects.image_current_weather_icon = 0;
+    objects.label_weather_description = 0;
+    objects.obj6 = 0;
+    objects.label_current_temperature = 0;
+    objects.label_current_temp_min = 0;
+    objects.obj7 = 0;
+    objects.label_current_temp_max = 0;
+    objects.image_1h_weather_icon = 0;
+    objects.label_1h = 0;
+    objects.label_1h_temperature = 0;
+    objects.image_2h_weather_icon = 0;
+    objects.label_2h = 0;
+    objects.label_2h_temperature = 0;
+    objects.image_3h_weather_icon = 0;
+    objects.label_3h = 0;
+    objects.label_3h_temperature = 0;
+    objects.image_4h_weather_icon = 0;
+    objects.label_4h = 0;
+    objects.label_4h_temperature = 0;
+    objects.image_5h_weather_icon = 0;
+    objects.label_5h = 0;
+    objects.label_5h_temperature = 0;
+    objects.image_6h_weather_icon = 0;
+    objects.label_6h = 0;
+    objects.label_6h_temperature = 0;
+    objects.image_1d_weather_icon = 0;
+    objects.label_1d = 0;
+    objects.label_1d_temp_max = 0;
+    objects.image_2d_weather_icon = 0;
+    objects.label_2d_temp_max = 0;
+    objects.image_3d_weather_icon = 0;
+    objects.label_3d_temp_max = 0;
+    objects.image_4d_weather_icon = 0;
+    objects.label_4d_temp_max = 0;
+    objects.image_5d_weather_icon = 0;
+    objects.label_5d_temp_max = 0;
+    objects.image_6d_weather_icon = 0;
+    objects.label_6d_temp_max = 0;
+    objects.label_2d = 0;
+    objects.label_3d = 0;
+    objects.label_4d = 0;
+    objects.label_5d = 0;
+    objects.label_6d = 0;
+    objects.label_1d_temp_min = 0;
+    objects.label_2d_temp_min = 0;
+    objects.label_3d_temp_min = 0;
+    objects.label_4d_temp_min = 0;
+    objects.label_5d_temp_min = 0;
+    objects.label_6d_temp_min = 0;
+    objects.image_7h_weather_icon = 0;
+    objects.label_7h = 0;
+    objects.label_7h_temperature = 0;
+    objects.image_7d_weather_icon = 0;
+    objects.label_7d_temp_max = 0;
+    objects.label_7d = 0;
+    objects.label_7d_temp_min = 0;
+    objects.obj8 = 0;
+    objects.label_info = 0;
+    objects.obj0 = 0;
+    objects.obj1 = 0;
+}
+
 void tick_screen_main() {
     void *flowState = getFlowState(0, 0);
     (void)flowState;
 }
 
+// Hand written, not generated: EEZ Studio overwrites this file and puts the evaluation of every
+// bound property back into tick_screen_pc(). After the UI is generated again, move each bound
+// property into an update function and list it in bindings_pc, see "Property bindings" in README.md.
+static void tick_pc_obj2_checked(void *flowState) {
+    bool new_val = evalBooleanProperty(flowState, 3, 3, "Failed to evaluate Checked state");
+    bool cur_val = lv_obj_has_state(objects.obj2, LV_STATE_CHECKED);
+    if (new_val != cur_val) {
+        tick_value_change_obj = objects.obj2;
+        if (new_val) lv_obj_add_state(objects.obj2, LV_STATE_CHECKED);
+        else lv_obj_clear_state(objects.obj2, LV_STATE_CHECKED);
+        tick_value_change_obj = NULL;
+    }
+}
+
+static FlowPropertyBinding bindings_pc[] = {
+    { 3, 3, tick_pc_obj2_checked },
+};
+
 void create_screen_pc() {
     void *flowState = getFlowState(0, 1);
     (void)flowState;
@@ -1342,22 +1429,55 @@ void create_screen_pc() {
         }
     }
     
+    flowResetPropertyBindings(bindings_pc, sizeof(bindings_pc) / sizeof(FlowPropertyBinding));
     tick_screen_pc();
 }
 
+void delete_screen_pc() {
+    lv_obj_del(objects.pc);
+    objects.pc = 0;
+    objects.obj9 = 0;
+    objects.obj10 = 0;
+    objects.obj2 = 0;
+    objects.label_city_1 = 0;
+    objects.label_time_1 = 0;
+    objects.label_date_1 = 0;
+    objects.image_current_weather_icon_1 = 0;
+    objects.label_weather_description_1 = 0;
+    objects.label_current_temperature_1 = 0;
+    objects.label_current_temp_min_1 = 0;
+    objects.obj11 = 0;
+    objects.label_current_temp_max_1 = 0;
+    objects.obj12 = 0;
+    objects.obj3 = 0;
+    objects.obj4 = 0;
+    objects.label_info_1 = 0;
+    objects.view_1 = 0;
+    objects.obj13 = 0;
+    objects.view_1_1 = 0;
+    objects.obj14 = 0;
+    objects.view_1_2 = 0;
+    objects.obj15 = 0;
+    objects.view_1_3 = 0;
+    objects.obj16 = 0;
+    objects.view_1_4 = 0;
+    objects.obj17 = 0;
+    objects.view_1_5 = 0;
+    objects.obj18 = 0;
+    objects.view_1_6 = 0;
+    objects.obj19 = 0;
+    objects.view_1_7 = 0;
+    objects.obj20 = 0;
+    objects.view_1_8 = 0;
+    objects.obj21 = 0;
+    objects.view_1_9 = 0;
+    objects.obj22 = 0;
+}
+
 void tick_screen_pc() {
     void *flowState = getFlowState(0, 1);
     (void)flowState;
-    {
-        bool new_val = evalBooleanProperty(flowState, 3, 3, "Failed to evaluate Checked state");
-        bool cur_val = lv_obj_has_state(objects.obj2, LV_STATE_CHECKED);
-        if (new_val != cur_val) {
-            tick_value_change_obj = objects.obj2;
-            if (new_val) lv_obj_add_state(objects.obj2, LV_STATE_CHECKED);
-            else lv_obj_clear_state(objects.obj2, LV_STATE_CHECKED);
-            tick_value_change_obj = NULL;
-        }
-    }
+    flowUpdatePropertyBindings(flowState, bindings_pc, sizeof(bindings_pc) / sizeof(FlowPropertyBinding));
 }
 
 
@@ -1365,6 +1485,30 @@ static const char *screen_names[] = { "Main", "PC" };
 static const char *object_names[] = { "main", "pc", "obj0", "obj1", "obj2", "obj3", "obj4", "view_1", "view_1_1", "view_1_2", "view_1_3", "view_1_4", "view_1_5", "view_1_6", "view_1_7", "view_1_8", "view_1_9", "obj5", "label_city", "label_time", "label_date", "image_current_weather_icon", "label_weather_description", "obj6", "label_current_temperature", "label_current_temp_min", "obj7", "label_current_temp_max", "image_1h_weather_icon", "label_1h", "label_1h_temperature", "image_2h_weather_icon", "label_2h", "label_2h_temperature", "image_3h_weather_icon", "label_3h", "label_3h_temperature", "image_4h_weather_icon", "label_4h", "label_4h_temperature", "image_5h_weather_icon", "label_5h", "label_5h_temperature", "image_6h_weather_icon", "label_6h", "label_6h_temperature", "image_1d_weather_icon", "label_1d", "label_1d_temp_max", "image_2d_weather_icon", "label_2d_temp_max", "image_3d_weather_icon", "label_3d_temp_max", "image_4d_weather_icon", "label_4d_temp_max", "image_5d_weather_icon", "label_5d_temp_max", "image_6d_weather_icon", "label_6d_temp_max", "label_2d", "label_3d", "label_4d", "label_5d", "label_6d", "label_1d_temp_min", "label_2d_temp_min", "label_3d_temp_min", "label_4d_temp_min", "label_5d_temp_min", "label_6d_temp_min", "image_7h_weather_icon", "label_7h", "label_7h_temperature", "image_7d_weather_icon", "label_7d_temp_max", "label_7d", "label_7d_temp_min", "obj8", "label_info", "obj9", "obj10", "label_city_1", "label_time_1", "label_date_1", "image_current_weather_icon_1", "label_weather_description_1", "label_current_temperature_1", "label_current_temp_min_1", "obj11", "label_current_temp_max_1", "obj12", "label_info_1", "obj13", "obj14", "obj15", "obj16", "obj17", "obj18", "obj19", "obj20", "obj21", "obj22" };
 
 
+typedef void (*create_screen_func_t)();
+create_screen_func_t create_screen_funcs[] = {
+    create_screen_main,
+    create_screen_pc,
+};
+void create_screen(int screen_index) {
+    create_screen_funcs[screen_index]();
+}
+void create_screen_by_id(enum ScreensEnum screenId) {
+    create_screen_funcs[screenId - 1]();
+}
+
+typedef void (*delete_screen_func_t)();
+delete_screen_func_t delete_screen_funcs[] = {
+    delete_screen_main,
+    delete_screen_pc,
+};
+void delete_screen(int screen_index) {
+    delete_screen_funcs[screen_index]();
+}
+void delete_screen_by_id(enum ScreensEnum screenId) {
+    delete_screen_funcs[screenId - 1]();
+}
+
 typedef void (*tick_screen_func_t)();
 tick_screen_func_t tick_screen_funcs[] = {
     tick_screen_main,
@@ -1378,6 +1522,9 @@ void tick_screen_by_id(enum ScreensEnum screenId) {
 }
 
 void create_screens() {
+    eez_flow_set_create_screen_func(create_screen);
+    eez_flow_set_delete_screen_func(delete_screen);
+
     eez_flow_init_screen_names(screen_names, sizeof(screen_names) / sizeof(const char *));
     eez_flow_init_object_names(object_names, sizeof(object_names) / sizeof(const char *));
     
@@ -1385,6 +1532,6 @@ void create_screens() {
     lv_theme_t *theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED), false, LV_FONT_DEFAULT);
     lv_disp_set_theme(dispp, theme);
     
+    // The other screens are created when they are shown for the first time
     create_screen_main();
-    create_screen_pc();
 }
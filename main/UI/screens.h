@@ -120,11 +120,19 @@ enum ScreensEnum {
 };
 
 void create_screen_main();
+void delete_screen_main();
 void tick_screen_main();
 
 void create_screen_pc();
+void delete_screen_pc();
 void tick_screen_pc();
 
+void create_screen_by_id(enum ScreensEnum screenId);
+void create_screen(int screen_index);
+
+void delete_screen_by_id(enum ScreensEnum screenId);
+void delete_screen(int screen_index);
+
 void tick_screen_by_id(enum ScreensEnum screenId);
 void tick_screen(int screen_index);
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -13,12 +14,21 @@
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "lvgl.h"
+#include "draw/sw/lv_draw_sw.h"
 #include "lvgl_port.h"
+#include "lvgl_port_copy.h"
 
 static const char *TAG = "lv_port";                      // Tag for logging
 static SemaphoreHandle_t lvgl_mux;                       // LVGL mutex for synchronization
 static TaskHandle_t lvgl_task_handle = NULL;             // Handle for the LVGL task
 
+#if LVGL_PORT_BLEND_WORKER_ENABLE
+static TaskHandle_t blend_worker_handle = NULL;          // Handle for the blend worker task
+static SemaphoreHandle_t blend_worker_done;              // Given by the worker when its stripe is blended
+static void (*blend_worker_job_cb)(void *param);         // The job dispatched to the worker
+static void *blend_worker_job_param;                     // Parameter of the dispatched job
+#endif
+
 #if EXAMPLE_LVGL_PORT_ROTATION_DEGREE != 0
 // Function to get the next frame buffer for double buffering
 static void *get_next_frame_buffer(esp_lcd_panel_handle_t panel_handle)
@@ -348,6 +358,66 @@ void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color
 }
 #endif
 
+#elif LVGL_PORT_BUFFER_DOUBLE
+
+static lvgl_port_copy_handle_t flush_copy = NULL;      // Copies the LVGL buffers to the RGB frame buffer in the background
+static lv_color_t *lvgl_port_rgb_fb = NULL;             // The RGB frame buffer
+static TaskHandle_t flush_wait_task = NULL;             // The task rendering the next stripe while the copy runs
+
+static bool flush_copy_done(lvgl_port_copy_handle_t handle, void *user_ctx)
+{
+    lv_disp_drv_t *drv = (lv_disp_drv_t *)user_ctx; // Get the display driver from the copy context
+    BaseType_t need_yield = pdFALSE;
+
+    lv_disp_flush_ready(drv); // Mark the display flush as complete, the buffer can be rendered again
+    if (xPortInIsrContext()) {
+        vTaskNotifyGiveFromISR(flush_wait_task, &need_yield); // Wake up the task if it waits for the buffer
+    } else {
+        xTaskNotifyGive(flush_wait_task);
+    }
+    return (need_yield == pdTRUE);
+}
+
+static void flush_wait_callback(lv_disp_drv_t *drv)
+{
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LVGL_PORT_TASK_MAX_DELAY_MS)); // Sleep until the copy is done instead of polling
+}
+
+static void rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    const lv_coord_t align_px = LVGL_PORT_COPY_ALIGN / sizeof(lv_color_t); // Pixels in an aligned DMA burst
+
+    /* Widen the area to aligned columns, so every row of the stripe can be copied by the DMA */
+    area->x1 &= ~(align_px - 1);
+    area->x2 |= align_px - 1;
+    if (area->x2 >= LVGL_PORT_H_RES) {
+        area->x2 = LVGL_PORT_H_RES - 1;
+    }
+}
+
+void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t) drv->user_data; // Get the panel handle from driver user data
+    const int offsetx1 = area->x1; // Start X coordinate of the area to flush
+    const int offsetx2 = area->x2; // End X coordinate of the area to flush
+    const int offsety1 = area->y1; // Start Y coordinate of the area to flush
+    const int offsety2 = area->y2; // End Y coordinate of the area to flush
+    const size_t row_size = (offsetx2 - offsetx1 + 1) * sizeof(lv_color_t); // Bytes in a row of the area
+
+    /* Copy the stripe in the background while LVGL renders the next one to the other buffer */
+    flush_wait_task = xTaskGetCurrentTaskHandle(); // Notified by `flush_copy_done()`
+    if (lvgl_port_copy_rect(flush_copy, lvgl_port_rgb_fb + offsety1 * LVGL_PORT_H_RES + offsetx1,
+                            LVGL_PORT_H_RES * sizeof(lv_color_t), color_map, row_size, row_size,
+                            offsety2 - offsety1 + 1) == ESP_OK) {
+        return; // `flush_copy_done()` marks the display flush as complete
+    }
+
+    /* The DMA can't copy the area, so just copy data from the color map to the RGB frame buffer */
+    esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
+
+    lv_disp_flush_ready(drv); // Mark the display flush as complete
+}
+
 #else
 
 void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
@@ -366,6 +436,22 @@ void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color
 
 #endif /* LVGL_PORT_AVOID_TEAR_ENABLE */
 
+static void monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    lv_refr_inv_stat_t inv_stat; // How the invalidated areas were merged in this frame
+    lv_refr_get_inv_stat(&inv_stat); // Read the area counters of the refresh
+    lv_refr_reset_inv_stat(); // Count again for the next frame
+    ESP_LOGD(TAG, "Refresh: %"PRIu32" ms, %"PRIu32" px, %"PRIu32" invalidated, %"PRIu32" joined, %"PRIu32" overflowed, %"PRIu32" areas",
+             time, px, inv_stat.inv_cnt, inv_stat.join_cnt, inv_stat.overflow_cnt, inv_stat.area_cnt); // Log the area counters
+#if LV_REFR_OCCLUDER_MAX
+    lv_refr_occlusion_stat_t stat; // Draw operations saved by occlusion culling in this frame
+    lv_refr_get_occlusion_stat(&stat); // Read the counters of the refresh
+    lv_refr_reset_occlusion_stat(); // Count again for the next frame
+    ESP_LOGD(TAG, "Occlusion: %"PRIu32" occluders, %"PRIu32" widgets skipped, %"PRIu32" main draws skipped, %"PRIu32" trimmed",
+             stat.occluder_cnt, stat.skip_obj_cnt, stat.skip_main_cnt, stat.trim_main_cnt); // Log the counters of the active screen
+#endif
+}
+
 static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
 {
     assert(panel_handle); // Ensure the panel handle is valid
@@ -395,6 +481,15 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
 #else
     ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 2, &buf1, &buf2)); // Get two frame buffers
 #endif
+#elif LVGL_PORT_BUFFER_DOUBLE
+    // Two internal buffers: LVGL renders to one while the DMA copies the other to the RGB frame buffer
+    buffer_size = LVGL_PORT_H_RES * LVGL_PORT_BUFFER_HEIGHT; // Calculate buffer size
+    buf1 = heap_caps_aligned_alloc(LVGL_PORT_COPY_ALIGN, buffer_size * sizeof(lv_color_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA); // Allocate memory
+    buf2 = heap_caps_aligned_alloc(LVGL_PORT_COPY_ALIGN, buffer_size * sizeof(lv_color_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    assert(buf1 && buf2); // Ensure allocation succeeded
+    ESP_LOGI(TAG, "LVGL buffer size: 2 x %dKB", buffer_size * sizeof(lv_color_t) / 1024); // Log buffer size
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel_handle, 1, (void **)&lvgl_port_rgb_fb)); // Get the frame buffer
+    ESP_ERROR_CHECK(lvgl_port_copy_new(LVGL_PORT_BUFFER_HEIGHT, flush_copy_done, &disp_drv, &flush_copy)); // Create the copy engine
 #else
     // Normally, for RGB LCD, just one buffer is used for LVGL rendering
     buffer_size = LVGL_PORT_H_RES * LVGL_PORT_BUFFER_HEIGHT; // Calculate buffer size
@@ -418,6 +513,11 @@ static lv_disp_t *display_init(esp_lcd_panel_handle_t panel_handle)
     disp_drv.flush_cb = flush_callback; // Set the flush callback
     disp_drv.draw_buf = &disp_buf; // Set the draw buffer
     disp_drv.user_data = panel_handle; // Set user data to panel handle
+    disp_drv.monitor_cb = monitor_callback; // Report the refreshed areas and skipped draw operations of every refresh
+#if LVGL_PORT_BUFFER_DOUBLE
+    disp_drv.rounder_cb = rounder_callback; // Align the areas for the DMA copy
+    disp_drv.wait_cb = flush_wait_callback; // Wait for the DMA copy without polling
+#endif
 #if LVGL_PORT_FULL_REFRESH
     disp_drv.full_refresh = 1; // Enable full refresh
 #elif LVGL_PORT_DIRECT_MODE
@@ -503,10 +603,63 @@ static void lvgl_port_task(void *arg)
     }
 }
 
+#if LVGL_PORT_BLEND_WORKER_ENABLE
+static void blend_worker_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Wait for a stripe from the LVGL task
+        blend_worker_job_cb(blend_worker_job_param); // Blend the stripe
+        xSemaphoreGive(blend_worker_done); // Let the LVGL task continue
+    }
+}
+
+static void blend_worker_dispatch(uint32_t worker_id, void (*job_cb)(void *param), void *param)
+{
+    blend_worker_job_cb = job_cb; // Only one worker, so `worker_id` is always 0
+    blend_worker_job_param = param;
+    xTaskNotifyGive(blend_worker_handle); // Wake up the worker
+}
+
+static void blend_worker_join(void)
+{
+    xSemaphoreTake(blend_worker_done, portMAX_DELAY); // Wait until the worker finished its stripe
+}
+
+static esp_err_t blend_worker_init(void)
+{
+    static const lv_draw_sw_blend_workers_t workers = {
+        .worker_cnt = 1,
+        .min_px = LVGL_PORT_BLEND_WORKER_MIN_PX,
+        .dispatch_cb = blend_worker_dispatch,
+        .join_cb = blend_worker_join,
+    };
+
+    blend_worker_done = xSemaphoreCreateBinary(); // Create the semaphore signalling a finished stripe
+    assert(blend_worker_done); // Ensure semaphore creation was successful
+
+    BaseType_t ret = xTaskCreatePinnedToCore(blend_worker_task, "lvgl_blend", 2048, NULL, LVGL_PORT_TASK_PRIORITY,
+                                             &blend_worker_handle, LVGL_PORT_BLEND_WORKER_CORE); // Create the worker task
+    if (ret != pdPASS) {
+        return ESP_FAIL;
+    }
+
+    lv_draw_sw_blend_set_workers(&workers); // Split the large areas between the LVGL task and the worker
+    return ESP_OK;
+}
+#endif
+
 esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle_t tp_handle)
 {
     lv_init(); // Initialize LVGL
     ESP_ERROR_CHECK(tick_init()); // Initialize the tick timer
+    lv_draw_sw_blend_rgb565_set_kernels(lv_draw_sw_blend_rgb565_get_packed_kernels()); // Blend 2 pixels per 32 bit access of the PSRAM frame buffer
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+    void *shadow_cache_buf = heap_caps_malloc(LV_SHADOW_CACHE_MEM_SIZE, MALLOC_CAP_SPIRAM); // Keep the blurred shadow corners in PSRAM
+    if (shadow_cache_buf) {
+        lv_draw_sw_shadow_cache_set_buf(shadow_cache_buf, LV_SHADOW_CACHE_MEM_SIZE); // Otherwise LVGL allocates it from its own heap
+    }
+#endif
 
     lv_disp_t *disp = display_init(lcd_handle); // Initialize the display
     assert(disp); // Ensure the display initialization was successful
@@ -531,6 +684,12 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
     lvgl_mux = xSemaphoreCreateRecursiveMutex(); // Create a recursive mutex for LVGL
     assert(lvgl_mux); // Ensure mutex creation was successful
 
+#if LVGL_PORT_BLEND_WORKER_ENABLE
+    if (blend_worker_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to create blend worker task, blending on one core"); // Blending still works without it
+    }
+#endif
+
     ESP_LOGI(TAG, "Create LVGL task"); // Log task creation
     BaseType_t core_id = (LVGL_PORT_TASK_CORE < 0) ? tskNO_AFFINITY : LVGL_PORT_TASK_CORE; // Determine core ID for the task
     BaseType_t ret = xTaskCreatePinnedToCore(lvgl_port_task, "lvgl", LVGL_PORT_TASK_STACK_SIZE, NULL,
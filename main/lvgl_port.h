@@ -35,6 +35,9 @@ extern "C" {
 #define LVGL_PORT_TASK_PRIORITY     (CONFIG_EXAMPLE_LVGL_PORT_TASK_PRIORITY)        // The priority of the LVGL timer task
 #define LVGL_PORT_TASK_CORE         (CONFIG_EXAMPLE_LVGL_PORT_TASK_CORE)            // The core of the LVGL timer task,
 // `-1` means the don't specify the core
+#define LVGL_PORT_BLEND_WORKER_ENABLE (CONFIG_EXAMPLE_LVGL_PORT_BLEND_WORKER_ENABLE) // Set to 1 to blend large areas on both cores
+#define LVGL_PORT_BLEND_WORKER_CORE   ((LVGL_PORT_TASK_CORE == 0) ? 1 : 0)        // The core of the blend worker task
+#define LVGL_PORT_BLEND_WORKER_MIN_PX (4 * LVGL_PORT_H_RES)                        // Smaller areas are not worth splitting
 /**
  *
  * LVGL buffer related parameters, can be adjusted by users:
@@ -52,6 +55,7 @@ extern "C" {
 #define LVGL_PORT_BUFFER_MALLOC_CAPS    (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
 #endif
 #define LVGL_PORT_BUFFER_HEIGHT         (CONFIG_EXAMPLE_LVGL_PORT_BUF_HEIGHT)
+#define LVGL_PORT_BUFFER_DOUBLE         (CONFIG_EXAMPLE_LVGL_PORT_BUF_DOUBLE) // Set to 1 to copy the buffers to the frame buffer in the background
 
 /**
  * Avoid tering related configurations, can be adjusted by users.
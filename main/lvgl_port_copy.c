@@ -0,0 +1,233 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include "esp_async_memcpy.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+#include "esp_log.h"
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+#include "esp_cache.h"
+#else
+#include "esp32s3/rom/cache.h"
+#endif
+#else
+#include <pthread.h>
+#endif
+#include "lvgl_port_copy.h"
+
+struct lvgl_port_copy_t {
+    lvgl_port_copy_done_cb_t done_cb;    // Called when all rows are copied
+    void *user_ctx;                      // Passed to `done_cb`
+    atomic_size_t pending;               // Rows being copied, plus one while the rows are started
+    uint8_t *dst;                        // The destination of the current rectangle
+    size_t dst_size;                     // Bytes from the first to the end of the last row in the destination
+#ifdef ESP_PLATFORM
+    async_memcpy_handle_t mcp;           // The async memcpy driver
+#else
+    pthread_t worker;                    // Copies the rows on the host
+    pthread_mutex_t lock;                // Protects the fields below
+    pthread_cond_t cond;                 // Signalled when a rectangle is started or the worker should exit
+    bool has_job;                        // A rectangle is waiting for the worker
+    bool exit;                           // The worker should exit
+    const uint8_t *src;                  // The source of the current rectangle
+    size_t src_stride;                   // Distance of the rows in the source
+    size_t dst_stride;                   // Distance of the rows in the destination
+    size_t row_size;                     // Bytes to copy from every row
+    size_t rows;                         // Number of rows
+#endif
+};
+
+#ifdef ESP_PLATFORM
+
+static const char *TAG = "lv_port_copy";                 // Tag for logging
+
+static bool copy_row_finish(lvgl_port_copy_handle_t handle)
+{
+    if (atomic_fetch_sub(&handle->pending, 1) != 1) {
+        return false; // Other rows are still being copied
+    }
+
+    // The DMA wrote the PSRAM behind the cache, so drop the cached lines of the destination
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+    esp_cache_msync(handle->dst, handle->dst_size, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+#else
+    Cache_Invalidate_Addr((uint32_t)handle->dst, handle->dst_size);
+#endif
+    return handle->done_cb(handle, handle->user_ctx);
+}
+
+static bool copy_row_done(async_memcpy_handle_t mcp, async_memcpy_event_t *event, void *cb_args)
+{
+    return copy_row_finish((lvgl_port_copy_handle_t)cb_args); // Called from the GDMA ISR
+}
+
+esp_err_t lvgl_port_copy_new(size_t max_rows, lvgl_port_copy_done_cb_t done_cb, void *user_ctx,
+                             lvgl_port_copy_handle_t *ret_handle)
+{
+    lvgl_port_copy_handle_t handle = heap_caps_calloc(1, sizeof(struct lvgl_port_copy_t), MALLOC_CAP_INTERNAL); // Used from the ISR
+    if (handle == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    config.backlog = max_rows; // One transaction for every row of a stripe
+    config.psram_trans_align = LVGL_PORT_COPY_ALIGN; // The frame buffer is in PSRAM
+    esp_err_t ret = esp_async_memcpy_install(&config, &handle->mcp);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Install async memcpy failed");
+        free(handle);
+        return ret;
+    }
+
+    handle->done_cb = done_cb;
+    handle->user_ctx = user_ctx;
+    *ret_handle = handle;
+    return ESP_OK;
+}
+
+static void copy_rows_start(lvgl_port_copy_handle_t handle, const uint8_t *src, size_t src_stride,
+                            size_t dst_stride, size_t row_size, size_t rows)
+{
+    for (size_t i = 0; i < rows; i++) {
+        uint8_t *dst_row = handle->dst + i * dst_stride;
+        const uint8_t *src_row = src + i * src_stride;
+        if (esp_async_memcpy(handle->mcp, dst_row, (void *)src_row, row_size, copy_row_done, handle) != ESP_OK) {
+            // Out of transactions: copy the row with the CPU and write it to the PSRAM before it is invalidated
+            memcpy(dst_row, src_row, row_size);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+            esp_cache_msync(dst_row, row_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+#else
+            Cache_WriteBack_Addr((uint32_t)dst_row, row_size);
+#endif
+            copy_row_finish(handle);
+        }
+    }
+}
+
+void lvgl_port_copy_del(lvgl_port_copy_handle_t handle)
+{
+    esp_async_memcpy_uninstall(handle->mcp);
+    free(handle);
+}
+
+#else
+
+static bool copy_row_finish(lvgl_port_copy_handle_t handle)
+{
+    if (atomic_fetch_sub(&handle->pending, 1) != 1) {
+        return false; // Other rows are still being copied
+    }
+    return handle->done_cb(handle, handle->user_ctx);
+}
+
+static void *copy_worker(void *arg)
+{
+    lvgl_port_copy_handle_t handle = (lvgl_port_copy_handle_t)arg;
+
+    pthread_mutex_lock(&handle->lock);
+    while (1) {
+        while (!handle->has_job && !handle->exit) {
+            pthread_cond_wait(&handle->cond, &handle->lock); // Wait for a rectangle
+        }
+        if (handle->exit) {
+            break;
+        }
+        handle->has_job = false;
+        pthread_mutex_unlock(&handle->lock);
+
+        for (size_t i = 0; i < handle->rows; i++) {
+            memcpy(handle->dst + i * handle->dst_stride, handle->src + i * handle->src_stride, handle->row_size);
+            copy_row_finish(handle);
+        }
+
+        pthread_mutex_lock(&handle->lock);
+    }
+    pthread_mutex_unlock(&handle->lock);
+    return NULL;
+}
+
+esp_err_t lvgl_port_copy_new(size_t max_rows, lvgl_port_copy_done_cb_t done_cb, void *user_ctx,
+                             lvgl_port_copy_handle_t *ret_handle)
+{
+    (void)max_rows; // The worker copies any number of rows
+    lvgl_port_copy_handle_t handle = calloc(1, sizeof(struct lvgl_port_copy_t));
+    if (handle == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    handle->done_cb = done_cb;
+    handle->user_ctx = user_ctx;
+    pthread_mutex_init(&handle->lock, NULL);
+    pthread_cond_init(&handle->cond, NULL);
+    if (pthread_create(&handle->worker, NULL, copy_worker, handle) != 0) {
+        pthread_cond_destroy(&handle->cond);
+        pthread_mutex_destroy(&handle->lock);
+        free(handle);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *ret_handle = handle;
+    return ESP_OK;
+}
+
+static void copy_rows_start(lvgl_port_copy_handle_t handle, const uint8_t *src, size_t src_stride,
+                            size_t dst_stride, size_t row_size, size_t rows)
+{
+    pthread_mutex_lock(&handle->lock);
+    handle->src = src;
+    handle->src_stride = src_stride;
+    handle->dst_stride = dst_stride;
+    handle->row_size = row_size;
+    handle->rows = rows;
+    handle->has_job = true;
+    pthread_cond_signal(&handle->cond); // Wake up the worker
+    pthread_mutex_unlock(&handle->lock);
+}
+
+void lvgl_port_copy_del(lvgl_port_copy_handle_t handle)
+{
+    pthread_mutex_lock(&handle->lock);
+    handle->exit = true;
+    pthread_cond_signal(&handle->cond); // Let the worker exit
+    pthread_mutex_unlock(&handle->lock);
+
+    pthread_join(handle->worker, NULL);
+    pthread_cond_destroy(&handle->cond);
+    pthread_mutex_destroy(&handle->lock);
+    free(handle);
+}
+
+#endif /* ESP_PLATFORM */
+
+esp_err_t lvgl_port_copy_rect(lvgl_port_copy_handle_t handle, void *dst, size_t dst_stride, const void *src,
+                              size_t src_stride, size_t row_size, size_t rows)
+{
+    if (rows == 0 || (((uintptr_t)dst | dst_stride | row_size) % LVGL_PORT_COPY_ALIGN) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&handle->pending) != 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    handle->dst = (uint8_t *)dst;
+    handle->dst_size = (rows - 1) * dst_stride + row_size;
+
+    // Full width rows are copied at once
+    if (src_stride == row_size && dst_stride == row_size) {
+        row_size *= rows;
+        rows = 1;
+    }
+
+    // Keep one extra row pending so `done_cb` isn't called before all rows are started
+    atomic_store(&handle->pending, rows + 1);
+    copy_rows_start(handle, (const uint8_t *)src, src_stride, dst_stride, row_size, rows);
+    copy_row_finish(handle);
+    return ESP_OK;
+}
+
+bool lvgl_port_copy_is_busy(lvgl_port_copy_handle_t handle)
+{
+    return atomic_load(&handle->pending) != 0;
+}
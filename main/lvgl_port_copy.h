@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_err.h"
+#else
+typedef int esp_err_t;
+#define ESP_OK                  0
+#define ESP_FAIL                -1
+#define ESP_ERR_NO_MEM          0x101
+#define ESP_ERR_INVALID_ARG     0x102
+#define ESP_ERR_INVALID_STATE   0x103
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Alignment (in bytes) of the destination, the strides and the row size of a copied rectangle.
+ * The DMA writes the PSRAM in bursts and the cache of the destination is invalidated by lines.
+ *
+ */
+#define LVGL_PORT_COPY_ALIGN    (64)
+
+typedef struct lvgl_port_copy_t *lvgl_port_copy_handle_t;
+
+/**
+ * @brief Called when all rows of a rectangle are copied
+ *
+ * @note This function may be called from an ISR, so it must not block
+ *
+ * @param handle   The copy engine
+ * @param user_ctx User context passed to `lvgl_port_copy_new()`
+ *
+ * @return
+ *      - true if a higher priority task was woken up by this function
+ */
+typedef bool (*lvgl_port_copy_done_cb_t)(lvgl_port_copy_handle_t handle, void *user_ctx);
+
+/**
+ * @brief Create a copy engine which copies rectangles in the background
+ *
+ * On the target the copy is done by the async memcpy (GDMA) driver, on the host by a worker thread.
+ *
+ * @param max_rows   Rows of a rectangle copied at most at a time, one DMA transaction is reserved for each
+ * @param done_cb    Called when a rectangle is copied
+ * @param user_ctx   User context passed to `done_cb`
+ * @param ret_handle Returned handle of the copy engine
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_NO_MEM if the resources can't be allocated
+ */
+esp_err_t lvgl_port_copy_new(size_t max_rows, lvgl_port_copy_done_cb_t done_cb, void *user_ctx,
+                             lvgl_port_copy_handle_t *ret_handle);
+
+/**
+ * @brief Start copying a rectangle and return without waiting
+ *
+ * Only one rectangle can be copied at a time. `done_cb` is called when all of its rows are copied.
+ *
+ * @param handle     The copy engine
+ * @param dst        Address of the first row in the destination
+ * @param dst_stride Distance of the rows in the destination, in bytes
+ * @param src        Address of the first row in the source
+ * @param src_stride Distance of the rows in the source, in bytes
+ * @param row_size   Bytes to copy from every row
+ * @param rows       Number of rows
+ *
+ * @return
+ *      - ESP_OK if the copy is started, `done_cb` will be called
+ *      - ESP_ERR_INVALID_ARG if the rectangle is not aligned to `LVGL_PORT_COPY_ALIGN`, nothing is copied
+ *      - ESP_ERR_INVALID_STATE if the previous rectangle is still being copied, nothing is copied
+ */
+esp_err_t lvgl_port_copy_rect(lvgl_port_copy_handle_t handle, void *dst, size_t dst_stride, const void *src,
+                              size_t src_stride, size_t row_size, size_t rows);
+
+/**
+ * @brief Check if a rectangle is being copied
+ *
+ * @param handle The copy engine
+ *
+ * @return
+ *      - true if `done_cb` of the last rectangle wasn't called yet
+ */
+bool lvgl_port_copy_is_busy(lvgl_port_copy_handle_t handle);
+
+/**
+ * @brief Delete a copy engine
+ *
+ * @note The last rectangle must be copied before
+ *
+ * @param handle The copy engine
+ */
+void lvgl_port_copy_del(lvgl_port_copy_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,6 +11,8 @@
  #include "secrets.h"
  #include "esp_log.h"
  #include "esp_system.h"
+ #include "esp_timer.h"
+ #include "esp_heap_caps.h"
  #include "nvs_flash.h"
  #include "esp_netif.h"
  #include "esp_event.h"
@@ -24,6 +26,7 @@
  #include "UI/ui.h"
  #include "UI/screens.h"
  #include "weather_client.h"
+ #include "weather_vars.h"
  #include "cJSON.h"
  #include "UI/images.h" // Include the images header for weather icons
  #include "presence_sensor.h"
@@ -121,6 +124,13 @@
      }
  }
  
+ // Set the text of a label if its screen is created
+ static void set_label_text(lv_obj_t* label, const char* text) {
+     if (label) {
+         lv_label_set_text(label, text);
+     }
+ }
+ 
  // OpenWeatherMap configuration
  static const char *openWeatherMapApiKey = OPENWEATHER_API_KEY;
  static const char *lat = OPENWEATHER_LAT;
@@ -165,6 +175,7 @@
  static void update_time_display(void);
  static void create_weather_ui(void);
  static void update_weather_data(void);
+ static void show_current_weather(void);
  static void get_date_time(void);
  static void weather_update_timer_cb(lv_timer_t *timer);
  static void time_update_timer_cb(lv_timer_t *timer);
@@ -269,10 +280,10 @@
      // Update UI elements with time data
      if (lvgl_port_lock(-1)) {
          // Update all labels that show time
-         lv_label_set_text(objects.label_time, time_str);
-         lv_label_set_text(objects.label_time_1, time_str);
-         lv_label_set_text(objects.label_date, date_str);
-         lv_label_set_text(objects.label_date_1, date_str);
+         set_label_text(objects.label_time, time_str);
+         set_label_text(objects.label_time_1, time_str);
+         set_label_text(objects.label_date, date_str);
+         set_label_text(objects.label_date_1, date_str);
          
          // Update info labels with time source info
          char info_str[100]; // Increased size for longer string
@@ -294,8 +305,8 @@
          }
          
          snprintf(info_str, sizeof(info_str), "Last data update: %s | Clock source: %s", weather_time_str, source_text);
-         lv_label_set_text(objects.label_info, info_str);
-         lv_label_set_text(objects.label_info_1, info_str);
+         set_label_text(objects.label_info, info_str);
+         set_label_text(objects.label_info_1, info_str);
          
          lvgl_port_unlock();
      }
@@ -337,6 +348,14 @@
     if (objects.view_1) {
         lv_obj_clear_flag(objects.view_1, LV_OBJ_FLAG_HIDDEN);
     }
+    set_label_text(objects.label_city, OPENWEATHER_CITY);
+    set_label_text(objects.label_city_1, OPENWEATHER_CITY);
+
+    // The forecast is on the Main screen, it's shown when the screen is created again
+    if (!eez_flow_is_screen_created(SCREEN_ID_MAIN)) {
+        lvgl_port_unlock();
+        return;
+    }
     
     // Update each hour's forecast
     for (int i = 0; i < 7 && i < forecast_count; i++) {
@@ -447,11 +466,6 @@
         } else {
             ESP_LOGE(MAIN_TAG, "Image icon for hour %d is NULL", i);
         }
-        lv_label_set_text(objects.label_city, OPENWEATHER_CITY);
-        lv_label_set_text(objects.label_city_1, OPENWEATHER_CITY);
-
-        // Small delay to allow LVGL to process events
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
     
     ESP_LOGI(MAIN_TAG, "update_hourly_forecast: Loop finished. Attempting lv_refr_now.");
@@ -482,6 +496,28 @@ static void update_weather_data(void)
     
     ESP_LOGI(MAIN_TAG, "Weather data updated successfully");
 
+    // Publish the data to the flow variables
+    weather_data_t weather;
+    weather_client_get_data(&weather);
+    if (lvgl_port_lock(-1)) {
+        weather_vars_set(&weather);
+        lvgl_port_unlock();
+    }
+
+    show_current_weather();
+
+    // Update time display (it will handle its own locking)
+    update_time_display();
+    
+    // Note: Don't call update_hourly_forecast() here as it will be called
+    // by the timer. This prevents a potential infinite loop.
+}
+
+/**
+ * @brief Show the last fetched current weather on the screens
+ */
+static void show_current_weather(void)
+{
     // Get the complete weather data
     weather_data_t weather;
     if (!weather_client_get_data(&weather)) {
@@ -512,8 +548,8 @@ static void update_weather_data(void)
         snprintf(temp_str, sizeof(temp_str), "%.1f°C", weather.temperature);
         
         // Update temperature labels
-        lv_label_set_text(objects.label_current_temperature, temp_str);
-        lv_label_set_text(objects.label_current_temperature_1, temp_str);
+        set_label_text(objects.label_current_temperature, temp_str);
+        set_label_text(objects.label_current_temperature_1, temp_str);
         
         ESP_LOGI(MAIN_TAG, "Updated temperature to: %s", temp_str);
     } else {
@@ -528,24 +564,16 @@ static void update_weather_data(void)
         snprintf(min_temp_str, sizeof(min_temp_str), "%.0f°C", weather.temp_min);
         snprintf(max_temp_str, sizeof(max_temp_str), "%.0f°C", weather.temp_max);
 
-        if (objects.label_current_temp_min) {
-            lv_label_set_text(objects.label_current_temp_min, min_temp_str);
-            lv_label_set_text(objects.label_current_temp_min_1, min_temp_str);
-        }
-        if (objects.label_current_temp_max) {
-            lv_label_set_text(objects.label_current_temp_max, max_temp_str);
-            lv_label_set_text(objects.label_current_temp_max_1, max_temp_str);
-        }
+        set_label_text(objects.label_current_temp_min, min_temp_str);
+        set_label_text(objects.label_current_temp_min_1, min_temp_str);
+        set_label_text(objects.label_current_temp_max, max_temp_str);
+        set_label_text(objects.label_current_temp_max_1, max_temp_str);
         ESP_LOGI(MAIN_TAG, "Updated current day min/max temp to: %s / %s", min_temp_str, max_temp_str);
     } else {
         ESP_LOGW(MAIN_TAG, "Received invalid min/max temperature value for current day");
         // Optionally clear or set to default if objects exist
-        if (objects.label_current_temp_min) {
-            lv_label_set_text(objects.label_current_temp_min, "Min: --°");
-        }
-        if (objects.label_current_temp_max) {
-            lv_label_set_text(objects.label_current_temp_max, "Max: --°");
-        }
+        set_label_text(objects.label_current_temp_min, "Min: --°");
+        set_label_text(objects.label_current_temp_max, "Max: --°");
     }
     
     // Update weather description if available
@@ -558,7 +586,8 @@ static void update_weather_data(void)
         }
         
         // Update description label
-        lv_label_set_text(objects.label_weather_description, desc);
+        set_label_text(objects.label_weather_description, desc);
+        set_label_text(objects.label_weather_description_1, desc);
         ESP_LOGI(MAIN_TAG, "Weather: %s", desc);
     }
     
@@ -566,18 +595,14 @@ static void update_weather_data(void)
     if (weather.icon[0] != '\0') {
         // Set the appropriate weather icon based on the condition
         set_weather_icon(weather.icon, objects.image_current_weather_icon);
-        set_weather_icon(weather.icon, objects.image_current_weather_icon_1);
+        if (objects.image_current_weather_icon_1) {
+            set_weather_icon(weather.icon, objects.image_current_weather_icon_1);
+        }
         ESP_LOGI(MAIN_TAG, "Weather icon: %s", weather.icon);
     }
     
     // Release the LVGL lock
     lvgl_port_unlock();
-    
-    // Update time display (it will handle its own locking)
-    update_time_display();
-    
-    // Note: Don't call update_hourly_forecast() here as it will be called
-    // by the timer. This prevents a potential infinite loop.
 }
 
 /**
@@ -613,6 +638,38 @@ static void weather_update_timer_cb(lv_timer_t *timer)
     ESP_LOGI(MAIN_TAG, "weather_update_timer_cb: Calling update_daily_forecast");
     update_daily_forecast(); 
     ESP_LOGI(MAIN_TAG, "weather_update_timer_cb: Returned from update_daily_forecast");
+
+#if LV_TXT_LAYOUT_CACHE_SIZE > 0
+    // Report how many text layout passes the LVGL layout cache saved
+    lv_txt_layout_cache_stats_t txt_stats;
+    lv_txt_layout_cache_get_stats(&txt_stats);
+    ESP_LOGI(MAIN_TAG, "Text layout cache: %lu saved, %lu measured, %lu evicted",
+             (unsigned long)txt_stats.hit, (unsigned long)txt_stats.miss, (unsigned long)txt_stats.evict);
+#endif
+}
+
+/**
+ * @brief Free internal heap, used by the screen memory policy
+ */
+static size_t get_free_internal_heap(void)
+{
+    return heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+}
+
+/**
+ * @brief Restore a screen which is created again from the last fetched data
+ * @param screen_index Index of the created screen
+ */
+static void on_screen_created(int screen_index)
+{
+    ESP_LOGI(MAIN_TAG, "Screen %d created, free internal heap: %u bytes", screen_index,
+             (unsigned)get_free_internal_heap());
+    update_time_display();
+    if (weather_client_get_last_update_time() > 0) {
+        show_current_weather();
+        update_hourly_forecast();
+        update_daily_forecast();
+    }
 }
 
 /**
@@ -620,8 +677,19 @@ static void weather_update_timer_cb(lv_timer_t *timer)
  */
  static void create_weather_ui(void)
  {
+     // Screens are created when they are shown and deleted when hidden if the heap runs low
+     eez_flow_set_screen_created_func(on_screen_created);
+     eez_flow_set_screen_memory_policy(CONFIG_EXAMPLE_UI_SCREEN_MIN_FREE_HEAP_KB * 1024, get_free_internal_heap);
+
+     // The flow reads the weather data through native variables
+     weather_vars_init();
+
      // Initialize the EEZ Flow UI
+     size_t free_before = get_free_internal_heap();
+     int64_t start_time = esp_timer_get_time();
      ui_init();
+     ESP_LOGI(MAIN_TAG, "UI created in %lld us, using %u bytes of internal heap",
+              (long long)(esp_timer_get_time() - start_time), (unsigned)(free_before - get_free_internal_heap()));
      
      // Initialize the weather client
      init_weather_client();
@@ -753,7 +821,11 @@ static void weather_update_timer_cb(lv_timer_t *timer)
          // Main loop to keep UI responsive
     presence_sensor_init();
     while (1) {
-        ui_tick();
+        // The flow can create and delete screens
+        if (lvgl_port_lock(-1)) {
+            ui_tick();
+            lvgl_port_unlock();
+        }
         vTaskDelay(pdMS_TO_TICKS(10)); // 10 ms delay
     }
  }
@@ -786,6 +858,12 @@ static void update_daily_forecast(void)
     }
     ESP_LOGI(MAIN_TAG, "LVGL lock acquired for daily forecast update.");
 
+    // The forecast is on the Main screen, it's shown when the screen is created again
+    if (!eez_flow_is_screen_created(SCREEN_ID_MAIN)) {
+        lvgl_port_unlock();
+        return;
+    }
+
     for (int i = 0; i < 7; ++i) {
         ESP_LOGI(MAIN_TAG, "Daily forecast loop: Start iteration i = %d", i);
 
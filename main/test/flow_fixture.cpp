@@ -0,0 +1,145 @@
+// Flow assets built in memory for the host tests of eez-flow.cpp.
+// The layout is the one of the EEZ Studio output: every pointer is an offset relative to itself.
+
+#include <cassert>
+#include <cstring>
+#include "flow_fixture.h"
+
+using namespace eez;
+using namespace eez::flow;
+
+// The generated UI is not linked, a test may define its own
+extern "C" __attribute__((weak)) void create_screens(void)
+{
+}
+
+extern "C" {
+__attribute__((weak)) native_var_t native_vars[] = {
+    { NATIVE_VAR_TYPE_NONE, 0, 0, 0 },
+};
+}
+
+// A list of asset pointers as it is stored, the items of ListOfAssetsPtr are not accessible
+struct AssetsList {
+    uint32_t count;
+    AssetsPtr<void> items;
+};
+
+static uint8_t s_arena[64 * 1024] __attribute__((aligned(8)));
+static size_t s_arenaUsed;
+
+template <typename T>
+static T *arenaAlloc(size_t n = 1)
+{
+    s_arenaUsed = (s_arenaUsed + 7) & ~(size_t)7;
+    assert(s_arenaUsed + n * sizeof(T) <= sizeof(s_arena));
+    T *p = (T *)(s_arena + s_arenaUsed);
+    memset((void *)p, 0, n * sizeof(T));
+    s_arenaUsed += n * sizeof(T);
+    return p;
+}
+
+template <typename T>
+static void setList(ListOfAssetsPtr<T> &list, T *items, uint32_t count)
+{
+    static_assert(sizeof(ListOfAssetsPtr<T>) == sizeof(AssetsList), "unexpected asset list layout");
+    auto ptrs = arenaAlloc<AssetsPtr<T>>(count);
+    for (uint32_t i = 0; i < count; i++) {
+        ptrs[i] = items + i;
+    }
+    auto &raw = reinterpret_cast<AssetsList &>(list);
+    raw.count = count;
+    raw.items = ptrs;
+}
+
+static Value *intValues(unsigned count)
+{
+    auto values = arenaAlloc<Value>(count);
+    for (unsigned i = 0; i < count; i++) {
+        new (values + i) Value(0, VALUE_TYPE_INT32);
+    }
+    return values;
+}
+
+// Build the assets in the arena, their size is s_arenaUsed
+static const uint8_t *buildAssets(const std::vector<FlowFixtureComponent> &components, unsigned numGlobals,
+                                  unsigned numLocals)
+{
+    s_arenaUsed = 0;
+
+    auto tag = arenaAlloc<uint32_t>(2);
+    tag[0] = HEADER_TAG;
+    auto assets = (Assets *)(tag + 1);
+    arenaAlloc<Assets>();
+    assets->projectMajorVersion = PROJECT_VERSION_V3;
+    assets->assetsType = ASSETS_TYPE_FIRMWARE;
+    assets->settings = arenaAlloc<Settings>();
+
+    auto flowDefinition = arenaAlloc<FlowDefinition>();
+    assets->flowDefinition = flowDefinition;
+    setList(flowDefinition->globalVariables, intValues(numGlobals), numGlobals);
+
+    auto flow = arenaAlloc<Flow>();
+    setList(flowDefinition->flows, flow, 1);
+    setList(flow->localVariables, intValues(numLocals), numLocals);
+
+    auto comps = arenaAlloc<Component>(components.size());
+    for (size_t c = 0; c < components.size(); c++) {
+        comps[c].type = components[c].type;
+        comps[c].errorCatchOutput = components[c].errorCatchOutput;
+
+        auto &props = components[c].properties;
+        auto propList = arenaAlloc<AssetsPtr<Property>>(props.size());
+        for (size_t p = 0; p < props.size(); p++) {
+            auto instructions = arenaAlloc<uint8_t>(props[p].size() * 2);
+            for (size_t i = 0; i < props[p].size(); i++) {
+                instructions[2 * i] = props[p][i] & 0xFF;
+                instructions[2 * i + 1] = props[p][i] >> 8;
+            }
+            propList[p] = (Property *)instructions;
+        }
+        auto &rawProps = reinterpret_cast<AssetsList &>(comps[c].properties);
+        rawProps.count = props.size();
+        rawProps.items = propList;
+
+        setList(comps[c].outputs, arenaAlloc<ComponentOutput>(components[c].numOutputs), components[c].numOutputs);
+    }
+    setList(flow->components, comps, components.size());
+    return (const uint8_t *)tag;
+}
+
+void flow_fixture_start(const std::vector<FlowFixtureComponent> &components, unsigned numGlobals, unsigned numLocals)
+{
+    if (!isFlowStopped()) {
+        flow_fixture_stop();
+    }
+    auto assets = buildAssets(components, numGlobals, numLocals);
+    loadMainAssets(assets, s_arenaUsed);
+    start(g_mainAssets);
+}
+
+void flow_fixture_init_ui(lv_obj_t **objects, size_t numObjects)
+{
+    if (!isFlowStopped()) {
+        flow_fixture_stop();
+    }
+    auto assets = buildAssets({}, 0, 0);
+    eez_flow_init(assets, s_arenaUsed, objects, numObjects, nullptr, 0, nullptr);
+    flow_fixture_stop();
+}
+
+void flow_fixture_stop(void)
+{
+    stop();
+    tick();
+}
+
+FlowState *flow_fixture_flow_state(void)
+{
+    return getPageFlowState(g_mainAssets, 0);
+}
+
+std::vector<uint16_t> flow_fixture_global_expr(unsigned globalIndex)
+{
+    return { (uint16_t)(EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR | globalIndex), EXPR_EVAL_INSTRUCTION_TYPE_END };
+}
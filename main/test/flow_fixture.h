@@ -0,0 +1,33 @@
+// Flow assets built in memory for the host tests of eez-flow.cpp
+
+#pragma once
+
+#include <vector>
+#include "eez-flow.h"
+
+struct FlowFixtureComponent {
+    uint16_t type;
+    // Evaluation instructions of every property, ended by EXPR_EVAL_INSTRUCTION_TYPE_END
+    std::vector<std::vector<uint16_t>> properties;
+    unsigned numOutputs;
+    // Output the errors of the component are sent to, -1 stops the flow on an error
+    int errorCatchOutput = -1;
+};
+
+// Build uncompressed assets with one flow of the components, the global and the local variables
+// (all integer 0), load them and start the flow. Replaces the assets of the previous call.
+void flow_fixture_start(const std::vector<FlowFixtureComponent> &components, unsigned numGlobals,
+                        unsigned numLocals = 0);
+
+// Initialize the LVGL part of the flow like ui_init() with the objects of the generated UI, create_screens() may
+// be defined by the test. The flow is stopped then, so the screens don't need page flows.
+void flow_fixture_init_ui(lv_obj_t **objects, size_t numObjects);
+
+// Stop the flow and free its flow states
+void flow_fixture_stop(void);
+
+// The flow state of the flow, created on the first call
+eez::flow::FlowState *flow_fixture_flow_state(void);
+
+// Instructions of an expression reading a global variable
+std::vector<uint16_t> flow_fixture_global_expr(unsigned globalIndex);
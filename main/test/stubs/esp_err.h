@@ -0,0 +1,8 @@
+// The part of esp_err.h used by the headers of `main` on the host
+
+#pragma once
+
+typedef int esp_err_t;
+
+#define ESP_OK      0
+#define ESP_FAIL    -1
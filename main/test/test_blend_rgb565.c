@@ -0,0 +1,286 @@
+// Host test of the RGB565 blend kernels with the color format of the display (16 bit, LV_COLOR_MIX_ROUND_OFS 0).
+// The LVGL tests are built with 32 bit colors where lv_draw_sw_blend doesn't use the kernels.
+
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "src/draw/sw/lv_draw_sw_blend_rgb565.h"
+
+#define HOR_RES     320
+#define VER_RES     240
+#define TEST_W      123
+#define TEST_H      17
+#define IMG_SIZE    64
+
+_Static_assert(LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0, "the kernels are used only with this config");
+
+static lv_color_t draw_buf[HOR_RES * 40];
+static lv_color_t fb[HOR_RES * VER_RES];
+static lv_color_t fb_ref[HOR_RES * VER_RES];
+
+static lv_color_t dest_ref[TEST_W * TEST_H + 2];
+static lv_color_t dest_test[TEST_W * TEST_H + 2];
+static lv_color_t src[TEST_W * TEST_H + 2];
+static lv_opa_t mask[TEST_W * TEST_H + 2];
+static unsigned generic_fill_cnt;
+static unsigned generic_map_cnt;
+
+static lv_color_t img_px[IMG_SIZE * IMG_SIZE];
+static lv_img_dsc_t img = {
+    .header.cf = LV_IMG_CF_TRUE_COLOR,
+    .header.w = IMG_SIZE,
+    .header.h = IMG_SIZE,
+    .data_size = sizeof(img_px),
+    .data = (const uint8_t *)img_px,
+};
+
+// The per pixel blending of fill_normal and map_normal in lv_draw_sw_blend.c which the kernels replace
+static void fill_generic(uint16_t *dest, lv_coord_t dest_stride, int32_t w, int32_t h, uint16_t color_full,
+                         lv_opa_t opa, const lv_opa_t *m, lv_coord_t mask_stride)
+{
+    generic_fill_cnt++;
+    lv_color_t *d = (lv_color_t *)dest;
+    lv_color_t color;
+    color.full = color_full;
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            if (m == NULL) {
+                // The opacity is rounded like in lv_color_mix, 252..255 are clamped to cover
+                uint32_t o = LV_MIN(((opa + 4) >> 3) << 3, LV_OPA_COVER);
+                uint16_t premult[3];
+                lv_color_premult(color, o, premult);
+                d[x] = lv_color_mix_premult(premult, d[x], 255 - o);
+            } else if (m[x] == LV_OPA_TRANSP) {
+                continue;
+            } else if (opa >= LV_OPA_MAX) {
+                d[x] = m[x] == LV_OPA_COVER ? color : lv_color_mix(color, d[x], m[x]);
+            } else {
+                lv_opa_t o = m[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)m[x] * opa) >> 8;
+                d[x] = o == LV_OPA_COVER ? color : lv_color_mix(color, d[x], o);
+            }
+        }
+        d += dest_stride;
+        if (m) {
+            m += mask_stride;
+        }
+    }
+}
+
+static void map_generic(uint16_t *dest, lv_coord_t dest_stride, const uint16_t *source, lv_coord_t src_stride,
+                        int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t *m, lv_coord_t mask_stride)
+{
+    generic_map_cnt++;
+    lv_color_t *d = (lv_color_t *)dest;
+    const lv_color_t *s = (const lv_color_t *)source;
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            if (m == NULL) {
+                d[x] = lv_color_mix(s[x], d[x], opa);
+            } else if (m[x] == LV_OPA_TRANSP) {
+                continue;
+            } else if (opa > LV_OPA_MAX) {
+                d[x] = m[x] == LV_OPA_COVER ? s[x] : lv_color_mix(s[x], d[x], m[x]);
+            } else {
+                d[x] = lv_color_mix(s[x], d[x], m[x] >= LV_OPA_MAX ? opa : (opa * m[x]) >> 8);
+            }
+        }
+        d += dest_stride;
+        s += src_stride;
+        if (m) {
+            m += mask_stride;
+        }
+    }
+}
+
+static const lv_draw_sw_blend_rgb565_kernels_t kernels_generic = {
+    .fill = fill_generic,
+    .map = map_generic,
+};
+
+static void flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color)
+{
+    for (int y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], color, lv_area_get_width(area) * sizeof(lv_color_t));
+        color += lv_area_get_width(area);
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t disp_buf;
+    static lv_disp_drv_t disp_drv;
+    lv_disp_draw_buf_init(&disp_buf, draw_buf, NULL, HOR_RES * 40);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.flush_cb = flush;
+    disp_drv.draw_buf = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+}
+
+static void fill_random(void)
+{
+    for (int i = 0; i < TEST_W * TEST_H + 2; i++) {
+        dest_ref[i].full = (uint16_t)rand();
+        dest_test[i] = dest_ref[i];
+        src[i].full = (uint16_t)rand();
+        // Typical anti-aliased masks: mostly transparent or covering
+        int r = rand() % 4;
+        mask[i] = r == 0 ? LV_OPA_TRANSP : r == 1 ? LV_OPA_COVER : (lv_opa_t)rand();
+    }
+}
+
+// Blend the same random pixels with the generic path and the kernels, the destination and source offsets
+// give every alignment of the pairs of pixels
+static void check_kernels(const lv_draw_sw_blend_rgb565_kernels_t *k, int dest_ofs, int src_ofs)
+{
+    static const lv_opa_t opas[] = { 1, 7, 100, 128, 200, 251, 252, 253, 254, 255 };
+    uint16_t *ref = (uint16_t *)dest_ref + dest_ofs;
+    uint16_t *test = (uint16_t *)dest_test + dest_ofs;
+    const uint16_t *s = (const uint16_t *)src + src_ofs;
+    for (unsigned i = 0; i < sizeof(opas); i++) {
+        lv_opa_t opa = opas[i];
+        uint16_t color = (uint16_t)rand();
+
+        fill_random();
+        fill_generic(ref, TEST_W, TEST_W, TEST_H, color, opa, mask + 1, TEST_W);
+        k->fill(test, TEST_W, TEST_W, TEST_H, color, opa, mask + 1, TEST_W);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, TEST_W * TEST_H + 2);
+
+        fill_random();
+        map_generic(ref, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, mask + 1, TEST_W);
+        k->map(test, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, mask + 1, TEST_W);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, TEST_W * TEST_H + 2);
+
+        // Without mask the kernels are called only below LV_OPA_MAX
+        if (opa >= LV_OPA_MAX) {
+            continue;
+        }
+        fill_random();
+        fill_generic(ref, TEST_W, TEST_W, TEST_H, color, opa, NULL, 0);
+        k->fill(test, TEST_W, TEST_W, TEST_H, color, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, TEST_W * TEST_H + 2);
+
+        fill_random();
+        fill_generic(ref, 5, 5, 1, color, opa, NULL, 0);
+        k->fill(test, 5, 5, 1, color, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, TEST_W * TEST_H + 2);
+
+        fill_random();
+        map_generic(ref, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, NULL, 0);
+        k->map(test, TEST_W, s, TEST_W, TEST_W, TEST_H, opa, NULL, 0);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_test, TEST_W * TEST_H + 2);
+    }
+}
+
+// Something of everything the weather screens draw: translucent and rounded rectangles, shadows, anti-aliased
+// text, arcs, lines and images with opacity and transformation
+static void create_scene(void)
+{
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x203040), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x80a0c0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t *panel = lv_obj_create(scr);
+    lv_obj_set_pos(panel, 7, 5);
+    lv_obj_set_size(panel, 181, 121);
+    lv_obj_set_style_radius(panel, 17, 0);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_50, 0);
+    lv_obj_set_style_border_opa(panel, 200, 0);
+    lv_obj_set_style_shadow_width(panel, 20, 0);
+    lv_obj_set_style_shadow_opa(panel, 252, 0);
+
+    lv_obj_t *label = lv_label_create(panel);
+    lv_label_set_text(label, "21.5 \xC2\xB0" "C\nlight rain\n0123456789");
+    lv_obj_set_style_text_opa(label, 230, 0);
+
+    lv_obj_t *arc = lv_arc_create(scr);
+    lv_obj_set_pos(arc, 201, 9);
+    lv_obj_set_size(arc, 101, 101);
+    lv_arc_set_value(arc, 63);
+
+    static lv_point_t points[] = { { 0, 0 }, { 71, 23 }, { 143, 5 }, { 213, 61 } };
+    lv_obj_t *line = lv_line_create(scr);
+    lv_line_set_points(line, points, 4);
+    lv_obj_set_pos(line, 11, 141);
+    lv_obj_set_style_line_width(line, 5, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    lv_obj_set_style_line_opa(line, 180, 0);
+
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *icon = lv_img_create(scr);
+        lv_img_set_src(icon, &img);
+        lv_obj_set_pos(icon, 61 + i * 83, 163);
+        lv_obj_set_style_img_opa(icon, i == 0 ? LV_OPA_COVER : i == 1 ? 153 : 77, 0);
+        if (i == 2) {
+            lv_img_set_angle(icon, 150);
+            lv_img_set_zoom(icon, 300);
+        }
+    }
+}
+
+static void render(const lv_draw_sw_blend_rgb565_kernels_t *k, lv_color_t *out)
+{
+    lv_draw_sw_blend_rgb565_set_kernels(k);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    memcpy(out, fb, sizeof(fb));
+}
+
+void setUp(void)
+{
+    srand(1234);
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_blend_rgb565_set_kernels(NULL);
+}
+
+static void test_c_kernels_match_generic(void)
+{
+    const lv_draw_sw_blend_rgb565_kernels_t *k = lv_draw_sw_blend_rgb565_get_c_kernels();
+    check_kernels(k, 0, 0);
+    check_kernels(k, 1, 1);
+}
+
+static void test_packed_kernels_match_generic(void)
+{
+    const lv_draw_sw_blend_rgb565_kernels_t *k = lv_draw_sw_blend_rgb565_get_packed_kernels();
+    check_kernels(k, 0, 0);
+    check_kernels(k, 1, 1);
+    check_kernels(k, 0, 1);
+    check_kernels(k, 1, 0);
+}
+
+static void test_scene_matches_generic(void)
+{
+    for (int i = 0; i < IMG_SIZE * IMG_SIZE; i++) {
+        img_px[i] = lv_color_make((i % IMG_SIZE) * 4, (i / IMG_SIZE) * 4, (i * 7) & 0xff);
+    }
+    create_scene();
+
+    render(&kernels_generic, fb_ref);
+    TEST_ASSERT_GREATER_THAN(0, generic_fill_cnt);
+    TEST_ASSERT_GREATER_THAN(0, generic_map_cnt);
+    lv_color_t *k_fb = malloc(sizeof(fb));
+    TEST_ASSERT_NOT_NULL(k_fb);
+    render(lv_draw_sw_blend_rgb565_get_c_kernels(), k_fb);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(fb_ref, k_fb, HOR_RES * VER_RES);
+    render(lv_draw_sw_blend_rgb565_get_packed_kernels(), k_fb);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(fb_ref, k_fb, HOR_RES * VER_RES);
+    free(k_fb);
+}
+
+int main(void)
+{
+    lv_init();
+    disp_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_c_kernels_match_generic);
+    RUN_TEST(test_packed_kernels_match_generic);
+    RUN_TEST(test_scene_matches_generic);
+    return UNITY_END();
+}
@@ -0,0 +1,229 @@
+// Soak test of the ring buffer data feed of the line charts
+
+#include <chrono>
+#include <cstring>
+#include "unity.h"
+#include "eez-flow.h"
+
+#define HOR_RES     800
+#define VER_RES     480
+#define DAY         (24 * 60)
+#define WEEK        (7 * DAY)
+#define T0          1700000000u
+
+static lv_color_t draw_buf[HOR_RES * 40];
+static lv_color_t fb[HOR_RES * VER_RES];
+static lv_color_t fb_ref[HOR_RES * VER_RES];
+
+static FlowChartSeries series;
+static lv_obj_t *chart;
+static lv_chart_series_t *chart_series;
+
+static void flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color)
+{
+    for (int y = area->y1; y <= area->y2; y++) {
+        for (int x = area->x1; x <= area->x2; x++) {
+            fb[y * HOR_RES + x] = *color++;
+        }
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t disp_buf;
+    static lv_disp_drv_t disp_drv;
+    lv_disp_draw_buf_init(&disp_buf, draw_buf, NULL, HOR_RES * 40);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.flush_cb = flush;
+    disp_drv.draw_buf = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+}
+
+static size_t lv_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+// A temperature in 0.1 degrees for every minute
+static lv_coord_t sample(uint32_t minute)
+{
+    return 200 + (lv_coord_t)((minute * 7) % 120) - (lv_coord_t)((minute / 60) % 24) * 3;
+}
+
+static lv_obj_t *create_chart(lv_chart_series_t **ser)
+{
+    lv_obj_t *obj = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(obj, 780, 400);
+    lv_chart_set_range(obj, LV_CHART_AXIS_PRIMARY_Y, 100, 400);
+    lv_obj_set_style_size(obj, 0, LV_PART_INDICATOR);
+    *ser = lv_chart_add_series(obj, lv_color_hex(0xff0000), LV_CHART_AXIS_PRIMARY_Y);
+    return obj;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void feed(uint32_t from, uint32_t to)
+{
+    for (uint32_t m = from; m < to; m++) {
+        TEST_ASSERT_TRUE(eez_flow_chart_series_append(&series, T0 + m * 60, sample(m)));
+    }
+}
+
+void setUp(void)
+{
+    TEST_ASSERT_TRUE(eez_flow_chart_series_init(&series, DAY));
+    chart = create_chart(&chart_series);
+    eez_flow_chart_series_attach(&series, chart, chart_series);
+}
+
+void tearDown(void)
+{
+    eez_flow_chart_series_free(&series);
+    lv_obj_clean(lv_scr_act());
+}
+
+static void test_init(void)
+{
+    FlowChartSeries s;
+    TEST_ASSERT_FALSE(eez_flow_chart_series_init(&s, 0));
+    // The number of points of lv_chart is 16 bit
+    TEST_ASSERT_FALSE(eez_flow_chart_series_init(&s, 70000));
+
+    uint32_t first;
+    TEST_ASSERT_EQUAL(0, eez_flow_chart_series_find(&series, 0, UINT32_MAX, &first));
+    TEST_ASSERT_EQUAL_PTR(series.values, lv_chart_get_y_array(chart, chart_series));
+    TEST_ASSERT_EQUAL(DAY, lv_chart_get_point_count(chart));
+}
+
+static void test_week_soak(void)
+{
+    // A week at 1 minute resolution, redrawn every 10 minutes
+    refresh();
+    size_t used_day = 0;
+    long long append_ns = 0;
+    for (uint32_t m = 0; m < WEEK; m++) {
+        auto t0 = std::chrono::steady_clock::now();
+        TEST_ASSERT_TRUE(eez_flow_chart_series_append(&series, T0 + m * 60, sample(m)));
+        append_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        if (m % 10 == 9) {
+            lv_refr_now(NULL);
+        }
+        if (m == DAY) {
+            used_day = lv_used();
+        }
+    }
+    refresh();
+    TEST_PRINTF("a week: LVGL heap used %d after the first day, %d at the end, %d ns per append", (int)used_day,
+                (int)lv_used(), (int)(append_ns / WEEK));
+    TEST_ASSERT_EQUAL(used_day, lv_used());
+    TEST_ASSERT_EQUAL(DAY, series.count);
+
+    // The same points fed to a chart with its own buffer render the same
+    memcpy(fb_ref, fb, sizeof(fb));
+    lv_obj_del(chart);
+    TEST_ASSERT_NULL(series.chart);
+    lv_chart_series_t *ref_series;
+    lv_obj_t *ref_chart = create_chart(&ref_series);
+    lv_chart_set_point_count(ref_chart, DAY);
+    lv_chart_set_update_mode(ref_chart, LV_CHART_UPDATE_MODE_SHIFT);
+    for (uint32_t m = WEEK - DAY; m < WEEK; m++) {
+        lv_chart_set_next_value(ref_chart, ref_series, sample(m));
+    }
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, fb, sizeof(fb));
+    lv_obj_del(ref_chart);
+
+    // Attached again after the chart was deleted, e.g. with its screen
+    chart = create_chart(&chart_series);
+    eez_flow_chart_series_attach(&series, chart, chart_series);
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, fb, sizeof(fb));
+}
+
+static void test_find(void)
+{
+    feed(0, WEEK);
+
+    uint32_t last = T0 + (WEEK - 1) * 60;
+    uint32_t first, time;
+    lv_coord_t value;
+    TEST_ASSERT_EQUAL(60, eez_flow_chart_series_find(&series, last - 3600 + 1, last, &first));
+    eez_flow_chart_series_get(&series, first, &time, &value);
+    TEST_ASSERT_EQUAL(last - 59 * 60, time);
+    TEST_ASSERT_EQUAL(sample(WEEK - 60), value);
+
+    TEST_ASSERT_EQUAL(0, eez_flow_chart_series_find(&series, 0, T0, &first));
+    TEST_ASSERT_EQUAL(0, eez_flow_chart_series_find(&series, last + 1, UINT32_MAX, &first));
+    TEST_ASSERT_EQUAL(DAY, first);
+    TEST_ASSERT_EQUAL(DAY, eez_flow_chart_series_find(&series, 0, UINT32_MAX, &first));
+    TEST_ASSERT_EQUAL(0, first);
+    eez_flow_chart_series_get(&series, 0, &time, &value);
+    TEST_ASSERT_EQUAL(T0 + (WEEK - DAY) * 60, time);
+    TEST_ASSERT_EQUAL(sample(WEEK - DAY), value);
+    TEST_ASSERT_EQUAL(1, eez_flow_chart_series_find(&series, last, last, &first));
+    TEST_ASSERT_EQUAL(DAY - 1, first);
+    TEST_ASSERT_EQUAL(0, eez_flow_chart_series_find(&series, last - 30, last - 90, &first));
+
+    // The time doesn't go back
+    TEST_ASSERT_FALSE(eez_flow_chart_series_append(&series, last - 1, 0));
+    TEST_ASSERT_TRUE(eez_flow_chart_series_append(&series, last, 1));
+    TEST_ASSERT_EQUAL(2, eez_flow_chart_series_find(&series, last, last, &first));
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100000; i++) {
+        eez_flow_chart_series_find(&series, last - 12 * 3600 + i % 100, last, &first);
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    TEST_PRINTF("12 h of 24 h found in %d ns", (int)(ns / 100000));
+}
+
+static void test_partially_filled(void)
+{
+    feed(0, DAY + 10);
+    eez_flow_chart_series_clear(&series);
+    refresh();
+
+    feed(0, 100);
+    TEST_ASSERT_EQUAL(100, series.count);
+    TEST_ASSERT_EQUAL(100, lv_chart_get_x_start_point(chart, chart_series));
+    uint32_t first;
+    TEST_ASSERT_EQUAL(50, eez_flow_chart_series_find(&series, T0 + 50 * 60, UINT32_MAX, &first));
+    TEST_ASSERT_EQUAL(50, first);
+}
+
+static void test_free_keeps_the_chart(void)
+{
+    feed(0, 100);
+    refresh();
+    memcpy(fb_ref, fb, sizeof(fb));
+
+    // Detached, the chart keeps showing the points after the buffer is freed
+    eez_flow_chart_series_free(&series);
+    TEST_ASSERT_NULL(series.times);
+    TEST_ASSERT_NOT_NULL(lv_chart_get_y_array(chart, chart_series));
+    TEST_ASSERT_NOT_EQUAL(series.values, lv_chart_get_y_array(chart, chart_series));
+    refresh();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, fb, sizeof(fb));
+}
+
+int main(void)
+{
+    lv_init();
+    disp_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_init);
+    RUN_TEST(test_week_soak);
+    RUN_TEST(test_find);
+    RUN_TEST(test_partially_filled);
+    RUN_TEST(test_free_keeps_the_chart);
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+// Fragmentation stress test of the allocation pools of eez-flow.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "unity.h"
+#include "eez-flow.h"
+
+using namespace eez;
+
+#define SLOTS           300
+#define LONG_SLOTS      60
+#define STEPS           2000000
+// Biggest block served by a pool
+#define MAX_POOL_SIZE   256
+
+static void *slots[SLOTS];
+static size_t sizes[SLOTS];
+static void *long_slots[LONG_SLOTS];
+static size_t long_sizes[LONG_SLOTS];
+
+// Sizes of the objects the flow churns: string refs and their buffers, array element refs,
+// execution states, small arrays, watch list nodes, now and then a flow state or a big array
+static size_t random_size(void)
+{
+    int r = rand() % 100;
+    if (r < 30) {
+        return 24;
+    }
+    if (r < 50) {
+        return 12 + rand() % 40;
+    }
+    if (r < 60) {
+        return 40;
+    }
+    if (r < 75) {
+        return 24 + 8 * (rand() % 6);
+    }
+    if (r < 90) {
+        return 32 + 16 * (rand() % 10);
+    }
+    if (r < 96) {
+        return 56;
+    }
+    if (r < 99) {
+        return 200 + rand() % 400;
+    }
+    return 1024 + rand() % 1024;
+}
+
+static void *alloc_filled(size_t size, uint8_t fill)
+{
+    void *ptr = eez::alloc(size, 0);
+    TEST_ASSERT_NOT_NULL(ptr);
+    memset(ptr, fill, size);
+    return ptr;
+}
+
+static void check_filled(const void *ptr, size_t size, uint8_t fill)
+{
+    TEST_ASSERT_EQUAL_HEX8(fill, ((const uint8_t *)ptr)[0]);
+    TEST_ASSERT_EQUAL_HEX8(fill, ((const uint8_t *)ptr)[size - 1]);
+}
+
+static unsigned pools_used(void)
+{
+    AllocPoolInfo pools[NUM_ALLOC_POOLS];
+    getAllocPoolInfo(pools);
+    unsigned used = 0;
+    for (unsigned p = 0; p < NUM_ALLOC_POOLS; p++) {
+        used += pools[p].numUsed;
+    }
+    return used;
+}
+
+void setUp(void)
+{
+    srand(1);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_churn(void)
+{
+    uint32_t free_start, alloc_start;
+    getAllocInfo(free_start, alloc_start);
+
+    // Long lived objects (flow states, variables) are allocated between the short lived ones all the time
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < STEPS; i++) {
+        if (i % 5000 == 0) {
+            int l = rand() % LONG_SLOTS;
+            if (long_slots[l]) {
+                check_filled(long_slots[l], long_sizes[l], 0xA0 + l);
+                eez::free(long_slots[l]);
+            }
+            long_sizes[l] = random_size();
+            long_slots[l] = alloc_filled(long_sizes[l], 0xA0 + l);
+        }
+        int s = rand() % SLOTS;
+        if (slots[s]) {
+            check_filled(slots[s], sizes[s], s);
+            eez::free(slots[s]);
+            slots[s] = nullptr;
+        } else {
+            sizes[s] = random_size();
+            slots[s] = alloc_filled(sizes[s], s);
+        }
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_PRINTF("%d ns per alloc/free, during the churn: biggest free block %d, fragmentation %d%%",
+                (int)(ns / STEPS), (int)mon.free_biggest_size, (int)mon.frag_pct);
+
+    // Only the long lived objects stay
+    for (int s = 0; s < SLOTS; s++) {
+        eez::free(slots[s]);
+        slots[s] = nullptr;
+    }
+    unsigned long_pooled = 0;
+    for (int l = 0; l < LONG_SLOTS; l++) {
+        if (long_slots[l]) {
+            check_filled(long_slots[l], long_sizes[l], 0xA0 + l);
+            long_pooled += long_sizes[l] <= MAX_POOL_SIZE;
+        }
+    }
+    TEST_ASSERT_EQUAL(long_pooled, pools_used());
+
+    lv_mem_monitor(&mon);
+    TEST_PRINTF("after: biggest free block %d of %d free, fragmentation %d%%", (int)mon.free_biggest_size,
+                (int)mon.free_size, (int)mon.frag_pct);
+
+    for (int l = 0; l < LONG_SLOTS; l++) {
+        eez::free(long_slots[l]);
+        long_slots[l] = nullptr;
+    }
+    TEST_ASSERT_EQUAL(0, pools_used());
+
+    // The pool blocks left over count as free
+    uint32_t free_end, alloc_end;
+    getAllocInfo(free_end, alloc_end);
+    TEST_ASSERT_EQUAL(free_start + alloc_start, free_end + alloc_end);
+}
+
+static void test_churn_again_leaks_nothing(void)
+{
+    // The slabs of the first churn are there, so nothing more is taken from the heap
+    uint32_t free_start, alloc_start;
+    getAllocInfo(free_start, alloc_start);
+    test_churn();
+    uint32_t free_end, alloc_end;
+    getAllocInfo(free_end, alloc_end);
+    TEST_ASSERT_LESS_OR_EQUAL(alloc_start, alloc_end);
+}
+
+static void test_pool_info(void)
+{
+    AllocPoolInfo pools[NUM_ALLOC_POOLS];
+    getAllocPoolInfo(pools);
+    for (unsigned p = 1; p < NUM_ALLOC_POOLS; p++) {
+        TEST_ASSERT_GREATER_THAN(pools[p - 1].blockSize, pools[p].blockSize);
+    }
+    TEST_ASSERT_EQUAL(MAX_POOL_SIZE, pools[NUM_ALLOC_POOLS - 1].blockSize);
+
+    // Every block of a class is taken from its pool
+    void *ptrs[64];
+    for (unsigned i = 0; i < 64; i++) {
+        ptrs[i] = alloc_filled(MAX_POOL_SIZE, i);
+    }
+    getAllocPoolInfo(pools);
+    TEST_ASSERT_EQUAL(64, pools[NUM_ALLOC_POOLS - 1].numUsed);
+    TEST_ASSERT_GREATER_OR_EQUAL(64, pools[NUM_ALLOC_POOLS - 1].maxUsed);
+    for (unsigned i = 0; i < 64; i++) {
+        check_filled(ptrs[i], MAX_POOL_SIZE, i);
+        eez::free(ptrs[i]);
+    }
+    TEST_ASSERT_EQUAL(0, pools_used());
+
+    // Bigger requests go to the heap
+    void *big = alloc_filled(MAX_POOL_SIZE + 1, 0x55);
+    TEST_ASSERT_EQUAL(0, pools_used());
+    eez::free(big);
+}
+
+int main(void)
+{
+    lv_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_churn);
+    RUN_TEST(test_churn_again_leaks_nothing);
+    RUN_TEST(test_pool_info);
+    return UNITY_END();
+}
@@ -0,0 +1,182 @@
+// Host test and benchmark of the property bindings of the generated screens
+
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include "unity.h"
+#include "flow_fixture.h"
+
+using namespace eez;
+using namespace eez::flow;
+
+#define NUM_GLOBALS     5
+#define NUM_BINDINGS    40
+// The last binding reads the tick, so it is polled
+#define POLLED          (NUM_BINDINGS - 1)
+
+static int32_t widgets[NUM_BINDINGS];
+static unsigned updates[NUM_BINDINGS];
+static unsigned total_updates;
+
+// Like the update functions of screens.c: every binding has its own
+template <unsigned N>
+static void update_widget(void *flowState)
+{
+    widgets[N] = evalIntegerProperty(flowState, N, 0, "Failed to evaluate Value");
+    updates[N]++;
+    total_updates++;
+}
+
+template <size_t... N>
+static void init_bindings(FlowPropertyBinding *bindings, std::index_sequence<N...>)
+{
+    ((bindings[N] = FlowPropertyBinding{ N, 0, update_widget<N>, nullptr, 0, 0, 0, false }), ...);
+}
+
+static FlowPropertyBinding bindings[NUM_BINDINGS];
+static FlowState *flow_state;
+
+static void update_all(void)
+{
+    flowUpdatePropertyBindings(flow_state, bindings, NUM_BINDINGS);
+}
+
+static void reset_counters(void)
+{
+    memset(updates, 0, sizeof(updates));
+    total_updates = 0;
+}
+
+static int32_t global_value(unsigned index)
+{
+    return g_globalVariables->values[index].getInt();
+}
+
+void setUp(void)
+{
+    std::vector<FlowFixtureComponent> components;
+    for (unsigned c = 0; c < NUM_BINDINGS; c++) {
+        // LVGL widgets are never queued
+        FlowFixtureComponent component = { defs_v3::FIRST_LVGL_WIDGET_COMPONENT_TYPE + 1, {}, 0 };
+        if (c == POLLED) {
+            component.properties.push_back({ (uint16_t)(EXPR_EVAL_INSTRUCTION_TYPE_OPERATION | defs_v3::OPERATION_TYPE_SYSTEM_GET_TICK),
+                                             EXPR_EVAL_INSTRUCTION_TYPE_END });
+        } else {
+            component.properties.push_back(flow_fixture_global_expr(c % NUM_GLOBALS));
+        }
+        components.push_back(component);
+    }
+    flow_fixture_start(components, NUM_GLOBALS);
+    flow_state = flow_fixture_flow_state();
+    TEST_ASSERT_NOT_NULL(flow_state);
+
+    init_bindings(bindings, std::make_index_sequence<NUM_BINDINGS>());
+    flowResetPropertyBindings(bindings, NUM_BINDINGS);
+    reset_counters();
+}
+
+void tearDown(void)
+{
+    flow_fixture_stop();
+}
+
+static void test_first_update_evaluates_every_binding(void)
+{
+    update_all();
+    for (unsigned c = 0; c < NUM_BINDINGS; c++) {
+        TEST_ASSERT_EQUAL(1, updates[c]);
+    }
+}
+
+static void test_idle_update_evaluates_only_polled(void)
+{
+    update_all();
+    reset_counters();
+
+    update_all();
+    update_all();
+    TEST_ASSERT_EQUAL(2, updates[POLLED]);
+    TEST_ASSERT_EQUAL(2, total_updates);
+}
+
+static void test_write_updates_the_readers(void)
+{
+    update_all();
+    reset_counters();
+
+    setGlobalVariable(g_mainAssets, 2, Value(7, VALUE_TYPE_INT32));
+    update_all();
+    for (unsigned c = 0; c < POLLED; c++) {
+        TEST_ASSERT_EQUAL(c % NUM_GLOBALS == 2 ? 1 : 0, updates[c]);
+        TEST_ASSERT_EQUAL(global_value(c % NUM_GLOBALS), widgets[c]);
+    }
+
+    // Consumed by the update
+    reset_counters();
+    update_all();
+    TEST_ASSERT_EQUAL(1, total_updates);
+}
+
+static void test_reset_forces_update(void)
+{
+    update_all();
+    reset_counters();
+
+    // A screen is created again
+    flowResetPropertyBindings(bindings, NUM_BINDINGS);
+    update_all();
+    TEST_ASSERT_EQUAL(NUM_BINDINGS, total_updates);
+}
+
+static void test_benchmark(void)
+{
+    // A sensor value changes every 10th tick, compare with evaluating every property on every tick
+    const int ticks = 100000;
+    unsigned long idle_updates[2] = { 0, 0 };
+    long long ns[2];
+    for (int mode = 0; mode < 2; mode++) {
+        flowResetPropertyBindings(bindings, NUM_BINDINGS);
+        auto t0 = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) {
+            bool write = t % 10 == 0;
+            if (write) {
+                setGlobalVariable(g_mainAssets, (t / 10) % NUM_GLOBALS, Value(t + mode, VALUE_TYPE_INT32));
+            }
+            unsigned before = total_updates;
+            if (mode == 0) {
+                for (unsigned c = 0; c < NUM_BINDINGS; c++) {
+                    bindings[c].update(flow_state);
+                }
+            } else {
+                update_all();
+            }
+            if (!write) {
+                idle_updates[mode] += total_updates - before;
+            }
+        }
+        ns[mode] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+
+        // No widget is stale
+        for (unsigned c = 0; c < POLLED; c++) {
+            TEST_ASSERT_EQUAL(global_value(c % NUM_GLOBALS), widgets[c]);
+        }
+    }
+
+    int idle_ticks = ticks - ticks / 10;
+    TEST_ASSERT_EQUAL(idle_ticks, idle_updates[1]);
+    TEST_PRINTF("%d bindings, %d idle ticks: %d updates and %d ns per tick if every property is evaluated, "
+                "%d updates and %d ns per tick with bindings", NUM_BINDINGS, idle_ticks, (int)idle_updates[0],
+                (int)(ns[0] / ticks), (int)idle_updates[1], (int)(ns[1] / ticks));
+}
+
+int main(void)
+{
+    lv_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_first_update_evaluates_every_binding);
+    RUN_TEST(test_idle_update_evaluates_only_polled);
+    RUN_TEST(test_write_updates_the_readers);
+    RUN_TEST(test_reset_forces_update);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
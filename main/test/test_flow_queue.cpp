@@ -0,0 +1,111 @@
+// Host test of the task priorities of the eez-flow.cpp queue
+
+#include "unity.h"
+#include "flow_fixture.h"
+
+using namespace eez;
+using namespace eez::flow;
+
+#define NUM_TASKS   20
+// The time doesn't advance on the host, so the Delay never ends
+#define DELAY_MS    1000
+
+static FlowState *flow_state;
+
+static void start_flow(unsigned numLogs, unsigned numMqtt)
+{
+    // A Delay and Log actions (UI update), MQTT actions (background), all queued when the flow state is created.
+    // There is no MQTT connection on the host, the errors of the MQTT actions go to their catch output.
+    std::vector<FlowFixtureComponent> components;
+    components.push_back({ defs_v3::COMPONENT_TYPE_DELAY_ACTION, { flow_fixture_global_expr(0) }, 1 });
+    for (unsigned i = 0; i < numLogs; i++) {
+        components.push_back({ defs_v3::COMPONENT_TYPE_LOG_ACTION, { flow_fixture_global_expr(1) }, 1 });
+    }
+    for (unsigned i = 0; i < numMqtt; i++) {
+        components.push_back({ defs_v3::COMPONENT_TYPE_MQTT_DISCONNECT_ACTION, { flow_fixture_global_expr(1) }, 1, 0 });
+    }
+    flow_fixture_start(components, 2);
+    setGlobalVariable(g_mainAssets, 0, Value(DELAY_MS, VALUE_TYPE_INT32));
+    flow_state = flow_fixture_flow_state();
+    TEST_ASSERT_NOT_NULL(flow_state);
+    resetQueueStats();
+}
+
+static uint32_t executed(TaskPriority priority)
+{
+    TaskPriorityStats stats[NUM_TASK_PRIORITIES];
+    getTaskPriorityStats(stats);
+    return stats[priority].numExecuted;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    flow_fixture_stop();
+}
+
+static void test_delay_does_not_block_background(void)
+{
+    start_flow(0, NUM_TASKS);
+    TEST_ASSERT_EQUAL(1 + NUM_TASKS, getQueueSize());
+
+    // The Delay is executed once, then the tick goes on with the background tasks
+    tick();
+    TEST_ASSERT_EQUAL(1, executed(TASK_PRIORITY_UI_UPDATE));
+    TEST_ASSERT_EQUAL(NUM_TASKS, executed(TASK_PRIORITY_BACKGROUND));
+    TEST_ASSERT_EQUAL(1, getQueueSize());
+    TEST_ASSERT_TRUE(isInQueue(flow_state, 0));
+    TEST_ASSERT_FALSE(isFlowStopped());
+}
+
+static void test_log_runs_with_the_ui_updates(void)
+{
+    start_flow(NUM_TASKS, NUM_TASKS);
+
+    // The Log actions keep their place in the flow after the Delay, before the background tasks
+    tick();
+    TEST_ASSERT_EQUAL(1 + NUM_TASKS, executed(TASK_PRIORITY_UI_UPDATE));
+    TEST_ASSERT_EQUAL(NUM_TASKS, executed(TASK_PRIORITY_BACKGROUND));
+    TEST_ASSERT_EQUAL(1, getQueueSize());
+}
+
+static void test_delay_is_executed_once_per_tick(void)
+{
+    start_flow(0, 0);
+
+    for (unsigned i = 1; i <= 10; i++) {
+        tick();
+        TEST_ASSERT_EQUAL(i, executed(TASK_PRIORITY_UI_UPDATE));
+        TEST_ASSERT_EQUAL(1, getQueueSize());
+    }
+    TEST_ASSERT_EQUAL(0, getTickMaxDurationCounter());
+}
+
+static void test_background_added_during_tick(void)
+{
+    start_flow(0, NUM_TASKS);
+    tick();
+
+    // Tasks added between the ticks are executed in the next one, the Delay doesn't hold them back
+    for (unsigned i = 1; i <= NUM_TASKS; i++) {
+        addToQueue(flow_state, i, -1, -1, -1, false);
+    }
+    tick();
+    TEST_ASSERT_EQUAL(2, executed(TASK_PRIORITY_UI_UPDATE));
+    TEST_ASSERT_EQUAL(2 * NUM_TASKS, executed(TASK_PRIORITY_BACKGROUND));
+    TEST_ASSERT_EQUAL(1, getQueueSize());
+}
+
+int main(void)
+{
+    lv_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_delay_does_not_block_background);
+    RUN_TEST(test_log_runs_with_the_ui_updates);
+    RUN_TEST(test_delay_is_executed_once_per_tick);
+    RUN_TEST(test_background_added_during_tick);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+// Host test of the screen memory policy of eez-flow.cpp: hidden screens are deleted when the memory is low
+
+#include <cstring>
+#include "unity.h"
+#include "flow_fixture.h"
+
+#define HOR_RES     320
+#define VER_RES     240
+#define NUM_SCREENS 3
+#define ANIM_MS     500
+
+static const char *screen_names[NUM_SCREENS] = { "Main", "PC", "Settings" };
+static lv_obj_t *screens[NUM_SCREENS];
+static unsigned num_created[NUM_SCREENS];
+static size_t free_memory;
+
+static lv_color_t draw_buf[HOR_RES * 20];
+
+static void flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color)
+{
+    (void)area;
+    (void)color;
+    lv_disp_flush_ready(drv);
+}
+
+static void disp_init(void)
+{
+    static lv_disp_draw_buf_t disp_buf;
+    static lv_disp_drv_t disp_drv;
+    lv_disp_draw_buf_init(&disp_buf, draw_buf, NULL, HOR_RES * 20);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = HOR_RES;
+    disp_drv.ver_res = VER_RES;
+    disp_drv.flush_cb = flush;
+    disp_drv.draw_buf = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+}
+
+static void create_screen(int index)
+{
+    screens[index] = lv_obj_create(nullptr);
+    lv_label_set_text(lv_label_create(screens[index]), screen_names[index]);
+    num_created[index]++;
+}
+
+static void delete_screen(int index)
+{
+    lv_obj_del(screens[index]);
+    screens[index] = nullptr;
+}
+
+extern "C" void create_screens(void)
+{
+    create_screen(0);
+}
+
+static size_t get_free_memory()
+{
+    return free_memory;
+}
+
+// The time doesn't advance on the host, the LVGL timers and animations are run by hand
+static void run(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += 10) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+}
+
+void setUp(void)
+{
+    free_memory = 0;
+    eez_flow_set_screen(1, LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    run(20);
+    for (int i = 1; i < NUM_SCREENS; i++) {
+        eez_flow_delete_screen(i + 1);
+    }
+    memset(num_created, 0, sizeof(num_created));
+}
+
+void tearDown(void)
+{
+}
+
+static void test_hidden_screen_is_deleted(void)
+{
+    eez_flow_set_screen(2, LV_SCR_LOAD_ANIM_FADE_ON, ANIM_MS, 0);
+    TEST_ASSERT_NOT_NULL(screens[1]);
+    run(2 * ANIM_MS);
+    TEST_ASSERT_EQUAL_PTR(screens[1], lv_scr_act());
+    TEST_ASSERT_NULL(screens[0]);
+
+    // Enough memory: the hidden screen is kept
+    free_memory = 1;
+    eez_flow_set_screen(1, LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    run(20);
+    TEST_ASSERT_EQUAL_PTR(screens[0], lv_scr_act());
+    TEST_ASSERT_NOT_NULL(screens[1]);
+}
+
+static void test_interrupted_screen_load(void)
+{
+    // Main -> PC is interrupted by PC -> Main half way, then by Main -> Settings before it starts
+    eez_flow_set_screen(2, LV_SCR_LOAD_ANIM_FADE_ON, ANIM_MS, 0);
+    run(ANIM_MS / 2);
+    eez_flow_set_screen(1, LV_SCR_LOAD_ANIM_OVER_LEFT, ANIM_MS, 0);
+    TEST_ASSERT_NOT_NULL(lv_scr_act());
+    run(ANIM_MS / 2);
+    eez_flow_set_screen(3, LV_SCR_LOAD_ANIM_FADE_ON, ANIM_MS, ANIM_MS);
+    TEST_ASSERT_NOT_NULL(lv_scr_act());
+    run(ANIM_MS / 2);
+    eez_flow_set_screen(2, LV_SCR_LOAD_ANIM_MOVE_TOP, ANIM_MS, 0);
+    TEST_ASSERT_NOT_NULL(lv_scr_act());
+
+    // Only the last screen is left when the animations are over
+    run(3 * ANIM_MS);
+    TEST_ASSERT_NOT_NULL(screens[1]);
+    TEST_ASSERT_EQUAL_PTR(screens[1], lv_scr_act());
+    TEST_ASSERT_NULL(screens[0]);
+    TEST_ASSERT_NULL(screens[2]);
+    TEST_ASSERT_EQUAL(2, eez_flow_get_current_screen());
+}
+
+static void test_screen_shown_again_is_kept(void)
+{
+    // Main is unloaded, then loaded again before the deferred delete runs
+    eez_flow_set_screen(2, LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    eez_flow_set_screen(1, LV_SCR_LOAD_ANIM_NONE, 0, 0);
+    run(20);
+    TEST_ASSERT_NOT_NULL(screens[0]);
+    TEST_ASSERT_EQUAL_PTR(screens[0], lv_scr_act());
+    TEST_ASSERT_NULL(screens[1]);
+    TEST_ASSERT_EQUAL(0, num_created[0]);
+}
+
+int main(void)
+{
+    lv_init();
+    disp_init();
+    eez_flow_init_screen_names(screen_names, NUM_SCREENS);
+    eez_flow_set_create_screen_func(create_screen);
+    eez_flow_set_delete_screen_func(delete_screen);
+    eez_flow_set_screen_memory_policy(1, get_free_memory);
+    flow_fixture_init_ui(screens, NUM_SCREENS);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_hidden_screen_is_deleted);
+    RUN_TEST(test_interrupted_screen_load);
+    RUN_TEST(test_screen_shown_again_is_kept);
+    return UNITY_END();
+}
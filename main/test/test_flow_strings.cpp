@@ -0,0 +1,173 @@
+// Host test of the small strings of eez-flow.cpp
+
+#include <cstdio>
+#include <cstring>
+#include "unity.h"
+#include "flow_fixture.h"
+
+using namespace eez;
+using namespace eez::flow;
+
+// More than the short lived copies getString() once returned for temporaries
+#define NUM_STRINGS     6
+
+static void get_native_string(void *value)
+{
+    *(Value *)value = Value::makeStringRef("native", -1, 0);
+}
+
+// A different string every time it is read
+static unsigned num_counter_reads;
+static void get_counter_string(void *value)
+{
+    char str[SMALL_STRING_SIZE];
+    snprintf(str, sizeof(str), "read %u", num_counter_reads++);
+    *(Value *)value = Value::makeStringRef(str, -1, 0);
+}
+
+extern "C" {
+native_var_t native_vars[] = {
+    { NATIVE_VAR_TYPE_NONE, 0, 0, 0 },
+    { NATIVE_VAR_TYPE_VALUE, (void *)get_native_string, 0, 0 },
+    { NATIVE_VAR_TYPE_VALUE, (void *)get_counter_string, 0, 0 },
+};
+}
+
+static FlowState *flow_state;
+
+void setUp(void)
+{
+    // One property reads a global variable, the last one the native variable
+    FlowFixtureComponent component = { defs_v3::FIRST_LVGL_WIDGET_COMPONENT_TYPE + 1, {}, 0 };
+    for (unsigned i = 0; i < NUM_STRINGS; i++) {
+        component.properties.push_back(flow_fixture_global_expr(i));
+    }
+    component.properties.push_back(flow_fixture_global_expr(NUM_STRINGS));
+    flow_fixture_start({ component }, NUM_STRINGS);
+    flow_state = flow_fixture_flow_state();
+    TEST_ASSERT_NOT_NULL(flow_state);
+
+    for (unsigned i = 0; i < NUM_STRINGS; i++) {
+        char str[SMALL_STRING_SIZE];
+        snprintf(str, sizeof(str), "string %u", i);
+        setGlobalVariable(g_mainAssets, i, Value::makeStringRef(str, -1, 0));
+    }
+}
+
+void tearDown(void)
+{
+    flow_fixture_stop();
+}
+
+static void test_evaluated_strings_stay_valid(void)
+{
+    // Like the arguments of eez_mqtt_init(): every string is used after all are evaluated
+    Value values[NUM_STRINGS];
+    const char *strs[NUM_STRINGS];
+    for (unsigned i = 0; i < NUM_STRINGS; i++) {
+        TEST_ASSERT_TRUE(evalProperty(flow_state, 0, i, values[i], FlowError::Plain("")));
+        TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_SMALL, values[i].getType());
+        strs[i] = values[i].getString();
+    }
+    for (unsigned i = 0; i < NUM_STRINGS; i++) {
+        char str[SMALL_STRING_SIZE];
+        snprintf(str, sizeof(str), "string %u", i);
+        TEST_ASSERT_EQUAL_STRING(str, strs[i]);
+        TEST_ASSERT_EQUAL_PTR(values[i].getString(), strs[i]);
+    }
+}
+
+static void test_native_variable_is_resolved(void)
+{
+    Value value;
+    TEST_ASSERT_TRUE(evalProperty(flow_state, 0, NUM_STRINGS, value, FlowError::Plain("")));
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_SMALL, value.getType());
+    TEST_ASSERT_EQUAL_STRING("native", value.getString());
+
+    Value var((int)1, VALUE_TYPE_NATIVE_VARIABLE);
+    auto resolved = var.getValue();
+    TEST_ASSERT_EQUAL_STRING("native", resolved.getString());
+
+    // Read without resolving: a copy which is the same every time
+    const char *str = var.getString();
+    TEST_ASSERT_EQUAL_STRING("native", str);
+    TEST_ASSERT_EQUAL_PTR(str, var.getString());
+}
+
+static void test_native_variable_strings_stay_valid(void)
+{
+    // More strings than the table of the copies holds, all read in one tick
+    Value var((int)2, VALUE_TYPE_NATIVE_VARIABLE);
+    const char *strs[200];
+    num_counter_reads = 0;
+    for (unsigned i = 0; i < 200; i++) {
+        strs[i] = var.getString();
+    }
+    for (unsigned i = 0; i < 200; i++) {
+        char str[SMALL_STRING_SIZE];
+        snprintf(str, sizeof(str), "read %u", i);
+        TEST_ASSERT_EQUAL_STRING(str, strs[i]);
+    }
+
+    // The copies which didn't fit into the table are freed with the next tick
+    uint32_t free_before, alloc_before;
+    getAllocInfo(free_before, alloc_before);
+    tick();
+    uint32_t free_after, alloc_after;
+    getAllocInfo(free_after, alloc_after);
+    TEST_ASSERT_LESS_THAN(alloc_before, alloc_after);
+
+    num_counter_reads = 0;
+    TEST_ASSERT_EQUAL_STRING("read 0", var.getString());
+}
+
+static void test_concatenate(void)
+{
+    auto small = Value::concatenateString(Value("hello "), Value("world"));
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_SMALL, small.getType());
+    TEST_ASSERT_EQUAL_STRING("hello world", small.getString());
+
+    auto ref = Value::concatenateString(Value("hello "), Value("world!"));
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_REF, ref.getType());
+    TEST_ASSERT_EQUAL_STRING("hello world!", ref.getString());
+
+    char text[SMALL_STRING_SIZE];
+    small.toText(text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("hello world", text);
+    TEST_ASSERT_EQUAL_STRING("hello world", small.clone().getString());
+}
+
+static void test_make_string_ref(void)
+{
+    TEST_ASSERT_EQUAL_STRING("abc", Value::makeStringRef("abcdef", 3, 0).getString());
+
+    auto empty = Value::makeStringRef("", 5, 0);
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_SMALL, empty.getType());
+    TEST_ASSERT_EQUAL_STRING("", empty.getString());
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING_REF, Value::makeStringRef("", 20, 0).getType());
+}
+
+static void test_references_point_to_the_string(void)
+{
+    auto str = Value::makeStringRef("small", -1, 0);
+    Value ptr(&str);
+    TEST_ASSERT_EQUAL_PTR(str.getString(), ptr.getString());
+
+    auto array = Value::makeArrayRef(2, 0, 0);
+    array.getArray()->values[1] = str;
+    auto element = Value::makeArrayElementRef(array, 1, 0);
+    TEST_ASSERT_EQUAL_PTR(array.getArray()->values[1].getString(), element.getString());
+}
+
+int main(void)
+{
+    lv_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_evaluated_strings_stay_valid);
+    RUN_TEST(test_native_variable_is_resolved);
+    RUN_TEST(test_native_variable_strings_stay_valid);
+    RUN_TEST(test_concatenate);
+    RUN_TEST(test_make_string_ref);
+    RUN_TEST(test_references_point_to_the_string);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+// Host test of the worker thread backend of lvgl_port_copy
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "unity.h"
+#include "lvgl_port_copy.h"
+
+#define FB_W    800
+#define FB_H    480
+#define BUF_H   100
+
+static uint16_t fb[FB_W * FB_H] __attribute__((aligned(LVGL_PORT_COPY_ALIGN)));
+static uint16_t buf[FB_W * BUF_H] __attribute__((aligned(LVGL_PORT_COPY_ALIGN)));
+static atomic_int done_cnt;
+static lvgl_port_copy_handle_t copy;
+
+// Called on the worker thread, so count instead of asserting
+static bool copy_done(lvgl_port_copy_handle_t handle, void *user_ctx)
+{
+    if (handle == copy && user_ctx == &done_cnt) {
+        atomic_fetch_add(&done_cnt, 1);
+    }
+    return false;
+}
+
+static void wait_done(int cnt)
+{
+    while (atomic_load(&done_cnt) != cnt) {
+        usleep(10);
+    }
+    TEST_ASSERT_FALSE(lvgl_port_copy_is_busy(copy));
+}
+
+void setUp(void)
+{
+    memset(fb, 0, sizeof(fb));
+    for (int i = 0; i < FB_W * BUF_H; i++) {
+        buf[i] = (uint16_t)i;
+    }
+    atomic_store(&done_cnt, 0);
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_copy_new(BUF_H, copy_done, &done_cnt, &copy));
+}
+
+void tearDown(void)
+{
+    lvgl_port_copy_del(copy);
+}
+
+static void test_copy_rect(void)
+{
+    // 160x50 rectangle at (32;10) of the frame buffer
+    const int x = 32, y = 10, w = 160, h = 50;
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_copy_rect(copy, &fb[y * FB_W + x], FB_W * 2, buf, w * 2, w * 2, h));
+    wait_done(1);
+
+    for (int row = 0; row < FB_H; row++) {
+        for (int col = 0; col < FB_W; col++) {
+            bool inside = row >= y && row < y + h && col >= x && col < x + w;
+            uint16_t expected = inside ? buf[(row - y) * w + col - x] : 0;
+            TEST_ASSERT_EQUAL_HEX16(expected, fb[row * FB_W + col]);
+        }
+    }
+}
+
+static void test_copy_full_width(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_copy_rect(copy, &fb[100 * FB_W], FB_W * 2, buf, FB_W * 2, FB_W * 2, BUF_H));
+    wait_done(1);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(buf, &fb[100 * FB_W], FB_W * BUF_H);
+}
+
+static void test_copy_unaligned_is_rejected(void)
+{
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_copy_rect(copy, &fb[1], FB_W * 2, buf, 320, 320, 10));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_copy_rect(copy, fb, FB_W * 2 + 2, buf, 320, 320, 10));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_copy_rect(copy, fb, FB_W * 2, buf, 320, 318, 10));
+    TEST_ASSERT_FALSE(lvgl_port_copy_is_busy(copy));
+    TEST_ASSERT_EQUAL(0, atomic_load(&done_cnt));
+
+    // Nothing is copied
+    for (int i = 0; i < FB_W * FB_H; i++) {
+        TEST_ASSERT_EQUAL_HEX16(0, fb[i]);
+    }
+}
+
+static void test_copy_many(void)
+{
+    // Every rectangle is started as soon as the previous one is done, like the flushes of LVGL
+    for (int i = 0; i < 1000; i++) {
+        while (lvgl_port_copy_is_busy(copy)) {
+        }
+        TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_copy_rect(copy, &fb[(i % 4) * FB_W * BUF_H], FB_W * 2, buf, FB_W * 2,
+                                                      FB_W * 2, BUF_H));
+    }
+    wait_done(1000);
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(buf, &fb[i * FB_W * BUF_H], FB_W * BUF_H);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_copy_rect);
+    RUN_TEST(test_copy_full_width);
+    RUN_TEST(test_copy_unaligned_is_rejected);
+    RUN_TEST(test_copy_many);
+    return UNITY_END();
+}
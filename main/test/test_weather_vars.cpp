@@ -0,0 +1,230 @@
+// Host test of the weather data native variables
+
+#include <cstdio>
+#include <cstring>
+#include "unity.h"
+#include "flow_fixture.h"
+#include "weather_structs.h"
+#include "weather_vars.h"
+
+using namespace eez;
+using namespace eez::flow;
+
+// A global variable and the native variables, every binding reads one of them
+#define BINDING_GLOBAL  0
+#define NUM_BINDINGS    4
+
+static unsigned num_globals;
+static FlowState *flow_state;
+static unsigned updates[NUM_BINDINGS];
+static FlowPropertyBinding bindings[NUM_BINDINGS];
+
+template <unsigned N>
+static void update_binding(void *)
+{
+    updates[N]++;
+}
+
+static uint16_t native_expr(int id)
+{
+    return EXPR_EVAL_INSTRUCTION_TYPE_PUSH_GLOBAL_VAR | (num_globals + id - 1);
+}
+
+static void start_flow(unsigned numGlobals, unsigned globalIndex = 0)
+{
+    num_globals = numGlobals;
+    FlowFixtureComponent component = { defs_v3::FIRST_LVGL_WIDGET_COMPONENT_TYPE + 1, {}, 0 };
+    component.properties.push_back(flow_fixture_global_expr(globalIndex));
+    for (int id = NATIVE_VARIABLE_CURRENT_WEATHER; id <= NATIVE_VARIABLE_DAILY_FORECAST; id++) {
+        component.properties.push_back({ native_expr(id), EXPR_EVAL_INSTRUCTION_TYPE_END });
+    }
+    flow_fixture_start({ component }, numGlobals);
+    flow_state = flow_fixture_flow_state();
+    TEST_ASSERT_NOT_NULL(flow_state);
+
+    bindings[0] = FlowPropertyBinding{ 0, 0, update_binding<0>, nullptr, 0, 0, 0, false };
+    bindings[1] = FlowPropertyBinding{ 0, 1, update_binding<1>, nullptr, 0, 0, 0, false };
+    bindings[2] = FlowPropertyBinding{ 0, 2, update_binding<2>, nullptr, 0, 0, 0, false };
+    bindings[3] = FlowPropertyBinding{ 0, 3, update_binding<3>, nullptr, 0, 0, 0, false };
+    flowResetPropertyBindings(bindings, NUM_BINDINGS);
+    memset(updates, 0, sizeof(updates));
+}
+
+// Like ui_tick(): the versions are checked, then the bindings are updated
+static void ui_tick(void)
+{
+    tick();
+    flowUpdatePropertyBindings(flow_state, bindings, NUM_BINDINGS);
+}
+
+static Value eval_native(int id)
+{
+    Value value;
+    TEST_ASSERT_TRUE(evalProperty(flow_state, 0, id, value, FlowError::Plain("")));
+    return value;
+}
+
+static weather_data_t canned(float shift)
+{
+    weather_data_t w;
+    memset(&w, 0, sizeof(w));
+    w.temperature = 21.5f + shift;
+    strcpy(w.description, "light rain");
+    strcpy(w.icon, "10d");
+    w.temp_min = 14;
+    w.temp_max = 23;
+    w.hourly_count = MAX_HOURLY_FORECAST;
+    for (int i = 0; i < MAX_HOURLY_FORECAST; i++) {
+        w.hourly[i].timestamp = 1760000000 + i * 3600;
+        w.hourly[i].temperature = 20 + i + shift;
+        snprintf(w.hourly[i].icon, sizeof(w.hourly[i].icon), "%02dd", i + 1);
+    }
+    w.daily_count = MAX_DAILY_FORECAST;
+    for (int i = 0; i < MAX_DAILY_FORECAST; i++) {
+        w.daily[i].timestamp = 1760000000 + i * 86400;
+        w.daily[i].temp_min = 10 + i;
+        w.daily[i].temp_max = 20 + i + shift;
+        strcpy(w.daily[i].icon, "04d");
+    }
+    w.last_forecast_update = 1760000000;
+    return w;
+}
+
+void setUp(void)
+{
+    weather_data_t w = canned(0);
+    weather_vars_set(&w);
+    start_flow(1);
+}
+
+void tearDown(void)
+{
+    flow_fixture_stop();
+}
+
+static void test_flow_sees_the_data(void)
+{
+    CurrentWeatherValue current(eval_native(NATIVE_VARIABLE_CURRENT_WEATHER));
+    TEST_ASSERT_EQUAL(1760000000, current.time());
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, current.temperature());
+    TEST_ASSERT_EQUAL_FLOAT(23.0f, current.temp_max());
+    TEST_ASSERT_EQUAL_STRING("light rain", current.description());
+    TEST_ASSERT_EQUAL_STRING("10d", current.icon());
+    // A known icon code is not copied
+    TEST_ASSERT_EQUAL(VALUE_TYPE_STRING, current.value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_ICON].type);
+
+    ArrayOfHourlyForecastValue hourly(eval_native(NATIVE_VARIABLE_HOURLY_FORECAST));
+    TEST_ASSERT_EQUAL(MAX_HOURLY_FORECAST, hourly.size());
+    TEST_ASSERT_EQUAL(1760000000 + 6 * 3600, hourly.at(6).time());
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, hourly.at(2).temperature());
+    TEST_ASSERT_EQUAL_STRING("04d", hourly.at(3).icon());
+
+    ArrayOfDailyForecastValue daily(eval_native(NATIVE_VARIABLE_DAILY_FORECAST));
+    TEST_ASSERT_EQUAL(MAX_DAILY_FORECAST, daily.size());
+    TEST_ASSERT_EQUAL_FLOAT(17.0f, daily.at(7).temp_min());
+    TEST_ASSERT_EQUAL_STRING("04d", daily.at(1).icon());
+
+    // Built once per version
+    TEST_ASSERT_EQUAL_PTR(hourly.value.getArray(), eval_native(NATIVE_VARIABLE_HOURLY_FORECAST).getArray());
+}
+
+static void test_values_survive_new_data(void)
+{
+    CurrentWeatherValue current(eval_native(NATIVE_VARIABLE_CURRENT_WEATHER));
+    ArrayOfDailyForecastValue daily(eval_native(NATIVE_VARIABLE_DAILY_FORECAST));
+
+    // The flow still holds the old values when the snapshot is overwritten
+    weather_data_t w = canned(5);
+    strcpy(w.description, "clear sky");
+    strcpy(w.icon, "01d");
+    strcpy(w.daily[1].icon, "01d");
+    weather_vars_set(&w);
+    TEST_ASSERT_EQUAL_STRING("light rain", current.description());
+    TEST_ASSERT_EQUAL_STRING("10d", current.icon());
+    TEST_ASSERT_EQUAL_STRING("04d", daily.at(1).icon());
+
+    CurrentWeatherValue newCurrent(eval_native(NATIVE_VARIABLE_CURRENT_WEATHER));
+    TEST_ASSERT_EQUAL_STRING("clear sky", newCurrent.description());
+    ArrayOfDailyForecastValue newDaily(eval_native(NATIVE_VARIABLE_DAILY_FORECAST));
+    TEST_ASSERT_EQUAL_STRING("01d", newDaily.at(1).icon());
+}
+
+static void test_bindings_update_on_new_data(void)
+{
+    ui_tick();
+    for (unsigned i = 0; i < NUM_BINDINGS; i++) {
+        TEST_ASSERT_EQUAL(1, updates[i]);
+        TEST_ASSERT_FALSE(bindings[i].poll);
+    }
+
+    // The same data: nothing is evaluated again
+    weather_data_t w = canned(0);
+    weather_vars_set(&w);
+    for (int t = 0; t < 10; t++) {
+        ui_tick();
+    }
+    for (unsigned i = 0; i < NUM_BINDINGS; i++) {
+        TEST_ASSERT_EQUAL(1, updates[i]);
+    }
+
+    // Only the daily forecast changes
+    w.daily[3].temp_max += 1;
+    weather_vars_set(&w);
+    ui_tick();
+    TEST_ASSERT_EQUAL(1, updates[NATIVE_VARIABLE_CURRENT_WEATHER]);
+    TEST_ASSERT_EQUAL(1, updates[NATIVE_VARIABLE_HOURLY_FORECAST]);
+    TEST_ASSERT_EQUAL(2, updates[NATIVE_VARIABLE_DAILY_FORECAST]);
+    TEST_ASSERT_EQUAL(1, updates[BINDING_GLOBAL]);
+}
+
+static void test_forecast_update_time_is_compared(void)
+{
+    // current_weather.time is the time of the last forecast update
+    auto version = var_current_weather_version;
+    weather_data_t w = canned(0);
+    w.last_forecast_update += 600;
+    weather_vars_set(&w);
+    TEST_ASSERT_EQUAL(version + 1, var_current_weather_version);
+    CurrentWeatherValue current(eval_native(NATIVE_VARIABLE_CURRENT_WEATHER));
+    TEST_ASSERT_EQUAL(1760000600, current.time());
+}
+
+static void test_restart_tracks_again(void)
+{
+    ui_tick();
+
+    // The native variables follow 3 global variables now, the global variable 1 was current_weather
+    flow_fixture_stop();
+    start_flow(3, 1);
+    ui_tick();
+    memset(updates, 0, sizeof(updates));
+
+    weather_data_t w = canned(0);
+    w.temperature += 1;
+    weather_vars_set(&w);
+    ui_tick();
+    TEST_ASSERT_EQUAL(1, updates[NATIVE_VARIABLE_CURRENT_WEATHER]);
+    TEST_ASSERT_EQUAL(0, updates[NATIVE_VARIABLE_DAILY_FORECAST]);
+    TEST_ASSERT_EQUAL(0, updates[BINDING_GLOBAL]);
+
+    // More restarts than versioned native variables can be tracked
+    for (unsigned i = 0; i < 10; i++) {
+        flow_fixture_stop();
+        start_flow(1 + i);
+        ui_tick();
+        TEST_ASSERT_FALSE(bindings[NATIVE_VARIABLE_CURRENT_WEATHER].poll);
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    weather_vars_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_flow_sees_the_data);
+    RUN_TEST(test_values_survive_new_data);
+    RUN_TEST(test_bindings_update_on_new_data);
+    RUN_TEST(test_forecast_update_time_is_compared);
+    RUN_TEST(test_restart_tracks_again);
+    return UNITY_END();
+}
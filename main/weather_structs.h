@@ -0,0 +1,187 @@
+#ifndef WEATHER_STRUCTS_H
+#define WEATHER_STRUCTS_H
+
+// Flow structures of the weather native variables, in the style of the structures EEZ Studio generates in
+// UI/structs.h. They are kept out of the generated files until the EEZ Studio project declares them.
+
+#include "UI/eez-flow.h"
+
+using namespace eez;
+
+enum FlowStructures {
+    FLOW_STRUCTURE_CURRENT_WEATHER = 16384,
+    FLOW_STRUCTURE_HOURLY_FORECAST = 16385,
+    FLOW_STRUCTURE_DAILY_FORECAST = 16386
+};
+
+enum FlowArrayOfStructures {
+    FLOW_ARRAY_OF_STRUCTURE_CURRENT_WEATHER = 81920,
+    FLOW_ARRAY_OF_STRUCTURE_HOURLY_FORECAST = 81921,
+    FLOW_ARRAY_OF_STRUCTURE_DAILY_FORECAST = 81922
+};
+
+enum CurrentWeatherFlowStructureFields {
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TIME = 0,
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMPERATURE = 1,
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MIN = 2,
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MAX = 3,
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_DESCRIPTION = 4,
+    FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_ICON = 5,
+    FLOW_STRUCTURE_CURRENT_WEATHER_NUM_FIELDS
+};
+
+struct CurrentWeatherValue {
+    Value value;
+    
+    CurrentWeatherValue() {
+        value = Value::makeArrayRef(FLOW_STRUCTURE_CURRENT_WEATHER_NUM_FIELDS, FLOW_STRUCTURE_CURRENT_WEATHER, 0);
+    }
+    
+    CurrentWeatherValue(Value value) : value(value) {}
+    
+    operator Value() const { return value; }
+    
+    operator bool() const { return value.isArray(); }
+    
+    int time() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TIME].getInt();
+    }
+    void time(int time) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TIME] = IntegerValue(time);
+    }
+    
+    float temperature() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMPERATURE].getFloat();
+    }
+    void temperature(float temperature) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMPERATURE] = FloatValue(temperature);
+    }
+    
+    float temp_min() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MIN].getFloat();
+    }
+    void temp_min(float temp_min) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MIN] = FloatValue(temp_min);
+    }
+    
+    float temp_max() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MAX].getFloat();
+    }
+    void temp_max(float temp_max) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_TEMP_MAX] = FloatValue(temp_max);
+    }
+    
+    const char *description() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_DESCRIPTION].getString();
+    }
+    void description(const char *description) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_DESCRIPTION] = StringValue(description);
+    }
+    
+    const char *icon() {
+        return value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_ICON].getString();
+    }
+    void icon(const char *icon) {
+        value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_ICON] = StringValue(icon);
+    }
+};
+
+typedef ArrayOf<CurrentWeatherValue, FLOW_ARRAY_OF_STRUCTURE_CURRENT_WEATHER> ArrayOfCurrentWeatherValue;
+
+enum HourlyForecastFlowStructureFields {
+    FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TIME = 0,
+    FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TEMPERATURE = 1,
+    FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_ICON = 2,
+    FLOW_STRUCTURE_HOURLY_FORECAST_NUM_FIELDS
+};
+
+struct HourlyForecastValue {
+    Value value;
+    
+    HourlyForecastValue() {
+        value = Value::makeArrayRef(FLOW_STRUCTURE_HOURLY_FORECAST_NUM_FIELDS, FLOW_STRUCTURE_HOURLY_FORECAST, 0);
+    }
+    
+    HourlyForecastValue(Value value) : value(value) {}
+    
+    operator Value() const { return value; }
+    
+    operator bool() const { return value.isArray(); }
+    
+    int time() {
+        return value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TIME].getInt();
+    }
+    void time(int time) {
+        value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TIME] = IntegerValue(time);
+    }
+    
+    float temperature() {
+        return value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TEMPERATURE].getFloat();
+    }
+    void temperature(float temperature) {
+        value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_TEMPERATURE] = FloatValue(temperature);
+    }
+    
+    const char *icon() {
+        return value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_ICON].getString();
+    }
+    void icon(const char *icon) {
+        value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_ICON] = StringValue(icon);
+    }
+};
+
+typedef ArrayOf<HourlyForecastValue, FLOW_ARRAY_OF_STRUCTURE_HOURLY_FORECAST> ArrayOfHourlyForecastValue;
+
+enum DailyForecastFlowStructureFields {
+    FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TIME = 0,
+    FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MIN = 1,
+    FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MAX = 2,
+    FLOW_STRUCTURE_DAILY_FORECAST_FIELD_ICON = 3,
+    FLOW_STRUCTURE_DAILY_FORECAST_NUM_FIELDS
+};
+
+struct DailyForecastValue {
+    Value value;
+    
+    DailyForecastValue() {
+        value = Value::makeArrayRef(FLOW_STRUCTURE_DAILY_FORECAST_NUM_FIELDS, FLOW_STRUCTURE_DAILY_FORECAST, 0);
+    }
+    
+    DailyForecastValue(Value value) : value(value) {}
+    
+    operator Value() const { return value; }
+    
+    operator bool() const { return value.isArray(); }
+    
+    int time() {
+        return value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TIME].getInt();
+    }
+    void time(int time) {
+        value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TIME] = IntegerValue(time);
+    }
+    
+    float temp_min() {
+        return value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MIN].getFloat();
+    }
+    void temp_min(float temp_min) {
+        value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MIN] = FloatValue(temp_min);
+    }
+    
+    float temp_max() {
+        return value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MAX].getFloat();
+    }
+    void temp_max(float temp_max) {
+        value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_TEMP_MAX] = FloatValue(temp_max);
+    }
+    
+    const char *icon() {
+        return value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_ICON].getString();
+    }
+    void icon(const char *icon) {
+        value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_ICON] = StringValue(icon);
+    }
+};
+
+typedef ArrayOf<DailyForecastValue, FLOW_ARRAY_OF_STRUCTURE_DAILY_FORECAST> ArrayOfDailyForecastValue;
+
+#endif /* WEATHER_STRUCTS_H */
@@ -0,0 +1,135 @@
+#include <string.h>
+#include "weather_structs.h"
+#include "weather_vars.h"
+
+// The data read by the flow, updated by weather_vars_set()
+static weather_data_t s_snapshot;
+
+uint32_t var_current_weather_version;
+uint32_t var_hourly_forecast_version;
+uint32_t var_daily_forecast_version;
+
+// The flow values built from the snapshot and the version they were built for
+static Value s_current_weather;
+static Value s_hourly_forecast;
+static Value s_daily_forecast;
+static uint32_t s_current_weather_version;
+static uint32_t s_hourly_forecast_version;
+static uint32_t s_daily_forecast_version;
+
+// Every field of current_weather is compared
+static bool current_weather_changed(const weather_data_t *data)
+{
+    return data->last_forecast_update != s_snapshot.last_forecast_update ||
+           memcmp(&data->temperature, &s_snapshot.temperature, sizeof(data->temperature)) != 0 ||
+           memcmp(&data->temp_min, &s_snapshot.temp_min, sizeof(data->temp_min)) != 0 ||
+           memcmp(&data->temp_max, &s_snapshot.temp_max, sizeof(data->temp_max)) != 0 ||
+           strcmp(data->description, s_snapshot.description) != 0 ||
+           strcmp(data->icon, s_snapshot.icon) != 0;
+}
+
+// The OpenWeather icon codes, an icon is a constant string instead of a copy
+static const char *const s_icons[] = {
+    "01d", "01n", "02d", "02n", "03d", "03n", "04d", "04n", "09d",
+    "09n", "10d", "10n", "11d", "11n", "13d", "13n", "50d", "50n",
+};
+
+static Value icon_value(const char *icon)
+{
+    for (size_t i = 0; i < sizeof(s_icons) / sizeof(s_icons[0]); i++) {
+        if (strcmp(icon, s_icons[i]) == 0) {
+            return Value(s_icons[i], VALUE_TYPE_STRING);
+        }
+    }
+    return StringValue(icon);
+}
+
+void weather_vars_set(const weather_data_t *data)
+{
+    // Compared byte by byte, so a NAN temperature doesn't look like new data
+    if (current_weather_changed(data)) {
+        var_current_weather_version++;
+    }
+    if (data->hourly_count != s_snapshot.hourly_count ||
+        memcmp(data->hourly, s_snapshot.hourly, data->hourly_count * sizeof(hourly_forecast_t)) != 0) {
+        var_hourly_forecast_version++;
+    }
+    if (data->daily_count != s_snapshot.daily_count ||
+        memcmp(data->daily, s_snapshot.daily, data->daily_count * sizeof(daily_forecast_t)) != 0) {
+        var_daily_forecast_version++;
+    }
+    s_snapshot = *data;
+}
+
+static void get_var_current_weather(void *value)
+{
+    if (!s_current_weather.isArray() || s_current_weather_version != var_current_weather_version) {
+        CurrentWeatherValue current;
+        if (current) {
+            current.time((int)s_snapshot.last_forecast_update);
+            current.temperature(s_snapshot.temperature);
+            current.temp_min(s_snapshot.temp_min);
+            current.temp_max(s_snapshot.temp_max);
+            // The description is copied, the flow may hold the value after the snapshot is overwritten
+            current.description(s_snapshot.description);
+            current.value.getArray()->values[FLOW_STRUCTURE_CURRENT_WEATHER_FIELD_ICON] = icon_value(s_snapshot.icon);
+        }
+        s_current_weather = current;
+        s_current_weather_version = var_current_weather_version;
+    }
+    *(Value *)value = s_current_weather;
+}
+
+static void get_var_hourly_forecast(void *value)
+{
+    if (!s_hourly_forecast.isArray() || s_hourly_forecast_version != var_hourly_forecast_version) {
+        ArrayOfHourlyForecastValue hourly(s_snapshot.hourly_count);
+        for (int i = 0; hourly && i < s_snapshot.hourly_count; i++) {
+            HourlyForecastValue forecast;
+            if (!forecast) {
+                break;
+            }
+            forecast.time((int)s_snapshot.hourly[i].timestamp);
+            forecast.temperature(s_snapshot.hourly[i].temperature);
+            forecast.value.getArray()->values[FLOW_STRUCTURE_HOURLY_FORECAST_FIELD_ICON] = icon_value(s_snapshot.hourly[i].icon);
+            hourly.at(i, forecast);
+        }
+        s_hourly_forecast = hourly;
+        s_hourly_forecast_version = var_hourly_forecast_version;
+    }
+    *(Value *)value = s_hourly_forecast;
+}
+
+static void get_var_daily_forecast(void *value)
+{
+    if (!s_daily_forecast.isArray() || s_daily_forecast_version != var_daily_forecast_version) {
+        ArrayOfDailyForecastValue daily(s_snapshot.daily_count);
+        for (int i = 0; daily && i < s_snapshot.daily_count; i++) {
+            DailyForecastValue forecast;
+            if (!forecast) {
+                break;
+            }
+            forecast.time((int)s_snapshot.daily[i].timestamp);
+            forecast.temp_min(s_snapshot.daily[i].temp_min);
+            forecast.temp_max(s_snapshot.daily[i].temp_max);
+            forecast.value.getArray()->values[FLOW_STRUCTURE_DAILY_FORECAST_FIELD_ICON] = icon_value(s_snapshot.daily[i].icon);
+            daily.at(i, forecast);
+        }
+        s_daily_forecast = daily;
+        s_daily_forecast_version = var_daily_forecast_version;
+    }
+    *(Value *)value = s_daily_forecast;
+}
+
+// The native variables of the generated UI followed by the weather ones
+static native_var_t s_native_vars[] = {
+    { NATIVE_VAR_TYPE_NONE, 0, 0, 0 },
+    { NATIVE_VAR_TYPE_VALUE, (void *)get_var_current_weather, 0, &var_current_weather_version },
+    { NATIVE_VAR_TYPE_VALUE, (void *)get_var_hourly_forecast, 0, &var_hourly_forecast_version },
+    { NATIVE_VAR_TYPE_VALUE, (void *)get_var_daily_forecast, 0, &var_daily_forecast_version },
+};
+
+void weather_vars_init(void)
+{
+    eez_flow_init_native_vars(s_native_vars);
+}
@@ -0,0 +1,46 @@
+#ifndef WEATHER_VARS_H
+#define WEATHER_VARS_H
+
+#include "weather_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ids of the weather native variables, the order the EEZ Studio project must declare them in
+enum WeatherNativeVariables {
+    NATIVE_VARIABLE_CURRENT_WEATHER = 1,
+    NATIVE_VARIABLE_HOURLY_FORECAST = 2,
+    NATIVE_VARIABLE_DAILY_FORECAST = 3
+};
+
+// Incremented when the value changes, the flow re-evaluates what reads it only then
+extern uint32_t var_current_weather_version;
+extern uint32_t var_hourly_forecast_version;
+extern uint32_t var_daily_forecast_version;
+
+/**
+ * @brief Register the weather native variables with the flow
+ *
+ * @note Call it before `ui_init()`
+ */
+void weather_vars_init(void);
+
+/**
+ * @brief Publish weather data to the native flow variables
+ *
+ * The data is copied to the snapshot read by `current_weather`, `hourly_forecast` and
+ * `daily_forecast`. The version of a variable is incremented only if its part of the data changed.
+ * The flow values are built from the snapshot when they are read the first time after a change.
+ *
+ * @note Call it with the LVGL lock held, the flow reads the snapshot in `ui_tick()`
+ *
+ * @param data The weather data from `weather_client_get_data()`
+ */
+void weather_vars_set(const weather_data_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEATHER_VARS_H */